@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Service.h"
+#include "TypeRegistry.h"
+
+namespace IExeEngine
+{
+    class AnimatorComponent;
+
+    // Gathers every registered animator and samples/propagates their poses as JobSystem batches,
+    // the bone palettes are published on the components once Update returns
+    class AnimationService : public Service
+    {
+    public:
+        SET_TYPE_ID(ServiceId::Animation);
+
+        void Terminate() override;
+        void Update(float deltaTime) override;
+        void DebugUI() override;
+        void Deserialize(const rapidjson::Value& value) override;
+
+        void Register(AnimatorComponent* animatorComponent);
+        void Unregister(AnimatorComponent* animatorComponent);
+
+        // Deterministic mode updates every animator on the calling thread in registration order
+        void SetDeterministic(bool deterministic);
+
+    private:
+        using Animators = std::vector<AnimatorComponent*>;
+        Animators mAnimators;
+
+        bool mDeterministic = false;
+        float mUpdateTimeMs = 0.0f;
+    };
+
+    REGISTER_SERVICE(AnimationService);
+}
\ No newline at end of file
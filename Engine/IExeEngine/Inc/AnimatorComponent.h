@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -10,17 +11,30 @@ namespace IExeEngine
 		SET_TYPE_ID(ComponentId::Animator);
 
 		void Initialize() override;
+		void Terminate() override;
 
 		void Update(float deltaTime) override;
 
 		void DebugUI() override;
 
 		bool Play(int index, bool looping = false);
+		// Blends from the current pose into the clip over fadeDuration seconds
+		bool CrossFade(int index, bool looping, float fadeDuration);
 
 		Graphics::Animator& GetAnimator();
 		const Graphics::Animator& GetAnimator() const;
 
+		// Advances the animator and rebuilds the skinning palette, called by the AnimationService when there is one
+		void UpdatePose(float deltaTime);
+		const Graphics::AnimationUtil::BoneTransforms& GetSkinningTransforms() const;
+
 	private:
 		Graphics::Animator mAnimator;
+		Graphics::ModelId mModelId = 0;
+		Graphics::AnimationUtil::BoneTransforms mModelTransforms;
+		Graphics::AnimationUtil::BoneTransforms mSkinningTransforms;
+		bool mIsRegistered = false;
 	};
+
+	REGISTER_COMPONENT(AnimatorComponent);
 }
\ No newline at end of file
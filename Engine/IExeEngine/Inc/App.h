@@ -10,11 +10,26 @@ namespace IExeEngine
 		uint32_t winWidth = 1920;
 		uint32_t winHeight = 1080;
 		uint32_t maxVertexCount = 100000;
+		// Log output also goes to this file when set
+		std::filesystem::path logFile;
+		// MemoryTracker report written here on quit, after everything is terminated so what's left is leaked
+		std::filesystem::path memoryReportFile;
+
+		// Simulation ticks per second. Update then always gets 1 / simulationRate and rendering interpolates
+		// between the last two ticks, 0 keeps one variable length update per rendered frame
+		float simulationRate = 0.0f;
+		// Catch up ticks allowed in one frame, time beyond that is dropped so a hitch can't snowball
+		uint32_t maxSimulationSteps = 5;
+		// Rendered frames per second cap, 0 for none. Sleeps out the rest of the frame instead of spinning when vsync is off
+		float maxFrameRate = 0.0f;
 	};
 
 	class App final
 	{
 	public:
+		using TickCallback = std::function<void()>;
+		using TickListenerId = std::size_t;
+
 		void Run(const AppConfig& config);
 
 		void Quit();
@@ -40,6 +55,18 @@ namespace IExeEngine
 
 		void ChangeState(const std::string& stateName);
 
+		// Called at the start of every simulation tick, before the state updates, so render code can keep the state
+		// it interpolates from. Not to be added or removed from inside a listener
+		TickListenerId AddTickListener(TickCallback callback);
+		void RemoveTickListener(TickListenerId listenerId);
+
+		// Simulation ticks run so far
+		uint64_t GetSimulationTick() const;
+		// How far the frame is between the previous and the latest tick in [0, 1), always 1 without a simulation rate
+		float GetInterpolationAlpha() const;
+		// Real seconds between the starts of the last two frames
+		float GetFrameTime() const;
+
 	private:
 		using AppStateMap = std::map<std::string, std::unique_ptr<AppState>>;
 
@@ -48,5 +75,12 @@ namespace IExeEngine
 		AppState* mNextState = nullptr;
 
 		bool mRunning = false;
+
+		std::vector<std::pair<TickListenerId, TickCallback>> mTickListeners;
+		TickListenerId mNextTickListenerId = 0;
+
+		uint64_t mSimulationTick = 0;
+		float mInterpolationAlpha = 1.0f;
+		float mFrameTime = 0.0f;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -20,4 +21,6 @@ namespace IExeEngine
 	private:
 		Graphics::Camera mCamera;
 	};
+
+	REGISTER_COMPONENT(CameraComponent);
 }
\ No newline at end of file
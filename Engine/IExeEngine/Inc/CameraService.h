@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Service.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -24,4 +25,6 @@ namespace IExeEngine
         CameraEntries mCameraEntries;
         const CameraComponent* mMainCamera = nullptr;
     };
+
+    REGISTER_SERVICE(CameraService);
 }
\ No newline at end of file
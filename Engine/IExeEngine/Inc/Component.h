@@ -37,6 +37,8 @@ namespace IExeEngine
 
     private:
         friend class GameObject;
+        friend class ComponentStorage;
         GameObject* mOwner = nullptr;
+        uint32_t mStorageIndex = 0; // Slot in the ComponentStorage pool list when pooled
     };
 }
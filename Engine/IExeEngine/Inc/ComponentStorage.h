@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Component.h"
+
+namespace IExeEngine
+{
+    enum class ComponentLayout
+    {
+        PerObject,  // Each component is its own heap allocation, updated object by object
+        Pooled      // Components of one type share a paged pool, updated one type at a time across all objects
+    };
+
+    // Owns the memory of every component in a GameWorld. In the pooled layout each component type gets a paged
+    // TypedAllocator, so all components of that type sit together in memory, and is updated as a system: one
+    // loop over a dense list calling the type's own Update directly, skipped for types that don't override it.
+    // Pages never move, so component pointers held by game objects and other components stay valid
+    class ComponentStorage final
+    {
+    public:
+        static constexpr std::size_t ComponentsPerPage = 256;
+
+        void Initialize(ComponentLayout layout);
+        void Terminate();
+
+        ComponentLayout GetLayout() const;
+
+        template<class ComponentType>
+        ComponentType* New()
+        {
+            if (mLayout == ComponentLayout::PerObject)
+            {
+                return new ComponentType();
+            }
+
+            const uint32_t typeId = ComponentType::StaticGetTypeId();
+            if (typeId >= mPools.size())
+            {
+                mPools.resize(typeId + 1);
+            }
+            std::unique_ptr<Pool>& pool = mPools[typeId];
+            if (pool == nullptr)
+            {
+                pool = std::make_unique<TypedPool<ComponentType>>();
+            }
+            else if (pool->mType != typeid(ComponentType))
+            {
+                // Two custom types given the same id would otherwise share one pool and be cast to each other
+                LOG_ERROR(Engine, "ComponentStorage: %s has the type id %u of %s!", typeid(ComponentType).name(), typeId, pool->mType.name());
+                return nullptr;
+            }
+
+            ComponentType* component = static_cast<TypedPool<ComponentType>*>(pool.get())->mAllocator.New();
+            ASSERT(component != nullptr, "ComponentStorage: Failed to allocate a component of type %u!", typeId);
+            component->mStorageIndex = static_cast<uint32_t>(pool->mComponents.size());
+            pool->mComponents.push_back(component);
+            return component;
+        }
+
+        void Delete(Component* component);
+
+        // Pooled layout only, components added while these run are updated in the same pass
+        void Update(float deltaTime);
+        void LateUpdate(float deltaTime);
+
+        // Number of live components of a type in the pooled layout
+        std::size_t GetCount(uint32_t typeId) const;
+
+    private:
+        // Pools are named and paged from the type's TypeRegistry entry when it has one
+        struct PoolSettings
+        {
+            const char* name = nullptr;
+            std::size_t blocksPerPage = ComponentsPerPage;
+        };
+        static PoolSettings GetPoolSettings(uint32_t typeId, const std::type_info& type);
+
+        struct Pool
+        {
+            explicit Pool(const std::type_info& type)
+                : mType(type)
+            {
+            }
+            virtual ~Pool() = default;
+            virtual void Delete(Component* component) = 0;
+            virtual void Update(float deltaTime) = 0;
+            virtual void LateUpdate(float deltaTime) = 0;
+
+            // The component type the pool was made for
+            const std::type_info& mType;
+            // Live components in allocation order, removal swaps the last one into the gap
+            std::vector<Component*> mComponents;
+        };
+
+        template<class ComponentType>
+        struct TypedPool final : Pool
+        {
+            TypedPool()
+                : TypedPool(GetPoolSettings(ComponentType::StaticGetTypeId(), typeid(ComponentType)))
+            {
+            }
+
+            explicit TypedPool(const PoolSettings& settings)
+                : Pool(typeid(ComponentType))
+                , mAllocator(settings.name, Core::BlockAllocator::Unbounded, settings.blocksPerPage)
+            {
+            }
+
+            // &ComponentType::Update has the type of the class that declares it
+            static constexpr bool HasUpdate = !std::is_same_v<decltype(&ComponentType::Update), void (Component::*)(float)>;
+            static constexpr bool HasLateUpdate = !std::is_same_v<decltype(&ComponentType::LateUpdate), void (Component::*)(float)>;
+
+            void Delete(Component* component) override
+            {
+                mAllocator.Delete(static_cast<ComponentType*>(component));
+            }
+
+            // Indexed, an update can create game objects and grow the list
+            void Update(float deltaTime) override
+            {
+                if constexpr (HasUpdate)
+                {
+                    for (std::size_t i = 0; i < mComponents.size(); ++i)
+                    {
+                        static_cast<ComponentType*>(mComponents[i])->ComponentType::Update(deltaTime);
+                    }
+                }
+            }
+
+            void LateUpdate(float deltaTime) override
+            {
+                if constexpr (HasLateUpdate)
+                {
+                    for (std::size_t i = 0; i < mComponents.size(); ++i)
+                    {
+                        static_cast<ComponentType*>(mComponents[i])->ComponentType::LateUpdate(deltaTime);
+                    }
+                }
+            }
+
+            Core::TypedAllocator<ComponentType> mAllocator;
+        };
+
+        ComponentLayout mLayout = ComponentLayout::PerObject;
+        // Indexed by component type id, custom types past ComponentId::Count grow it on demand
+        std::vector<std::unique_ptr<Pool>> mPools;
+    };
+}
\ No newline at end of file
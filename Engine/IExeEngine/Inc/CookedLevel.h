@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ComponentStorage.h"
+
+namespace IExeEngine
+{
+    // A level with every template it uses resolved into it, written offline by the LevelCooker tool and loaded by
+    // GameWorld::LoadLevel for files with the cooked extension. Service and component values are stored as binary
+    // trees of the json they came from, with every name and string in one string table, so loading is one mapped
+    // read with no json text to parse
+    namespace CookedLevel
+    {
+        constexpr uint32_t Magic = 0x4C584549; // "IEXL"
+        constexpr uint16_t Version = 1;
+        constexpr const char* Extension = ".level";
+
+        // Reads levelFile and every template it refers to, relative to the working directory like the game does.
+        // Returns false if any of them is missing or malformed, nothing is written then
+        bool Cook(const std::filesystem::path& levelFile, const std::filesystem::path& cookedFile);
+
+        // Cursor over a mapped cooked level. Every read is bounds checked and returns false once the file runs out
+        class Reader
+        {
+        public:
+            static constexpr uint32_t MaxValueDepth = 64;
+            static constexpr uint32_t MaxObjectDepth = 64;
+
+            Reader();
+
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            // Maps the file, checks its header and indexes the string table
+            bool Open(const std::filesystem::path& cookedFile);
+
+            // Empty when the level leaves the layout to the game
+            std::optional<ComponentLayout> GetComponentLayout() const;
+            uint32_t GetCapacity() const;
+
+            bool ReadCount(uint32_t& count);
+            bool ReadString(const char*& str);
+            // A type name with its TypeRegistry hash
+            bool ReadName(const char*& name, uint32_t& nameHash);
+
+            // Rebuilds the next value so services and components deserialize it like json. Strings point into the
+            // mapped file and the value is only valid until the next call, null if the file is truncated or the value
+            // nests deeper than MaxValueDepth
+            const rapidjson::Value* ReadValue();
+
+        private:
+            template<class T>
+            bool Read(T& value);
+            bool DecodeValue(rapidjson::Value& value, uint32_t depth);
+            bool DecodeString(rapidjson::Value& value);
+
+            Core::MappedFile mMappedFile;
+            const uint8_t* mCurrent = nullptr;
+            const uint8_t* mEnd = nullptr;
+            std::vector<std::string_view> mStrings;
+            std::optional<ComponentLayout> mComponentLayout;
+            uint32_t mCapacity = 0;
+
+            // A value rarely needs more than the buffer, so rebuilding one doesn't touch the heap
+            static constexpr std::size_t ValueBufferSize = 16 * 1024;
+            alignas(8) uint8_t mValueBuffer[ValueBufferSize];
+            rapidjson::MemoryPoolAllocator<> mValueAllocator;
+            rapidjson::Value mValue;
+        };
+    }
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -23,4 +24,6 @@ namespace IExeEngine
 		float mMoveSpeed = 1.0f;
 		float mTurnSpeed = 0.1f;
 	};
+
+	REGISTER_COMPONENT(FPSCameraComponent);
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "GameObjectHandle.h"
-#include "Component.h"
+#include "ComponentStorage.h"
 
 namespace IExeEngine
 {
@@ -10,6 +10,9 @@ namespace IExeEngine
     class GameObject final
     {
     public:
+        // Component type ids have to be below this, custom ones included, for the lookup table
+        static constexpr uint32_t MaxComponentTypes = 64;
+
         GameObject() = default;
 
         void Initialize();
@@ -44,30 +47,37 @@ namespace IExeEngine
         {
             static_assert(std::is_base_of_v<Component, ComponentType>,
                 "GameObject: ComponentType must be of type Component!");
+            // SET_TYPE_ID ids are constant, so a bad one can't build rather than writing past the lookup table
+            static_assert(ComponentType::StaticGetTypeId() != static_cast<uint32_t>(ComponentId::Invalid),
+                "GameObject: Component has an invalid ID!");
+            static_assert(ComponentType::StaticGetTypeId() < MaxComponentTypes, "GameObject: Component ID is past MaxComponentTypes!");
             ASSERT(!mInitialized, "GameObject: Can't add components when Initialized!"); // We cannot dynamically add components 
             ASSERT(!HasA<ComponentType>(), "GameObject: Already has a component type added!");
-            ASSERT(ComponentType::StaticGetTypeId() != static_cast<uint32_t>(ComponentId::Invalid),
-                "GameObject: Component has an invalid ID!");
+            ASSERT(mComponentStorage != nullptr, "GameObject: Components can only be added to objects created by a GameWorld!");
 
-            auto& newComponent = mComponents.emplace_back(std::make_unique<ComponentType>());
+            MEMORY_TAG(Components);
+            ComponentType* newComponent = mComponentStorage->New<ComponentType>();
+            if (newComponent == nullptr)
+            {
+                return nullptr;
+            }
             newComponent->mOwner = this;
-            return static_cast<ComponentType*>(newComponent.get());
+
+            const uint32_t typeId = ComponentType::StaticGetTypeId();
+            mComponentMask |= (uint64_t(1) << typeId);
+            mComponentIndices[typeId] = static_cast<uint8_t>(mComponents.size());
+            mComponents.push_back(newComponent);
+            return newComponent;
         }
 
         template<class ComponentType>
-        bool HasA()
+        bool HasA() const
         {
             static_assert(std::is_base_of_v<Component, ComponentType>,
                 "GameObject: ComponentType must be of type Component!");
-            
-            for (auto& component : mComponents)
-            {
-                if (component->GetTypeId() == ComponentType::StaticGetTypeId())
-                {
-                    return true;
-                }
-            }
-            return false;
+
+            const uint32_t typeId = ComponentType::StaticGetTypeId();
+            return typeId < MaxComponentTypes && (mComponentMask & (uint64_t(1) << typeId)) != 0;
         }
 
         template<class ComponentType>
@@ -76,14 +86,11 @@ namespace IExeEngine
             static_assert(std::is_base_of_v<Component, ComponentType>,
                 "GameObject: ComponentType must be of type Component!");
 
-            for (auto& component : mComponents)
+            if (!HasA<ComponentType>())
             {
-                if (component->GetTypeId() == ComponentType::StaticGetTypeId())
-                {
-                    return static_cast<ComponentType*>(component.get());
-                }
+                return nullptr;
             }
-            return nullptr;
+            return static_cast<const ComponentType*>(mComponents[mComponentIndices[ComponentType::StaticGetTypeId()]]);
         }
 
         template<class ComponentType>
@@ -96,6 +103,9 @@ namespace IExeEngine
     private:
         friend class GameWorld;
 
+        // Back to how a new object starts out so GameWorld can hand it out again, the vectors keep their memory
+        void Reset();
+
         std::string mName = "EMPTY";
         bool mInitialized = false;
         uint32_t mId = 0;
@@ -103,9 +113,14 @@ namespace IExeEngine
         GameObjectHandle mHandle;
 
         GameWorld* mWorld = nullptr;
+        ComponentStorage* mComponentStorage = nullptr;
 
-        using Components = std::vector<std::unique_ptr<Component>>;
+        // Owned by mComponentStorage
+        using Components = std::vector<Component*>;
         Components mComponents;
+        // Bit per component type id the object has, and where that component is in mComponents
+        uint64_t mComponentMask = 0;
+        std::array<uint8_t, MaxComponentTypes> mComponentIndices = {};
 
         using Children = std::vector<GameObject*>;
         Children mChildren;
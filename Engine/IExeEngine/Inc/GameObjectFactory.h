@@ -6,16 +6,36 @@ namespace IExeEngine
     class GameWorld;
     class Component;
 
+    namespace CookedLevel
+    {
+        class Reader;
+    }
+
     using CustomComponent = std::function<Component* (const std::string&, GameObject&)>;
 
     namespace GameObjectFactory
     {
+        // Only asked about components that aren't registered with REGISTER_COMPONENT
         void SetCustomMake(CustomComponent callback);
 
         void SetCustomGet(CustomComponent callback);
 
+        // Each template is parsed once and cached, later calls reuse it without checking the file again. A template
+        // that can't be read is logged and leaves the object empty
         void Make(const std::filesystem::path& templatePath, GameObject& gameObject, GameWorld& gameWorld);
 
         void OverrideDeserialize(const rapidjson::Value& value, GameObject& gameObject);
+
+        // Makes the next object of a cooked level with its components, children and overrides, in the order Make and
+        // OverrideDeserialize apply them. Null if the level is truncated or its children nest deeper than
+        // CookedLevel::Reader::MaxObjectDepth
+        GameObject* MakeCooked(CookedLevel::Reader& reader, GameWorld& gameWorld);
+
+        // Drops the cached templates whose file has been saved since it was parsed, GameWorld::LoadLevel calls it so
+        // edited templates show up in the next level loaded
+        void ReloadChangedPrefabs();
+
+        // Drops every cached template, the next Make of each reads its file again
+        void ClearPrefabCache();
     }
 }
\ No newline at end of file
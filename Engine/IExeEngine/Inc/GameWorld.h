@@ -11,8 +11,15 @@ namespace IExeEngine
     class GameWorld final
     {
     public:
+        // Only asked about services that aren't registered with REGISTER_SERVICE
         static void SetCustomService(CustomService customService);
 
+        // Has to be set before Initialize, PerObject by default. Pooled changes the update order from object by
+        // object to one component type at a time, in ComponentId order
+        void SetComponentLayout(ComponentLayout layout);
+        ComponentLayout GetComponentLayout() const;
+
+        // Capacity is the starting number of object slots, more are added a page at a time as they run out
         void Initialize(uint32_t capacity = 10);
         void Terminate();
         void Update(float deltaTime);
@@ -22,6 +29,7 @@ namespace IExeEngine
         GameObject* CreateGameObject(std::string name, const std::filesystem::path& templatePath = "");
         void DestroyGameObject(const GameObjectHandle& handle);
 
+        // Json levels, or cooked ones when the file has CookedLevel::Extension
         void LoadLevel(const std::filesystem::path& levelFile);
 
         template<class ServiceType>
@@ -57,21 +65,46 @@ namespace IExeEngine
 
 
     private:
+        static constexpr uint32_t SlotsPerPage = 256;
+        static constexpr std::size_t GameObjectsPerPage = 256;
+
         bool IsValid(const GameObjectHandle& handle);
+        void AddSlots(uint32_t count);
+        void LoadCookedLevel(const std::filesystem::path& levelFile);
         void ProcessDestoyList(); // As we never want to destoy game objects during an update loop...
+        void UpdateTransforms();
 
         struct Slot
         {
-            std::unique_ptr<GameObject> gameObject;
+            GameObject* gameObject = nullptr;
             uint32_t generation = 0;
         };
 
+        // Only holds pointers, so growing it never moves a game object. Loops over it are indexed because
+        // creating an object during an update can grow it
         using GameObjectSlots = std::vector<Slot>;
         GameObjectSlots mGameObjectSlots;
         std::vector<uint32_t> mFreeSlots;
+
+        // Game objects live in pages that never move, destroyed ones are reset and handed out again before a new
+        // one is allocated, so the vectors they own keep their memory
+        Core::TypedAllocator<GameObject> mGameObjectAllocator{ "GameObject", Core::BlockAllocator::Unbounded, GameObjectsPerPage };
+        std::vector<GameObject*> mFreeGameObjects;
         std::vector<uint32_t> mToBeDestroyed;
         bool mInitialized = false;
 
+        ComponentLayout mComponentLayout = ComponentLayout::PerObject;
+        ComponentStorage mComponentStorage;
+
+        // Objects still to visit in the transform pass, kept to reuse its memory
+        struct TransformVisit
+        {
+            GameObject* gameObject = nullptr;
+            const Graphics::Transform* parentWorld = nullptr;
+            bool parentChanged = false;
+        };
+        std::vector<TransformVisit> mTransformVisits;
+
         using Services = std::vector<std::unique_ptr<Service>>;
         Services mServices;
     };
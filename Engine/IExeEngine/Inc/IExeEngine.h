@@ -11,6 +11,9 @@
 #include "GameWorld.h"
 #include "GameObjectHandle.h"
 #include "GameObjectFactory.h"
+#include "ComponentStorage.h"
+#include "TypeRegistry.h"
+#include "CookedLevel.h"
 
 // Component Info
 #include "TypeIds.h"
@@ -39,6 +42,7 @@
 #include "RenderService.h"
 #include "PhysicsService.h"
 #include "UIRenderService.h"
+#include "AnimationService.h"
 
 namespace IExeEngine
 {
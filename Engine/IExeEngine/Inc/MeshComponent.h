@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderObjectComponent.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -15,4 +16,6 @@ namespace IExeEngine
     private:
         Graphics::Model mMeshModel;
     };
+
+    REGISTER_COMPONENT(MeshComponent);
 }
\ No newline at end of file
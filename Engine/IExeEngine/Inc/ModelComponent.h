@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderObjectComponent.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -26,4 +27,6 @@ namespace IExeEngine
         using Animations = std::vector<std::string>;
         Animations mAnimations;
     };
+
+    REGISTER_COMPONENT(ModelComponent);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Service.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -25,4 +26,6 @@ namespace IExeEngine
 	private:
 		bool mEnabled = true;
 	};
+
+	REGISTER_SERVICE(PhysicsService);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -31,4 +32,6 @@ namespace IExeEngine
         float mTurnSpeed = 0.1f;
         float mJumpSpeed = 20.0f;
     };
+
+    REGISTER_COMPONENT(PlayerControllerComponent);
 }
\ No newline at end of file
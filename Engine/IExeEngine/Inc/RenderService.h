@@ -1,6 +1,8 @@
 #pragma once
 
+#include "App.h"
 #include "Service.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -15,7 +17,6 @@ namespace IExeEngine
 
         void Initialize() override;
         void Terminate() override;
-        void Update(float deltaTime) override;
         void Render() override;
         void DebugUI() override;
         void Deserialize(const rapidjson::Value& value) override;
@@ -29,15 +30,29 @@ namespace IExeEngine
         Graphics::StandardEffect mStandardEffect;
         Graphics::ShadowEffect mShadowEffect;
 
+        // Keeps the transforms and camera from before the tick, the frame draws between them and the live ones
+        void CaptureSimulationState();
+
         struct Entry
         {
             const RenderObjectComponent* renderComponent = nullptr;
             const TransformComponent* transformComponent = nullptr;
             Graphics::RenderGroup renderGroup;
+
+            // World transform from before the latest simulation tick, drawn blended towards the current one by the
+            // app's interpolation alpha
+            Graphics::Transform previousTransform;
         };
         using RenderEntries = std::vector<Entry>;
         RenderEntries mRenderEntries;
 
+        const Graphics::Camera* mCapturedCamera = nullptr;
+        Math::Vector3 mPreviousCameraPosition = Math::Vector3::Zero;
+        Math::Vector3 mPreviousCameraDirection = Math::Vector3::ZAxis;
+        App::TickListenerId mTickListenerId = 0;
+
         float mFPS = 0.0f;
     };
+
+    REGISTER_SERVICE(RenderService);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -29,5 +30,7 @@ namespace IExeEngine
 		Physics::RigidBody mRigidBody;
 		float mMass = -1.0f;
 	};
+
+	REGISTER_COMPONENT(RigidBodyComponent);
 }
 
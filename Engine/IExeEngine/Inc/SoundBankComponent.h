@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -31,4 +32,6 @@ namespace IExeEngine
 		using SoundEffects = std::unordered_map<std::string, SoundEffectData>;
 		SoundEffects mSoundEffects;
 	};
+
+	REGISTER_COMPONENT(SoundBankComponent);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -23,4 +24,6 @@ namespace IExeEngine
 		bool mLooping = false;
 		Audio::SoundId mSoundId;
 	};
+
+	REGISTER_COMPONENT(SoundEventComponent);
 }
\ No newline at end of file
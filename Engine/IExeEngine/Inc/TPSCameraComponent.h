@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -28,4 +29,6 @@ namespace IExeEngine
         Math::Vector3 mOffset = Math::Vector3::Zero;
         float mSmoothingValue = 0.0f;
     };
+
+    REGISTER_COMPONENT(TPSCameraComponent);
 }
\ No newline at end of file
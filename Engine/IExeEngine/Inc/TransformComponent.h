@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -9,10 +10,30 @@ namespace IExeEngine
     public:
         SET_TYPE_ID(ComponentId::Transform);
 
+        void Initialize() override;
         void DebugUI() override;
 
         void Deserialize(const rapidjson::Value& value) override;
 
-        Transform GetWorldTransform() const;
+        // As of the last GameWorld transform pass, which runs after LateUpdate, or Initialize before that
+        const Transform& GetWorldTransform() const;
+        const Math::Matrix4& GetWorldMatrix() const;
+
+        // Walks the parent chain now, for code that moved a transform this frame and can't wait for the pass
+        Transform ComputeWorldTransform() const;
+
+    private:
+        friend class GameWorld;
+
+        // Rebuilds the cache when the local transform or a parent changed since the last pass, returns if it did
+        bool UpdateWorldTransform(const Transform* parentWorld, bool parentChanged);
+
+        // Local transform the cache was built from, position/rotation/scale are set directly so a change is found
+        // by comparing against it rather than through a dirty flag
+        Transform mCachedLocal;
+        Transform mWorldTransform;
+        Math::Matrix4 mWorldMatrix = Math::Matrix4::Identity;
     };
+
+    REGISTER_COMPONENT(TransformComponent);
 }
@@ -32,10 +32,11 @@ namespace IExeEngine
         Render,             // Renders the renderobjects into the world
         Physics,            // Registers & monitors physics objects
         UIRender,           // Renders UI components
+        Animation,          // Updates the registered animators across worker threads
         Count               // Last value, can be used to chain custom services
     };
 }
 
 #define SET_TYPE_ID(id)\
-    static uint32_t StaticGetTypeId() { return static_cast<uint32_t>(id); }\
+    static constexpr uint32_t StaticGetTypeId() { return static_cast<uint32_t>(id); }\
     uint32_t GetTypeId() const override { return StaticGetTypeId(); }
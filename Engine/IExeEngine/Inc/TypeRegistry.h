@@ -0,0 +1,116 @@
+#pragma once
+
+#include "GameWorld.h"
+
+namespace IExeEngine
+{
+    // What a template or level needs to make a component from its name, and what a pool needs to store it
+    struct ComponentInfo
+    {
+        const char* name = nullptr;
+        uint32_t nameHash = 0;
+        uint32_t typeId = 0;
+        const std::type_info* type = nullptr;
+        std::size_t size = 0;
+        std::size_t alignment = 0;
+        std::size_t blocksPerPage = 0; // Components per page of its pool in the pooled layout
+        Component* (*make)(GameObject&) = nullptr;
+        Component* (*get)(GameObject&) = nullptr;
+    };
+
+    struct ServiceInfo
+    {
+        const char* name = nullptr;
+        uint32_t nameHash = 0;
+        uint32_t typeId = 0;
+        std::size_t size = 0;
+        std::size_t alignment = 0;
+        Service* (*add)(GameWorld&) = nullptr;
+    };
+
+    // Component and service types by the hash of the name templates and levels use for them. Types register
+    // themselves with REGISTER_COMPONENT and REGISTER_SERVICE after their class, custom ones included, so neither
+    // the engine nor a game needs a list of names to compare against
+    namespace TypeRegistry
+    {
+        // FNV-1a, usable at compile time
+        constexpr uint32_t HashName(std::string_view name)
+        {
+            uint32_t hash = 2166136261u;
+            for (const char c : name)
+            {
+                hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+            }
+            return hash;
+        }
+
+        // False if the name is already taken, or for a component whose type id is past GameObject::MaxComponentTypes
+        bool Register(const ComponentInfo& info);
+        bool Register(const ServiceInfo& info);
+
+        // Null for names nothing registered, hashed names are checked against the registered name
+        const ComponentInfo* FindComponent(std::string_view name);
+        const ComponentInfo* FindComponent(uint32_t nameHash);
+        const ComponentInfo* GetComponentInfo(uint32_t typeId);
+
+        const ServiceInfo* FindService(std::string_view name);
+        const ServiceInfo* FindService(uint32_t nameHash);
+
+        template<class ComponentType>
+        Component* MakeComponent(GameObject& gameObject)
+        {
+            return gameObject.AddComponent<ComponentType>();
+        }
+
+        template<class ComponentType>
+        Component* GetComponent(GameObject& gameObject)
+        {
+            return gameObject.GetComponent<ComponentType>();
+        }
+
+        template<class ServiceType>
+        Service* AddService(GameWorld& gameWorld)
+        {
+            return gameWorld.AddService<ServiceType>();
+        }
+
+        template<class ComponentType>
+        bool RegisterComponent(const char* name, std::size_t blocksPerPage = ComponentStorage::ComponentsPerPage)
+        {
+            static_assert(std::is_base_of_v<Component, ComponentType>, "TypeRegistry: ComponentType must be of type Component!");
+            ComponentInfo info;
+            info.name = name;
+            info.nameHash = HashName(name);
+            info.typeId = ComponentType::StaticGetTypeId();
+            info.type = &typeid(ComponentType);
+            info.size = sizeof(ComponentType);
+            info.alignment = alignof(ComponentType);
+            info.blocksPerPage = blocksPerPage;
+            info.make = &MakeComponent<ComponentType>;
+            info.get = &GetComponent<ComponentType>;
+            return Register(info);
+        }
+
+        template<class ServiceType>
+        bool RegisterService(const char* name)
+        {
+            static_assert(std::is_base_of_v<Service, ServiceType>, "TypeRegistry: ServiceType must be of type Service!");
+            ServiceInfo info;
+            info.name = name;
+            info.nameHash = HashName(name);
+            info.typeId = ServiceType::StaticGetTypeId();
+            info.size = sizeof(ServiceType);
+            info.alignment = alignof(ServiceType);
+            info.add = &AddService<ServiceType>;
+            return Register(info);
+        }
+    }
+}
+
+// Registered before main from every file that includes the header, the engine library's files included. Putting
+// these in a .cpp of the static library would let the linker drop them
+#define REGISTER_COMPONENT(ComponentType)\
+    inline const bool ComponentType##Registered = IExeEngine::TypeRegistry::RegisterComponent<ComponentType>(#ComponentType)
+
+#define REGISTER_SERVICE(ServiceType)\
+    inline const bool ServiceType##Registered = IExeEngine::TypeRegistry::RegisterService<ServiceType>(#ServiceType)
\ No newline at end of file
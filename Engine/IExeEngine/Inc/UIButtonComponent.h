@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UIComponent.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -44,4 +45,6 @@ namespace IExeEngine
         DirectX::XMFLOAT2 mPosition = { 0.0f, 0.0f };
         ButtonState mCurrentState = ButtonState::Default;
     };
+
+    REGISTER_COMPONENT(UIButtonComponent);
 }
\ No newline at end of file
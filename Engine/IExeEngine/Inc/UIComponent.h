@@ -8,5 +8,12 @@ namespace IExeEngine
     {
     public:
         virtual void Render() = 0;
+
+        // Sum of the positions of the UI sprites and buttons above this one, set by UIRenderService before Render
+        const Math::Vector2& GetParentOffset() const { return mParentOffset; }
+
+    private:
+        friend class UIRenderService;
+        Math::Vector2 mParentOffset = Math::Vector2::Zero;
     };
 }
\ No newline at end of file
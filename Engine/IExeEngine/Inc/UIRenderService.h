@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Service.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -18,7 +19,11 @@ namespace IExeEngine
 		void Unregister(UIComponent* uiComponent);
 
 	private:
+		void UpdateParentOffsets();
+
 		using UIComponents = std::vector<UIComponent*>;
 		UIComponents mUIComponents;
     };
+
+    REGISTER_SERVICE(UIRenderService);
 }
\ No newline at end of file
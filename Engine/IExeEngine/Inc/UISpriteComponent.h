@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UIComponent.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -25,4 +26,6 @@ namespace IExeEngine
 		RECT mRect = { 0, 0, 0, 0 };
 		Graphics::UISprite mUISprite;
     };
+
+    REGISTER_COMPONENT(UISpriteComponent);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UIComponent.h"
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -23,4 +24,6 @@ namespace IExeEngine
 		float mSize = 10.0f;
 		Graphics::Color mColor = Graphics::Colors::Black;
 	};
+
+	REGISTER_COMPONENT(UITextComponent);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Component.h"
 #include <string>
 #include <vector>
+#include "TypeRegistry.h"
 
 namespace IExeEngine
 {
@@ -67,8 +68,11 @@ namespace IExeEngine
         int mIdleAnimIndex = 0;
         int mWalkAnimIndex = 1;
         int mAttackAnimIndex = 2;
+        float mBlendTime = 0.2f; // Cross-fade between state clips (seconds), 0 snaps
 
         // Sound
         std::vector<std::string> mAttackSoundKeys; // Randomly chosen sound file on each attack 
     };
+
+    REGISTER_COMPONENT(ZombieControllerComponent);
 }
\ No newline at end of file
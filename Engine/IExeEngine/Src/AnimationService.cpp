@@ -0,0 +1,88 @@
+#include "Precompiled.h"
+#include "AnimationService.h"
+
+#include "AnimatorComponent.h"
+#include "SaveUtil.h"
+
+using namespace IExeEngine;
+
+namespace
+{
+    // Animators per job, enough work to cover the cost of scheduling it
+    constexpr uint32_t BatchSize = 8;
+}
+
+void AnimationService::Terminate()
+{
+    mAnimators.clear();
+}
+
+void AnimationService::Update(float deltaTime)
+{
+    PROFILE_SCOPE("AnimationService::Update");
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Small crowds aren't worth waking the workers for
+    if (mDeterministic || mAnimators.size() <= BatchSize)
+    {
+        for (AnimatorComponent* animatorComponent : mAnimators)
+        {
+            animatorComponent->UpdatePose(deltaTime);
+        }
+    }
+    else
+    {
+        // Each animator only touches its own pose, so batches can run in any order
+        Core::JobSystem::Get()->ParallelFor(static_cast<uint32_t>(mAnimators.size()), BatchSize,
+            [this, deltaTime](uint32_t begin, uint32_t end)
+            {
+                PROFILE_SCOPE("AnimationService::UpdateBatch");
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    mAnimators[i]->UpdatePose(deltaTime);
+                }
+            });
+    }
+
+    const auto endTime = std::chrono::high_resolution_clock::now();
+    mUpdateTimeMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+}
+
+void AnimationService::DebugUI()
+{
+    if (ImGui::CollapsingHeader("AnimationService"))
+    {
+        ImGui::Text("Animators: %zu", mAnimators.size());
+        ImGui::Text("Workers: %u", Core::JobSystem::Get()->GetWorkerCount());
+        ImGui::Text("Update: %.3f ms", mUpdateTimeMs);
+        ImGui::Checkbox("Deterministic", &mDeterministic);
+    }
+}
+
+void AnimationService::Deserialize(const rapidjson::Value& value)
+{
+    SaveUtil::ReadBool("Deterministic", mDeterministic, value);
+}
+
+void AnimationService::Register(AnimatorComponent* animatorComponent)
+{
+    auto iter = std::find(mAnimators.begin(), mAnimators.end(), animatorComponent);
+    if (iter == mAnimators.end())
+    {
+        mAnimators.push_back(animatorComponent);
+    }
+}
+
+void AnimationService::Unregister(AnimatorComponent* animatorComponent)
+{
+    auto iter = std::find(mAnimators.begin(), mAnimators.end(), animatorComponent);
+    if (iter != mAnimators.end())
+    {
+        mAnimators.erase(iter);
+    }
+}
+
+void AnimationService::SetDeterministic(bool deterministic)
+{
+    mDeterministic = deterministic;
+}
\ No newline at end of file
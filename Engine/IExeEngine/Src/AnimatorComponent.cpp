@@ -3,6 +3,8 @@
 #include "SaveUtil.h"
 #include "GameObject.h"
 #include "ModelComponent.h"
+#include "GameWorld.h"
+#include "AnimationService.h"
 
 using namespace IExeEngine;
 
@@ -10,11 +12,33 @@ void AnimatorComponent::Initialize()
 {
 	const ModelComponent* modelComponent = GetOwner().GetComponent<ModelComponent>();
 	ASSERT(modelComponent != nullptr, "AnimatorComponent: GameObject needs a ModelComponent!");
-	mAnimator.Initialize(modelComponent->GetModelId());
+	mModelId = modelComponent->GetModelId();
+	mAnimator.Initialize(mModelId);
+	UpdatePose(0.0f);
+
+	AnimationService* animationService = GetOwner().GetWorld().GetService<AnimationService>();
+	if (animationService != nullptr)
+	{
+		animationService->Register(this);
+		mIsRegistered = true;
+	}
+}
+void AnimatorComponent::Terminate()
+{
+	if (mIsRegistered)
+	{
+		AnimationService* animationService = GetOwner().GetWorld().GetService<AnimationService>();
+		animationService->Unregister(this);
+		mIsRegistered = false;
+	}
 }
 void AnimatorComponent::Update(float deltaTime)
 {
-	mAnimator.Update(deltaTime);
+	// The AnimationService updates registered animators in parallel
+	if (!mIsRegistered)
+	{
+		UpdatePose(deltaTime);
+	}
 }
 void AnimatorComponent::DebugUI()
 {
@@ -50,6 +74,16 @@ bool AnimatorComponent::Play(int index, bool looping)
 	return false;
 }
 
+bool AnimatorComponent::CrossFade(int index, bool looping, float fadeDuration)
+{
+	if (index < mAnimator.GetAnimationCount())
+	{
+		mAnimator.CrossFade(index, looping, fadeDuration);
+		return true;
+	}
+	return false;
+}
+
 Graphics::Animator& AnimatorComponent::GetAnimator()
 {
 	return mAnimator;
@@ -58,4 +92,15 @@ Graphics::Animator& AnimatorComponent::GetAnimator()
 const Graphics::Animator& AnimatorComponent::GetAnimator() const
 {
 	return mAnimator;
+}
+
+void AnimatorComponent::UpdatePose(float deltaTime)
+{
+	mAnimator.Update(deltaTime);
+	Graphics::AnimationUtil::ComputeSkinningTransforms(mModelId, mModelTransforms, mSkinningTransforms, &mAnimator);
+}
+
+const Graphics::AnimationUtil::BoneTransforms& AnimatorComponent::GetSkinningTransforms() const
+{
+	return mSkinningTransforms;
 }
\ No newline at end of file
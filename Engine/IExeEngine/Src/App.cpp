@@ -11,7 +11,12 @@ using namespace IExeEngine::Audio;
 
 void App::Run(const AppConfig& config)
 {
+	Logger::Settings loggerSettings;
+	loggerSettings.filePath = config.logFile;
+	Logger::StaticInitialize(loggerSettings);
+
 	LOG("App Started");
+	Profiler::StaticInitialize();
 
 	// Initialize Everything
 	Window myWindow;
@@ -33,6 +38,8 @@ void App::Run(const AppConfig& config)
     PhysicsWorld::StaticInitialize(physicsSettings);
 
 	EventManager::StaticInitialize();
+	JobSystem::StaticInitialize();
+	FrameAllocator::StaticInitialize();
 
     AudioSystem::StaticInitialize();
     SoundEffectManager::StaticInitialize(L"../../Assets/Audio");
@@ -47,14 +54,49 @@ void App::Run(const AppConfig& config)
 
 	// Process Updates
 	InputSystem* input = InputSystem::Get();
+	auto tick = [&](float deltaTime)
+	{
+		for (auto& [listenerId, callback] : mTickListeners)
+		{
+			callback();
+		}
+
+		// Input advances with the simulation so a press is seen by exactly one tick
+		input->Update();
+		mCurrentState->Update(deltaTime);
+
+#ifndef USE_PHYSICS_SERVICE // ifndef - if not defined
+        PhysicsWorld::Get()->Update(deltaTime);
+#endif		// IF we are NOT using the physics service -> Use the regular update
+
+		// Everything posted during the tick, from any thread, is sent out in one go
+		EventManager::Get()->DispatchQueued();
+		++mSimulationTick;
+	};
+
+	const bool fixedStep = config.simulationRate > 0.0f;
+	const float tickDeltaTime = fixedStep ? 1.0f / config.simulationRate : 0.0f;
+	const uint64_t tickDuration = fixedStep ? static_cast<uint64_t>(1'000'000'000.0 / config.simulationRate) : 0;
+	const uint64_t minFrameDuration = (config.maxFrameRate > 0.0f) ? static_cast<uint64_t>(1'000'000'000.0 / config.maxFrameRate) : 0;
+	// Longer frames are breakpoints or stalls, run them as one long frame instead of trying to catch up
+	constexpr uint64_t maxFrameDuration = 250'000'000;
+
+	uint64_t accumulator = 0;
+	uint64_t nextFrameDeadline = 0;
+	uint64_t lastFrameStart = TimeUtil::GetTimeNanoseconds();
+	mSimulationTick = 0;
+	mInterpolationAlpha = 1.0f;
 	mRunning = true;
 	while (mRunning)
 	{
-		myWindow.ProcessMessage();
+		// Anything allocated from frame memory two frames ago is gone from here on
+		FrameAllocator::Get()->BeginFrame();
+		Profiler::Get()->BeginFrame();
+		MemoryTracker::BeginFrame();
 
-		input->Update();
+		myWindow.ProcessMessage();
 
-		if (!myWindow.IsActive() || input->IsKeyPressed(KeyCode::ESCAPE))
+		if (!myWindow.IsActive())
 		{
 			Quit();
 			continue;
@@ -69,27 +111,58 @@ void App::Run(const AppConfig& config)
 
         AudioSystem::Get()->Update();
 
-		float deltaTime = TimeUtil::GetDeltaTime();
-	#if defined(_DEBUG)
-		if (deltaTime < 0.5f) // Primarily for handling Breakpoints
-	#endif
-		{
-			mCurrentState->Update(deltaTime);
+		const uint64_t frameStart = TimeUtil::GetTimeNanoseconds();
+		const uint64_t frameDuration = std::min(frameStart - lastFrameStart, maxFrameDuration);
+		lastFrameStart = frameStart;
+		mFrameTime = frameDuration * 1e-9f;
 
-#ifndef USE_PHYSICS_SERVICE // ifndef - if not defined
-            PhysicsWorld::Get()->Update(deltaTime);
-#endif		// IF we are NOT using the physics service -> Use the regular update				
+		{
+			PROFILE_SCOPE("App::Update");
+			if (fixedStep)
+			{
+				accumulator += frameDuration;
+				for (uint32_t step = 0; step < config.maxSimulationSteps && accumulator >= tickDuration; ++step)
+				{
+					tick(tickDeltaTime);
+					accumulator -= tickDuration;
+				}
+				accumulator %= tickDuration;
+				mInterpolationAlpha = static_cast<float>(accumulator) / static_cast<float>(tickDuration);
+			}
+			else
+			{
+				tick(mFrameTime);
+			}
 		}
 
-		GraphicsSystem* gs = GraphicsSystem::Get();
-		gs->BeginRender();
-			mCurrentState->Render();
+		if (input->IsKeyPressed(KeyCode::ESCAPE))
+		{
+			Quit();
+			continue;
+		}
 
-			DebugUI::BeginRender();
-				mCurrentState->DebugUI();
-			DebugUI::EndRender();
+		{
+			PROFILE_SCOPE("App::Render");
+			GraphicsSystem* gs = GraphicsSystem::Get();
+			gs->BeginRender();
+				mCurrentState->Render();
+
+				DebugUI::BeginRender();
+					mCurrentState->DebugUI();
+					DebugUI::ShowProfiler();
+					DebugUI::ShowMemory();
+				DebugUI::EndRender();
+
+			gs->EndRender();
+		}
 
-		gs->EndRender();
+		if (minFrameDuration > 0)
+		{
+			// Paced from the previous deadline so the rate doesn't drift, a frame that overran starts a new schedule
+			PROFILE_SCOPE("App::FrameLimiter");
+			nextFrameDeadline = std::max(nextFrameDeadline + minFrameDuration, TimeUtil::GetTimeNanoseconds());
+			TimeUtil::SleepUntil(nextFrameDeadline);
+		}
 	}
 
 	// Terminate Everything
@@ -101,6 +174,8 @@ void App::Run(const AppConfig& config)
     SoundEffectManager::StaticTerminate();
     AudioSystem::StaticTerminate();
     PhysicsWorld::StaticTerminate();
+    FrameAllocator::StaticTerminate();
+    JobSystem::StaticTerminate();
     EventManager::StaticTerminate();
     ModelManager::StaticTerminate();
     TextureManager::StaticTerminate();
@@ -110,6 +185,13 @@ void App::Run(const AppConfig& config)
 	InputSystem::StaticTerminate();
 
 	myWindow.Terminate();
+	Profiler::StaticTerminate();
+
+	if (!config.memoryReportFile.empty())
+	{
+		MemoryTracker::WriteReport(config.memoryReportFile);
+	}
+	Logger::StaticTerminate();
 }
 
 void App::Quit()
@@ -124,4 +206,38 @@ void App::ChangeState(const std::string& stateName)
 	{
 		mNextState = iter->second.get();
 	}
+}
+
+App::TickListenerId App::AddTickListener(TickCallback callback)
+{
+	const TickListenerId listenerId = mNextTickListenerId++;
+	mTickListeners.emplace_back(listenerId, std::move(callback));
+	return listenerId;
+}
+
+void App::RemoveTickListener(TickListenerId listenerId)
+{
+	auto iter = std::find_if(mTickListeners.begin(), mTickListeners.end(), [listenerId](const auto& listener)
+	{
+		return listener.first == listenerId;
+	});
+	if (iter != mTickListeners.end())
+	{
+		mTickListeners.erase(iter);
+	}
+}
+
+uint64_t App::GetSimulationTick() const
+{
+	return mSimulationTick;
+}
+
+float App::GetInterpolationAlpha() const
+{
+	return mInterpolationAlpha;
+}
+
+float App::GetFrameTime() const
+{
+	return mFrameTime;
 }
\ No newline at end of file
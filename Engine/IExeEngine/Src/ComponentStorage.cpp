@@ -0,0 +1,87 @@
+#include "Precompiled.h"
+#include "ComponentStorage.h"
+#include "TypeRegistry.h"
+
+using namespace IExeEngine;
+
+void ComponentStorage::Initialize(ComponentLayout layout)
+{
+    mLayout = layout;
+}
+
+void ComponentStorage::Terminate()
+{
+    for (const std::unique_ptr<Pool>& pool : mPools)
+    {
+        ASSERT(pool == nullptr || pool->mComponents.empty(), "ComponentStorage: Components still alive on terminate!");
+    }
+    mPools.clear();
+}
+
+ComponentLayout ComponentStorage::GetLayout() const
+{
+    return mLayout;
+}
+
+void ComponentStorage::Delete(Component* component)
+{
+    if (mLayout == ComponentLayout::PerObject)
+    {
+        delete component;
+        return;
+    }
+
+    Pool& pool = *mPools[component->GetTypeId()];
+    const uint32_t index = component->mStorageIndex;
+    ASSERT(index < pool.mComponents.size() && pool.mComponents[index] == component, "ComponentStorage: Component isn't in its pool!");
+
+    Component* last = pool.mComponents.back();
+    pool.mComponents[index] = last;
+    last->mStorageIndex = index;
+    pool.mComponents.pop_back();
+
+    pool.Delete(component);
+}
+
+void ComponentStorage::Update(float deltaTime)
+{
+    // Indexed, an update can create game objects, which adds pools and grows their lists
+    for (std::size_t p = 0; p < mPools.size(); ++p)
+    {
+        if (mPools[p] != nullptr)
+        {
+            mPools[p]->Update(deltaTime);
+        }
+    }
+}
+
+void ComponentStorage::LateUpdate(float deltaTime)
+{
+    for (std::size_t p = 0; p < mPools.size(); ++p)
+    {
+        if (mPools[p] != nullptr)
+        {
+            mPools[p]->LateUpdate(deltaTime);
+        }
+    }
+}
+
+std::size_t ComponentStorage::GetCount(uint32_t typeId) const
+{
+    if (typeId >= mPools.size() || mPools[typeId] == nullptr)
+    {
+        return 0;
+    }
+    return mPools[typeId]->mComponents.size();
+}
+
+ComponentStorage::PoolSettings ComponentStorage::GetPoolSettings(uint32_t typeId, const std::type_info& type)
+{
+    // Custom components that aren't registered can share a type id with one that is, so the type has to match too
+    const ComponentInfo* info = TypeRegistry::GetComponentInfo(typeId);
+    if (info != nullptr && *info->type == type)
+    {
+        return { info->name, info->blocksPerPage };
+    }
+    return { type.name(), ComponentsPerPage };
+}
\ No newline at end of file
@@ -0,0 +1,544 @@
+#include "Precompiled.h"
+#include "CookedLevel.h"
+#include "TypeRegistry.h"
+
+using namespace IExeEngine;
+
+// Layout, all little endian:
+//   Header
+//   String table: stringCount x { uint32 length, chars, '\0' }
+//   Services: uint32 count, count x { Name, Value }
+//   GameObjects: uint32 count, count x Object
+// Name = uint32 string index, uint32 TypeRegistry hash
+// Object = uint32 name string index, uint32 count x { Name, Value } components, uint32 count x Object children,
+//          uint32 count x { Name, Value } overrides
+// Value = uint8 ValueKind followed by its data, see WriteValue
+namespace
+{
+    struct Header
+    {
+        uint32_t magic = CookedLevel::Magic;
+        uint16_t version = CookedLevel::Version;
+        uint16_t componentLayout = 0; // ComponentLayout + 1, 0 when the level doesn't set one
+        uint32_t capacity = 0;
+        uint32_t stringCount = 0;
+    };
+    static_assert(sizeof(Header) == 16, "CookedLevel: Header must stay tightly packed!");
+
+    enum class ValueKind : uint8_t
+    {
+        Null,
+        False,
+        True,
+        Int,    // int64
+        Uint,   // uint64, only for values past int64
+        Double,
+        String, // uint32 string index
+        Array,  // uint32 count, count x Value
+        Object  // uint32 count, count x { uint32 key string index, Value }
+    };
+
+    bool ParseJson(const std::filesystem::path& filePath, rapidjson::Document& doc)
+    {
+        FILE* file = nullptr;
+        auto err = fopen_s(&file, filePath.u8string().c_str(), "r");
+        if (err != 0 || file == nullptr)
+        {
+            LOG_ERROR(Engine, "CookedLevel: Failed to open %s!", filePath.u8string().c_str());
+            return false;
+        }
+
+        char readBuffer[65536];
+        rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
+        doc.ParseStream(readStream);
+        fclose(file);
+        if (doc.HasParseError() || !doc.IsObject())
+        {
+            LOG_ERROR(Engine, "CookedLevel: Failed to parse %s!", filePath.u8string().c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Builds the body in memory first, the string table that goes in front of it is only complete at the end
+    class LevelWriter
+    {
+    public:
+        bool WriteServices(const rapidjson::Value& services)
+        {
+            if (!services.IsObject())
+            {
+                return false;
+            }
+            Write(static_cast<uint32_t>(services.MemberCount()));
+            for (auto& service : services.GetObj())
+            {
+                WriteName(service.name);
+                WriteValue(service.value);
+            }
+            return true;
+        }
+
+        bool WriteGameObjects(const rapidjson::Value& gameObjects)
+        {
+            if (!gameObjects.IsObject())
+            {
+                return false;
+            }
+            Write(static_cast<uint32_t>(gameObjects.MemberCount()));
+            for (auto& gameObject : gameObjects.GetObj())
+            {
+                if (!WriteObject(gameObject.name, gameObject.value))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool Save(const std::filesystem::path& cookedFile, std::optional<ComponentLayout> componentLayout, uint32_t capacity) const
+        {
+            FILE* file = nullptr;
+            fopen_s(&file, cookedFile.u8string().c_str(), "wb");
+            if (file == nullptr)
+            {
+                LOG_ERROR(Engine, "CookedLevel: Failed to create %s!", cookedFile.u8string().c_str());
+                return false;
+            }
+
+            Header header;
+            header.componentLayout = componentLayout.has_value() ? static_cast<uint16_t>(*componentLayout) + 1 : 0;
+            header.capacity = capacity;
+            header.stringCount = static_cast<uint32_t>(mStrings.size());
+            bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+            for (const std::string* str : mStrings)
+            {
+                const uint32_t length = static_cast<uint32_t>(str->size());
+                written = written && fwrite(&length, sizeof(length), 1, file) == 1;
+                written = written && fwrite(str->c_str(), 1, length + 1, file) == length + 1;
+            }
+            written = written && fwrite(mBody.data(), 1, mBody.size(), file) == mBody.size();
+            // fclose flushes the buffered tail, so a full disk can still show up here
+            written = (fclose(file) == 0) && written;
+            if (!written)
+            {
+                // Don't leave a truncated file behind for the loader to trip over
+                LOG_ERROR(Engine, "CookedLevel: Failed to write %s!", cookedFile.u8string().c_str());
+                std::error_code error;
+                std::filesystem::remove(cookedFile, error);
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        template<class T>
+        void Write(const T& value)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            mBody.insert(mBody.end(), bytes, bytes + sizeof(T));
+        }
+
+        // Each distinct string is stored once however many objects use it
+        void WriteString(const rapidjson::Value& str)
+        {
+            auto [iter, added] = mStringIndices.emplace(std::string(str.GetString(), str.GetStringLength()),
+                static_cast<uint32_t>(mStrings.size()));
+            if (added)
+            {
+                mStrings.push_back(&iter->first);
+            }
+            Write(iter->second);
+        }
+
+        void WriteName(const rapidjson::Value& name)
+        {
+            WriteString(name);
+            Write(TypeRegistry::HashName(std::string_view(name.GetString(), name.GetStringLength())));
+        }
+
+        void WriteValue(const rapidjson::Value& value)
+        {
+            switch (value.GetType())
+            {
+            case rapidjson::kNullType:
+                Write(ValueKind::Null);
+                break;
+            case rapidjson::kFalseType:
+                Write(ValueKind::False);
+                break;
+            case rapidjson::kTrueType:
+                Write(ValueKind::True);
+                break;
+            case rapidjson::kNumberType:
+                // Stored the way the parser typed it, so Is/Get on the rebuilt value behave the same
+                if (value.IsDouble())
+                {
+                    Write(ValueKind::Double);
+                    Write(value.GetDouble());
+                }
+                else if (value.IsInt64())
+                {
+                    Write(ValueKind::Int);
+                    Write(value.GetInt64());
+                }
+                else
+                {
+                    Write(ValueKind::Uint);
+                    Write(value.GetUint64());
+                }
+                break;
+            case rapidjson::kStringType:
+                Write(ValueKind::String);
+                WriteString(value);
+                break;
+            case rapidjson::kArrayType:
+                Write(ValueKind::Array);
+                Write(static_cast<uint32_t>(value.Size()));
+                for (auto& element : value.GetArray())
+                {
+                    WriteValue(element);
+                }
+                break;
+            case rapidjson::kObjectType:
+                Write(ValueKind::Object);
+                Write(static_cast<uint32_t>(value.MemberCount()));
+                for (auto& member : value.GetObj())
+                {
+                    WriteString(member.name);
+                    WriteValue(member.value);
+                }
+                break;
+            }
+        }
+
+        void WriteComponents(const rapidjson::Value* components)
+        {
+            if (components == nullptr || !components->IsObject())
+            {
+                Write(0u);
+                return;
+            }
+            Write(static_cast<uint32_t>(components->MemberCount()));
+            for (auto& component : components->GetObj())
+            {
+                WriteName(component.name);
+                WriteValue(component.value);
+            }
+        }
+
+        // value is a level or template entry, { "Template": ..., "Components": { overrides } }. The template's own
+        // components and children come first and the overrides after them, in the order Make and
+        // OverrideDeserialize apply them
+        bool WriteObject(const rapidjson::Value& name, const rapidjson::Value& value)
+        {
+            if (!value.IsObject() || !value.HasMember("Template") || !value["Template"].IsString())
+            {
+                LOG_ERROR(Engine, "CookedLevel: %s has no template!", name.GetString());
+                return false;
+            }
+            const std::string templatePath = value["Template"].GetString();
+            if (std::find(mTemplatePath.begin(), mTemplatePath.end(), templatePath) != mTemplatePath.end())
+            {
+                LOG_ERROR(Engine, "CookedLevel: %s is a child of itself!", templatePath.c_str());
+                return false;
+            }
+            // The game rejects anything deeper, so don't cook a level it can't load
+            if (mTemplatePath.size() >= CookedLevel::Reader::MaxObjectDepth)
+            {
+                LOG_ERROR(Engine, "CookedLevel: %s nests deeper than %u objects!", templatePath.c_str(), CookedLevel::Reader::MaxObjectDepth);
+                return false;
+            }
+            const rapidjson::Document* prefab = GetTemplate(templatePath);
+            if (prefab == nullptr)
+            {
+                return false;
+            }
+
+            mTemplatePath.push_back(templatePath);
+            WriteString(name);
+            WriteComponents(prefab->HasMember("Components") ? &(*prefab)["Components"] : nullptr);
+            if (prefab->HasMember("Children") && (*prefab)["Children"].IsObject())
+            {
+                const rapidjson::Value& children = (*prefab)["Children"];
+                Write(static_cast<uint32_t>(children.MemberCount()));
+                for (auto& child : children.GetObj())
+                {
+                    if (!WriteObject(child.name, child.value))
+                    {
+                        mTemplatePath.pop_back();
+                        return false;
+                    }
+                }
+            }
+            else
+            {
+                Write(0u);
+            }
+            mTemplatePath.pop_back();
+            WriteComponents(value.HasMember("Components") ? &value["Components"] : nullptr);
+            return true;
+        }
+
+        // Every template is parsed once however many objects use it, null if it failed
+        const rapidjson::Document* GetTemplate(const std::string& templatePath)
+        {
+            auto [iter, added] = mTemplates.try_emplace(templatePath);
+            if (added)
+            {
+                auto doc = std::make_unique<rapidjson::Document>();
+                if (ParseJson(templatePath, *doc))
+                {
+                    iter->second = std::move(doc);
+                }
+            }
+            return iter->second.get();
+        }
+
+        std::vector<uint8_t> mBody;
+        std::unordered_map<std::string, uint32_t> mStringIndices;
+        std::vector<const std::string*> mStrings;
+        std::unordered_map<std::string, std::unique_ptr<rapidjson::Document>> mTemplates;
+        std::vector<std::string> mTemplatePath; // Templates being written, from the level object down to the current child
+    };
+}
+
+bool CookedLevel::Cook(const std::filesystem::path& levelFile, const std::filesystem::path& cookedFile)
+{
+    rapidjson::Document doc;
+    if (!ParseJson(levelFile, doc))
+    {
+        return false;
+    }
+    if (!doc.HasMember("Capacity") || !doc["Capacity"].IsInt() || !doc.HasMember("Services") || !doc.HasMember("GameObjects"))
+    {
+        LOG_ERROR(Engine, "CookedLevel: %s needs Capacity, Services and GameObjects!", levelFile.u8string().c_str());
+        return false;
+    }
+
+    std::optional<ComponentLayout> componentLayout;
+    if (doc.HasMember("ComponentLayout") && doc["ComponentLayout"].IsString())
+    {
+        const std::string layout = doc["ComponentLayout"].GetString();
+        componentLayout = (layout == "Pooled") ? ComponentLayout::Pooled : ComponentLayout::PerObject;
+    }
+
+    LevelWriter writer;
+    if (!writer.WriteServices(doc["Services"]) || !writer.WriteGameObjects(doc["GameObjects"]))
+    {
+        LOG_ERROR(Engine, "CookedLevel: Failed to cook %s!", levelFile.u8string().c_str());
+        return false;
+    }
+    return writer.Save(cookedFile, componentLayout, static_cast<uint32_t>(doc["Capacity"].GetInt()));
+}
+
+CookedLevel::Reader::Reader()
+    : mValueAllocator(mValueBuffer, sizeof(mValueBuffer))
+{
+}
+
+template<class T>
+bool CookedLevel::Reader::Read(T& value)
+{
+    if (static_cast<std::size_t>(mEnd - mCurrent) < sizeof(T))
+    {
+        return false;
+    }
+    memcpy(&value, mCurrent, sizeof(T));
+    mCurrent += sizeof(T);
+    return true;
+}
+
+bool CookedLevel::Reader::Open(const std::filesystem::path& cookedFile)
+{
+    if (!mMappedFile.Open(cookedFile))
+    {
+        return false;
+    }
+    mCurrent = mMappedFile.GetData();
+    mEnd = mCurrent + mMappedFile.GetSize();
+
+    Header header;
+    if (!Read(header)
+        || header.magic != Magic
+        || header.version != Version
+        || header.componentLayout > static_cast<uint16_t>(ComponentLayout::Pooled) + 1)
+    {
+        return false;
+    }
+    mComponentLayout.reset();
+    if (header.componentLayout > 0)
+    {
+        mComponentLayout = static_cast<ComponentLayout>(header.componentLayout - 1);
+    }
+    mCapacity = header.capacity;
+
+    // Each string is followed by a terminator, so the views can be handed out as c strings
+    mStrings.clear();
+    mStrings.reserve(std::min<std::size_t>(header.stringCount, mEnd - mCurrent));
+    for (uint32_t i = 0; i < header.stringCount; ++i)
+    {
+        uint32_t length = 0;
+        if (!Read(length) || static_cast<std::size_t>(mEnd - mCurrent) <= length || mCurrent[length] != '\0')
+        {
+            return false;
+        }
+        mStrings.emplace_back(reinterpret_cast<const char*>(mCurrent), length);
+        mCurrent += length + 1;
+    }
+    return true;
+}
+
+std::optional<ComponentLayout> CookedLevel::Reader::GetComponentLayout() const
+{
+    return mComponentLayout;
+}
+
+uint32_t CookedLevel::Reader::GetCapacity() const
+{
+    return mCapacity;
+}
+
+bool CookedLevel::Reader::ReadCount(uint32_t& count)
+{
+    return Read(count);
+}
+
+bool CookedLevel::Reader::ReadString(const char*& str)
+{
+    uint32_t index = 0;
+    if (!Read(index) || index >= mStrings.size())
+    {
+        return false;
+    }
+    str = mStrings[index].data();
+    return true;
+}
+
+bool CookedLevel::Reader::ReadName(const char*& name, uint32_t& nameHash)
+{
+    return ReadString(name) && Read(nameHash);
+}
+
+const rapidjson::Value* CookedLevel::Reader::ReadValue()
+{
+    // The last value is done with, its memory goes back to the buffer
+    mValue.SetNull();
+    mValueAllocator.Clear();
+    return DecodeValue(mValue, 0) ? &mValue : nullptr;
+}
+
+bool CookedLevel::Reader::DecodeValue(rapidjson::Value& value, uint32_t depth)
+{
+    // Nesting comes from the file, so a corrupt one mustn't be able to run the stack out
+    if (depth >= MaxValueDepth)
+    {
+        return false;
+    }
+
+    ValueKind kind = ValueKind::Null;
+    if (!Read(kind))
+    {
+        return false;
+    }
+
+    switch (kind)
+    {
+    case ValueKind::Null:
+        value.SetNull();
+        return true;
+    case ValueKind::False:
+        value.SetBool(false);
+        return true;
+    case ValueKind::True:
+        value.SetBool(true);
+        return true;
+    case ValueKind::Int:
+    {
+        int64_t number = 0;
+        if (!Read(number))
+        {
+            return false;
+        }
+        value.SetInt64(number);
+        return true;
+    }
+    case ValueKind::Uint:
+    {
+        uint64_t number = 0;
+        if (!Read(number))
+        {
+            return false;
+        }
+        value.SetUint64(number);
+        return true;
+    }
+    case ValueKind::Double:
+    {
+        double number = 0.0;
+        if (!Read(number))
+        {
+            return false;
+        }
+        value.SetDouble(number);
+        return true;
+    }
+    case ValueKind::String:
+        return DecodeString(value);
+    case ValueKind::Array:
+    {
+        uint32_t count = 0;
+        if (!Read(count) || static_cast<std::size_t>(mEnd - mCurrent) < count)
+        {
+            return false;
+        }
+        value.SetArray();
+        value.Reserve(count, mValueAllocator);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            rapidjson::Value element;
+            if (!DecodeValue(element, depth + 1))
+            {
+                return false;
+            }
+            value.PushBack(element, mValueAllocator);
+        }
+        return true;
+    }
+    case ValueKind::Object:
+    {
+        uint32_t count = 0;
+        if (!Read(count) || static_cast<std::size_t>(mEnd - mCurrent) < count)
+        {
+            return false;
+        }
+        value.SetObject();
+        value.MemberReserve(count, mValueAllocator);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            rapidjson::Value key;
+            rapidjson::Value member;
+            if (!DecodeString(key) || !DecodeValue(member, depth + 1))
+            {
+                return false;
+            }
+            value.AddMember(key, member, mValueAllocator);
+        }
+        return true;
+    }
+    }
+    return false;
+}
+
+bool CookedLevel::Reader::DecodeString(rapidjson::Value& value)
+{
+    uint32_t index = 0;
+    if (!Read(index) || index >= mStrings.size())
+    {
+        return false;
+    }
+    // Not copied, the mapped string table outlives the value
+    const std::string_view str = mStrings[index];
+    value.SetString(rapidjson::StringRef(str.data(), static_cast<rapidjson::SizeType>(str.size())));
+    return true;
+}
\ No newline at end of file
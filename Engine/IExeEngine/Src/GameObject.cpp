@@ -29,12 +29,27 @@ void GameObject::Terminate()
         child->Terminate();
     }
 
-    for (auto& component : mComponents)
+    for (Component* component : mComponents)
     {
         component->Terminate();
-        component.reset();
+        mComponentStorage->Delete(component);
     }
     mComponents.clear();
+    mComponentMask = 0;
+}
+
+void GameObject::Reset()
+{
+    mName = "EMPTY";
+    mInitialized = false;
+    mId = 0;
+    mHandle = GameObjectHandle();
+    mWorld = nullptr;
+    mComponentStorage = nullptr;
+    mComponents.clear();
+    mComponentMask = 0;
+    mChildren.clear();
+    mParent = nullptr;
 }
 
 void GameObject::Update(float deltaTime)
@@ -3,7 +3,9 @@
 #include "Component.h"
 #include "GameObject.h"
 #include "GameWorld.h"
-// components includes we've made 
+#include "TypeRegistry.h"
+#include "CookedLevel.h"
+// components includes we've made, including them registers them with the TypeRegistry
 #include "TransformComponent.h"
 #include "CameraComponent.h"
 #include "FPSCameraComponent.h"
@@ -28,142 +30,229 @@ namespace
     CustomComponent TryMakeComponent;
     CustomComponent TryGetComponent;
 
-    // Helper funcitons in here only stay in this specific .cpp file
-    Component* AddComponent(const std::string& componentName, GameObject& gameObject)
+    // A component entry of a template with its type looked up once. The name points into the template's document
+    // and is only used for the custom callbacks, for types that aren't registered
+    struct PrefabComponent
     {
-        Component* newComponent = nullptr;
-        if (componentName == "TransformComponent")
-        {
-            newComponent = gameObject.AddComponent<TransformComponent>();
-        }
-        else if (componentName == "CameraComponent")
-        {
-            newComponent = gameObject.AddComponent<CameraComponent>();
-        }
-        else if (componentName == "FPSCameraComponent")
-        {
-            newComponent = gameObject.AddComponent<FPSCameraComponent>();
-        }
-        else if (componentName == "MeshComponent")
-        {
-            newComponent = gameObject.AddComponent<MeshComponent>();
-        }
-        else if (componentName == "ModelComponent")
-        {
-            newComponent = gameObject.AddComponent<ModelComponent>();
-        }
-        else if (componentName == "AnimatorComponent")
-        {
-            newComponent = gameObject.AddComponent<AnimatorComponent>();
-        }
-        else if (componentName == "RigidBodyComponent")
-        {
-            newComponent = gameObject.AddComponent<RigidBodyComponent>();
-        }
-        else if (componentName == "SoundEventComponent")
-        {
-            newComponent = gameObject.AddComponent<SoundEventComponent>();
-        }
-        else if (componentName == "SoundBankComponent")
-        {
-            newComponent = gameObject.AddComponent<SoundBankComponent>();
-        }
-        else if (componentName == "UITextComponent")
+        const ComponentInfo* info = nullptr;
+        const char* name = nullptr;
+        const rapidjson::Value* data = nullptr;
+    };
+    using PrefabComponents = std::vector<PrefabComponent>;
+
+    struct PrefabChild
+    {
+        std::string name;
+        std::filesystem::path templatePath;
+        PrefabComponents overrides;
+    };
+
+    // A template parsed once. The document owns the values the components point at, already turned from text into
+    // numbers and strings, so making an instance is only adding the components and deserializing those values
+    struct Prefab
+    {
+        rapidjson::Document document;
+        std::filesystem::file_time_type writeTime;
+        PrefabComponents components;
+        std::vector<PrefabChild> children;
+    };
+
+    // Keyed by template path, each prefab is its own allocation so the values stay put when the map grows
+    std::unordered_map<std::string, std::unique_ptr<Prefab>> sPrefabs;
+
+    void CompileComponents(const rapidjson::Value& components, PrefabComponents& compiled)
+    {
+        for (auto& component : components.GetObj())
         {
-            newComponent = gameObject.AddComponent<UITextComponent>();
+            const char* componentName = component.name.GetString();
+            const std::string_view nameView(componentName, component.name.GetStringLength());
+            compiled.push_back({ TypeRegistry::FindComponent(nameView), componentName, &component.value });
         }
-        else if (componentName == "UISpriteComponent")
+    }
+
+    // Parses the template the first time it's asked for, null if it can't be read. Saved templates are only picked
+    // up again through ReloadChangedPrefabs, so spawning never touches the file system once a template is cached
+    const Prefab* GetPrefab(const std::filesystem::path& templatePath)
+    {
+        auto [iter, added] = sPrefabs.try_emplace(templatePath.u8string());
+        if (!added)
         {
-            newComponent = gameObject.AddComponent<UISpriteComponent>();
+            return iter->second.get();
         }
-        else if (componentName == "UIButtonComponent")
+
+        FILE* file = nullptr;
+        auto err = fopen_s(&file, templatePath.u8string().c_str(), "r");
+        if (err != 0 || file == nullptr)
         {
-            newComponent = gameObject.AddComponent<UIButtonComponent>();
+            LOG_ERROR(Engine, "GameObjectFactory: Failed to open file %s", templatePath.u8string().c_str());
+            sPrefabs.erase(iter);
+            return nullptr;
         }
-        else if (componentName == "PlayerControllerComponent")
+
+        auto prefab = std::make_unique<Prefab>();
+        std::error_code error;
+        prefab->writeTime = std::filesystem::last_write_time(templatePath, error);
+
+        char readBuffer[65536];
+        rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
+        rapidjson::Document& doc = prefab->document;
+        doc.ParseStream(readStream); // Maps out all of the names and object types -> Allows us to do stuff w them.
+        fclose(file);
+        if (doc.HasParseError() || !doc.IsObject())
         {
-            newComponent = gameObject.AddComponent<PlayerControllerComponent>();
+            LOG_ERROR(Engine, "GameObjectFactory: Failed to parse %s", templatePath.u8string().c_str());
+            sPrefabs.erase(iter);
+            return nullptr;
         }
-        else if (componentName == "TPSCameraComponent")
+
+        CompileComponents(doc["Components"], prefab->components);
+        if (doc.HasMember("Children"))
         {
-            newComponent = gameObject.AddComponent<TPSCameraComponent>();
+            auto children = doc["Children"].GetObj();
+            for (auto& child : children)
+            {
+                PrefabChild& prefabChild = prefab->children.emplace_back();
+                prefabChild.name = child.name.GetString();
+                prefabChild.templatePath = child.value["Template"].GetString();
+                if (child.value.HasMember("Components"))
+                {
+                    CompileComponents(child.value["Components"], prefabChild.overrides);
+                }
+            }
         }
-        else if (componentName == "ZombieControllerComponent")
+        iter->second = std::move(prefab);
+        return iter->second.get();
+    }
+
+    // Helper funcitons in here only stay in this specific .cpp file
+    Component* AddComponent(const PrefabComponent& component, GameObject& gameObject)
+    {
+        Component* newComponent = nullptr;
+        if (component.info != nullptr)
         {
-            newComponent = gameObject.AddComponent<ZombieControllerComponent>();
+            newComponent = component.info->make(gameObject);
         }
-        else
+        else if (TryMakeComponent)
         {
-            newComponent = TryMakeComponent(componentName, gameObject);
+            newComponent = TryMakeComponent(component.name, gameObject);
         }
 
-        ASSERT(newComponent != nullptr, "GameObjectFactory: Component type [%s] not found!", componentName.c_str());
+        ASSERT(newComponent != nullptr, "GameObjectFactory: Component type [%s] not found!", component.name);
 
         return newComponent;
     }
 
-    Component* GetComponent(const std::string& componentName, GameObject& gameObject)
+    Component* GetComponent(const PrefabComponent& component, GameObject& gameObject)
     {
-        Component* component = nullptr;
-        if (componentName == "TransformComponent")
-        {
-            component = gameObject.GetComponent<TransformComponent>();
-        }
-        else if (componentName == "CameraComponent")
-        {
-            component = gameObject.GetComponent<CameraComponent>();
-        }
-        else if (componentName == "FPSCameraComponent")
+        Component* ownedComponent = nullptr;
+        if (component.info != nullptr)
         {
-            component = gameObject.GetComponent<FPSCameraComponent>();
+            ownedComponent = component.info->get(gameObject);
         }
-        else if (componentName == "MeshComponent")
+        else if (TryGetComponent)
         {
-            component = gameObject.GetComponent<MeshComponent>();
+            ownedComponent = TryGetComponent(component.name, gameObject);
         }
-        else if (componentName == "ModelComponent")
+
+        ASSERT(ownedComponent != nullptr, "GameObjectFactory: Component type [%s] not found!", component.name);
+        return ownedComponent;
+    }
+
+    // Cooked names carry their hash, the name is still compared in case a custom type that isn't registered shares
+    // the hash of one that is. The value is only valid until the next read
+    bool ReadCookedComponent(CookedLevel::Reader& reader, PrefabComponent& component)
+    {
+        uint32_t nameHash = 0;
+        if (!reader.ReadName(component.name, nameHash))
         {
-            component = gameObject.GetComponent<ModelComponent>();
+            return false;
         }
-        else if (componentName == "AnimatorComponent")
+        component.data = reader.ReadValue();
+        component.info = TypeRegistry::FindComponent(nameHash);
+        if (component.info != nullptr && strcmp(component.info->name, component.name) != 0)
         {
-            component = gameObject.GetComponent<AnimatorComponent>();
+            component.info = nullptr;
         }
-        else if (componentName == "RigidBodyComponent")
+        return component.data != nullptr;
+    }
+
+    void ApplyOverrides(const PrefabComponents& overrides, GameObject& gameObject)
+    {
+        for (const PrefabComponent& component : overrides)
         {
-            component = gameObject.GetComponent<RigidBodyComponent>();
+            Component* ownedComponent = GetComponent(component, gameObject);
+            if (ownedComponent != nullptr)
+            {
+                ownedComponent->Deserialize(*component.data);
+            }
         }
-        else if (componentName == "UITextComponent")
+    }
+
+    GameObject* MakeCookedObject(CookedLevel::Reader& reader, GameWorld& gameWorld, uint32_t depth)
+    {
+        // Each child recurses, cap it so a corrupt level fails instead of overflowing the stack
+        if (depth >= CookedLevel::Reader::MaxObjectDepth)
         {
-            component = gameObject.GetComponent<UITextComponent>();
+            LOG_ERROR(Engine, "GameObjectFactory: Cooked object nests deeper than %u", CookedLevel::Reader::MaxObjectDepth);
+            return nullptr;
         }
-        else if (componentName == "UISpriteComponent")
+
+        const char* name = nullptr;
+        uint32_t componentCount = 0;
+        if (!reader.ReadString(name) || !reader.ReadCount(componentCount))
         {
-            component = gameObject.GetComponent<UISpriteComponent>();
+            return nullptr;
         }
-        else if (componentName == "UIButtonComponent")
+
+        GameObject* gameObject = gameWorld.CreateGameObject(name);
+        PrefabComponent component;
+        for (uint32_t i = 0; i < componentCount; ++i)
         {
-            component = gameObject.GetComponent<UIButtonComponent>();
+            if (!ReadCookedComponent(reader, component))
+            {
+                return nullptr;
+            }
+            Component* newComponent = AddComponent(component, *gameObject);
+            if (newComponent != nullptr)
+            {
+                newComponent->Deserialize(*component.data);
+            }
         }
-        else if (componentName == "PlayerControllerComponent")
+
+        uint32_t childCount = 0;
+        if (!reader.ReadCount(childCount))
         {
-            component = gameObject.GetComponent<PlayerControllerComponent>();
+            return nullptr;
         }
-        else if (componentName == "TPSCameraComponent")
+        for (uint32_t i = 0; i < childCount; ++i)
         {
-            component = gameObject.GetComponent<TPSCameraComponent>();
+            GameObject* childGO = MakeCookedObject(reader, gameWorld, depth + 1);
+            if (childGO == nullptr)
+            {
+                return nullptr;
+            }
+            gameObject->AddChild(childGO);
+            childGO->SetParent(gameObject);
         }
-        else if (componentName == "ZombieControllerComponent")
+
+        uint32_t overrideCount = 0;
+        if (!reader.ReadCount(overrideCount))
         {
-            component = gameObject.GetComponent<ZombieControllerComponent>();
+            return nullptr;
         }
-        else
+        for (uint32_t i = 0; i < overrideCount; ++i)
         {
-            component = TryGetComponent(componentName, gameObject);
+            if (!ReadCookedComponent(reader, component))
+            {
+                return nullptr;
+            }
+            Component* ownedComponent = GetComponent(component, *gameObject);
+            if (ownedComponent != nullptr)
+            {
+                ownedComponent->Deserialize(*component.data);
+            }
         }
-
-        ASSERT(component != nullptr, "GameObjectFactory: Component type [%s] not found!", componentName.c_str());
-        return component;
+        return gameObject;
     }
 }
 
@@ -179,42 +268,30 @@ void GameObjectFactory::SetCustomGet(CustomComponent callback)
 
 void GameObjectFactory::Make(const std::filesystem::path& templatePath, GameObject& gameObject, GameWorld& gameWorld)
 {
-    FILE* file = nullptr;
-    auto err = fopen_s(&file, templatePath.u8string().c_str(), "r");
-    ASSERT(err == 0, "GameObjectFactory: Failed to open file %s", templatePath.u8string().c_str());
-
-    char readBuffer[65536];
-    rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
-    fclose(file);
-    // Pass in a template, read it into the file buffer, close the file
-
-    rapidjson::Document doc;
-    doc.ParseStream(readStream); // Maps out all of the names and object types -> Allows us to do stuff w them.
-    auto components = doc["Components"].GetObj();
-    for (auto& component : components)
+    // The error is logged already, the object is left empty
+    const Prefab* prefab = GetPrefab(templatePath);
+    if (prefab == nullptr)
+    {
+        return;
+    }
+
+    for (const PrefabComponent& component : prefab->components)
     {
-        // TODO read data...
-        Component* newComponent = AddComponent(component.name.GetString(), gameObject);
+        Component* newComponent = AddComponent(component, gameObject);
         if (newComponent != nullptr)
         {
             // Apply the jason value data
-            newComponent->Deserialize(component.value);
+            newComponent->Deserialize(*component.data);
         }
     }
 
-    if (doc.HasMember("Children"))
+    for (const PrefabChild& child : prefab->children)
     {
-        auto children = doc["Children"].GetObj();
-        for (auto& child : children)
-        {
-            std::string name = child.name.GetString();
-            std::filesystem::path childTemplate = child.value["Template"].GetString();
-            GameObject* childGO = gameWorld.CreateGameObject(name, childTemplate);
+        GameObject* childGO = gameWorld.CreateGameObject(child.name, child.templatePath);
 
-            OverrideDeserialize(child.value, *childGO);
-            gameObject.AddChild(childGO);
-            childGO->SetParent(&gameObject);
-        }
+        ApplyOverrides(child.overrides, *childGO);
+        gameObject.AddChild(childGO);
+        childGO->SetParent(&gameObject);
     }
 }
 
@@ -222,14 +299,35 @@ void GameObjectFactory::OverrideDeserialize(const rapidjson::Value& value, GameO
 {
     if (value.HasMember("Components"))
     {
-        auto components = value["Components"].GetObj();
-        for (auto& component : components)
+        PrefabComponents overrides;
+        CompileComponents(value["Components"], overrides);
+        ApplyOverrides(overrides, gameObject);
+    }
+}
+
+GameObject* GameObjectFactory::MakeCooked(CookedLevel::Reader& reader, GameWorld& gameWorld)
+{
+    return MakeCookedObject(reader, gameWorld, 0);
+}
+
+void GameObjectFactory::ReloadChangedPrefabs()
+{
+    for (auto iter = sPrefabs.begin(); iter != sPrefabs.end();)
+    {
+        std::error_code error;
+        const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(std::filesystem::u8path(iter->first), error);
+        if (writeTime != iter->second->writeTime)
         {
-            Component* ownedComponent = GetComponent(component.name.GetString(), gameObject);
-            if (ownedComponent != nullptr)
-            {
-                ownedComponent->Deserialize(component.value);
-            }
+            iter = sPrefabs.erase(iter);
+        }
+        else
+        {
+            ++iter;
         }
     }
+}
+
+void GameObjectFactory::ClearPrefabCache()
+{
+    sPrefabs.clear();
 }
\ No newline at end of file
@@ -1,17 +1,39 @@
 #include "Precompiled.h"
 #include "GameWorld.h"
 #include "GameObjectFactory.h"
+#include "TransformComponent.h"
+#include "TypeRegistry.h"
+#include "CookedLevel.h"
 
+// Including the engine services registers them with the TypeRegistry
 #include "CameraService.h"
 #include "RenderService.h"
 #include "PhysicsService.h"
 #include "UIRenderService.h"
+#include "AnimationService.h"
 
 using namespace IExeEngine;
 
 namespace
 {
     CustomService TryAddService;
+
+    Service* AddLevelService(const ServiceInfo* serviceInfo, const char* serviceName, GameWorld& gameWorld)
+    {
+        Service* newService = nullptr;
+        if (serviceInfo != nullptr)
+        {
+            newService = serviceInfo->add(gameWorld);
+        }
+        else if (TryAddService)
+        {
+            // Check if its a custom service
+            newService = TryAddService(serviceName, gameWorld);
+        }
+
+        ASSERT(newService != nullptr, "GameWorld: Failed to add service %s!", serviceName);
+        return newService;
+    }
 }
 
 void GameWorld::SetCustomService(CustomService customService)
@@ -19,35 +41,60 @@ void GameWorld::SetCustomService(CustomService customService)
     TryAddService = customService;
 }
 
+void GameWorld::SetComponentLayout(ComponentLayout layout)
+{
+    ASSERT(!mInitialized, "GameWorld: Can't change the component layout when initialized!");
+    mComponentLayout = layout;
+}
+
+ComponentLayout GameWorld::GetComponentLayout() const
+{
+    return mComponentLayout;
+}
+
 void GameWorld::Initialize(uint32_t capacity)
 {
     ASSERT(!mInitialized, "GameWorld: Already initialized!");
+    mComponentStorage.Initialize(mComponentLayout);
+
     // Services have to be added first, then Game Object can be added 
     for (auto& service : mServices)
     {
         service->Initialize();
     }
 
-    mGameObjectSlots.resize(capacity);
-    mFreeSlots.resize(capacity);
-    std::iota(mFreeSlots.begin(), mFreeSlots.end(), 0); // Set the values of the free slots to 0, 1, 2, 3, 4, 5, 6, 7, 8, 9... up to capacity
+    AddSlots(capacity);
 
     mInitialized = true;
 }
 
 void GameWorld::Terminate()
 {
+    // Objects terminate their children, and a child can sit in any slot, so only roots are terminated and nothing
+    // is freed until all of them are
     for (Slot& slot : mGameObjectSlots)
     {
-        if (slot.gameObject != nullptr)
+        if (slot.gameObject != nullptr && slot.gameObject->GetParent() == nullptr)
         {
             slot.gameObject->Terminate();
-            slot.gameObject.reset();
         }
     }
+    for (Slot& slot : mGameObjectSlots)
+    {
+        if (slot.gameObject != nullptr)
+        {
+            mGameObjectAllocator.Delete(slot.gameObject);
+        }
+    }
+    for (GameObject* gameObject : mFreeGameObjects)
+    {
+        mGameObjectAllocator.Delete(gameObject);
+    }
     mGameObjectSlots.clear();
     mFreeSlots.clear();
+    mFreeGameObjects.clear();
     mToBeDestroyed.clear();
+    mComponentStorage.Terminate();
 
     // Get rid of all game objects to make sure they dont mess with the services
     for (auto& service : mServices)
@@ -62,12 +109,20 @@ void GameWorld::Terminate()
 
 void GameWorld::Update(float deltaTime)
 {
+    PROFILE_SCOPE("GameWorld::Update");
     // Game Objects Update
-    for (Slot& slot : mGameObjectSlots)
+    if (mComponentLayout == ComponentLayout::Pooled)
     {
-        if (slot.gameObject != nullptr)
+        mComponentStorage.Update(deltaTime);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < mGameObjectSlots.size(); ++i)
         {
-            slot.gameObject->Update(deltaTime);
+            if (mGameObjectSlots[i].gameObject != nullptr)
+            {
+                mGameObjectSlots[i].gameObject->Update(deltaTime);
+            }
         }
     }
     // Services Update (i.e. Physics)
@@ -76,19 +131,31 @@ void GameWorld::Update(float deltaTime)
         service->Update(deltaTime);
     }
     // Game Objects Late Update (React to the physiscs update before rendering)
-    for (Slot& slot : mGameObjectSlots)
     {
-        if (slot.gameObject != nullptr)
+        PROFILE_SCOPE("GameWorld::LateUpdate");
+        if (mComponentLayout == ComponentLayout::Pooled)
         {
-            slot.gameObject->LateUpdate(deltaTime);
+            mComponentStorage.LateUpdate(deltaTime);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < mGameObjectSlots.size(); ++i)
+            {
+                if (mGameObjectSlots[i].gameObject != nullptr)
+                {
+                    mGameObjectSlots[i].gameObject->LateUpdate(deltaTime);
+                }
+            }
         }
     }
-    
+
+    UpdateTransforms();
     ProcessDestoyList();
 }
 
 void GameWorld::Render()
 {
+    PROFILE_SCOPE("GameWorld::Render");
     for (auto& service : mServices)
     {
         service->Render();
@@ -97,11 +164,11 @@ void GameWorld::Render()
 
 void GameWorld::DebugUI()
 {
-    for (Slot& slot : mGameObjectSlots)
+    for (std::size_t i = 0; i < mGameObjectSlots.size(); ++i)
     {
-        if (slot.gameObject != nullptr)
+        if (mGameObjectSlots[i].gameObject != nullptr)
         {
-            slot.gameObject->DebugUI();
+            mGameObjectSlots[i].gameObject->DebugUI();
         }
     }
     for (auto& service : mServices)
@@ -113,28 +180,42 @@ void GameWorld::DebugUI()
 GameObject* GameWorld::CreateGameObject(std::string name, const std::filesystem::path& templatePath)
 {
     ASSERT(mInitialized, "GameWorld: Not initialized!");
+    MEMORY_TAG(Components);
     if (mFreeSlots.empty())
     {
-        ASSERT(false, "GameWorld: No more free slots to create a new GameObject!");
-        return nullptr;
+        AddSlots(SlotsPerPage);
     }
 
     const uint32_t freeSlot = mFreeSlots.back();
     mFreeSlots.pop_back();
 
+    GameObject* gameObject = nullptr;
+    if (!mFreeGameObjects.empty())
+    {
+        gameObject = mFreeGameObjects.back();
+        mFreeGameObjects.pop_back();
+    }
+    else
+    {
+        gameObject = mGameObjectAllocator.New();
+        ASSERT(gameObject != nullptr, "GameWorld: Failed to allocate a GameObject!");
+    }
+
     // = Is free for the game object to be created
     Slot& slot = mGameObjectSlots[freeSlot];
-    slot.gameObject = std::make_unique<GameObject>();
-    slot.gameObject->SetName(name);
-    slot.gameObject->mHandle.mIndex = freeSlot;
-    slot.gameObject->mHandle.mGeneration = slot.generation;
-    slot.gameObject->mWorld = this;
+    slot.gameObject = gameObject;
+    gameObject->SetName(name);
+    gameObject->mHandle.mIndex = freeSlot;
+    gameObject->mHandle.mGeneration = slot.generation;
+    gameObject->mWorld = this;
+    gameObject->mComponentStorage = &mComponentStorage;
 
+    // Templates can create more objects and grow the slots, so slot isn't used past here
     if (!templatePath.empty())
     {
-        GameObjectFactory::Make(templatePath, *slot.gameObject, *this);
+        GameObjectFactory::Make(templatePath, *gameObject, *this);
     }
-    return slot.gameObject.get();
+    return gameObject;
 }
 
 void GameWorld::DestroyGameObject(const GameObjectHandle& handle)
@@ -151,48 +232,42 @@ void GameWorld::DestroyGameObject(const GameObjectHandle& handle)
 
 void GameWorld::LoadLevel(const std::filesystem::path& levelFile)
 {
+    if (levelFile.extension() == CookedLevel::Extension)
+    {
+        LoadCookedLevel(levelFile);
+        return;
+    }
+
+    // Templates are only checked for edits here, not on every spawn
+    GameObjectFactory::ReloadChangedPrefabs();
+
     FILE* file = nullptr;
     auto err = fopen_s(&file, levelFile.u8string().c_str(), "r");
     ASSERT(err == 0 && file != nullptr, "GameWorld: Failed to open %s!", levelFile.u8string().c_str());
 
     char readBuffer[65536];
     rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
-    fclose(file);
 
+    // The stream reads as it parses, so the file stays open until it's done
     rapidjson::Document doc;
     doc.ParseStream(readStream);
+    fclose(file);
 
     auto services = doc["Services"].GetObj();
     for (auto& service : services)
     {
-        std::string serviceName = service.name.GetString();
-        Service* newService = nullptr;
-        if (serviceName == "CameraService")
-        {
-            newService = AddService<CameraService>();
-        }
-        else if (serviceName == "RenderService")
-        {
-            newService = AddService<RenderService>();
-        }
-        else if (serviceName == "PhysicsService")
-        {
-            newService = AddService<PhysicsService>();
-        }
-        else if (serviceName == "UIRenderService")
-        {
-            newService = AddService<UIRenderService>();
-        }
-        else
-        {
-            // Check if its a custom service
-            newService = TryAddService(serviceName, *this);
-        }
-
-        ASSERT(newService != nullptr, "GameWorld: Failed to add service %s!", serviceName.c_str());
+        const char* serviceName = service.name.GetString();
+        const ServiceInfo* serviceInfo = TypeRegistry::FindService(std::string_view(serviceName, service.name.GetStringLength()));
+        Service* newService = AddLevelService(serviceInfo, serviceName, *this);
         newService->Deserialize(service.value);
     }
 
+    if (doc.HasMember("ComponentLayout"))
+    {
+        const std::string layout = doc["ComponentLayout"].GetString();
+        SetComponentLayout((layout == "Pooled") ? ComponentLayout::Pooled : ComponentLayout::PerObject);
+    }
+
     uint32_t capacity = static_cast<uint32_t>(doc["Capacity"].GetInt());
     Initialize(capacity);
 
@@ -207,6 +282,59 @@ void GameWorld::LoadLevel(const std::filesystem::path& levelFile)
     }
 }
 
+void GameWorld::LoadCookedLevel(const std::filesystem::path& levelFile)
+{
+    // Everything comes from the one mapped file, templates included, nothing is parsed
+    CookedLevel::Reader reader;
+    const bool opened = reader.Open(levelFile);
+    ASSERT(opened, "GameWorld: %s is not a valid cooked level!", levelFile.u8string().c_str());
+    if (!opened)
+    {
+        return;
+    }
+
+    uint32_t serviceCount = 0;
+    bool valid = reader.ReadCount(serviceCount);
+    for (uint32_t i = 0; valid && i < serviceCount; ++i)
+    {
+        const char* serviceName = nullptr;
+        uint32_t nameHash = 0;
+        valid = reader.ReadName(serviceName, nameHash);
+        const rapidjson::Value* value = valid ? reader.ReadValue() : nullptr;
+        valid = value != nullptr;
+        if (valid)
+        {
+            // Compared in case a custom service shares a registered one's hash
+            const ServiceInfo* serviceInfo = TypeRegistry::FindService(nameHash);
+            if (serviceInfo != nullptr && strcmp(serviceInfo->name, serviceName) != 0)
+            {
+                serviceInfo = nullptr;
+            }
+            Service* newService = AddLevelService(serviceInfo, serviceName, *this);
+            newService->Deserialize(*value);
+        }
+    }
+
+    if (reader.GetComponentLayout().has_value())
+    {
+        SetComponentLayout(*reader.GetComponentLayout());
+    }
+    Initialize(reader.GetCapacity());
+
+    uint32_t gameObjectCount = 0;
+    valid = valid && reader.ReadCount(gameObjectCount);
+    for (uint32_t i = 0; valid && i < gameObjectCount; ++i)
+    {
+        GameObject* go = GameObjectFactory::MakeCooked(reader, *this);
+        valid = go != nullptr;
+        if (valid)
+        {
+            go->Initialize();
+        }
+    }
+    ASSERT(valid, "GameWorld: %s is truncated!", levelFile.u8string().c_str());
+}
+
 bool GameWorld::IsValid(const GameObjectHandle& handle)
 {
     if (handle.mIndex < 0 || handle.mIndex >= mGameObjectSlots.size())
@@ -221,16 +349,63 @@ bool GameWorld::IsValid(const GameObjectHandle& handle)
     return true;
 }
 
+void GameWorld::AddSlots(uint32_t count)
+{
+    const uint32_t first = static_cast<uint32_t>(mGameObjectSlots.size());
+    mGameObjectSlots.resize(first + count);
+    // Handed out from the back, highest index first like the initial slots always were
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        mFreeSlots.push_back(first + i);
+    }
+}
+
+void GameWorld::UpdateTransforms()
+{
+    PROFILE_SCOPE("GameWorld::UpdateTransforms");
+    // Depth first from every root, a child is visited after its parent so it builds on the parent's new world
+    // transform, and only objects whose local transform or a parent's changed are recomputed
+    for (Slot& slot : mGameObjectSlots)
+    {
+        if (slot.gameObject == nullptr || slot.gameObject->GetParent() != nullptr)
+        {
+            continue;
+        }
+
+        mTransformVisits.push_back({ slot.gameObject, nullptr, false });
+        while (!mTransformVisits.empty())
+        {
+            const TransformVisit visit = mTransformVisits.back();
+            mTransformVisits.pop_back();
+
+            const Graphics::Transform* world = visit.parentWorld;
+            bool changed = visit.parentChanged;
+            TransformComponent* transformComponent = visit.gameObject->GetComponent<TransformComponent>();
+            if (transformComponent != nullptr)
+            {
+                changed = transformComponent->UpdateWorldTransform(visit.parentWorld, visit.parentChanged);
+                world = &transformComponent->GetWorldTransform();
+            }
+            for (GameObject* child : visit.gameObject->mChildren)
+            {
+                mTransformVisits.push_back({ child, world, changed });
+            }
+        }
+    }
+}
+
 void GameWorld::ProcessDestoyList()
 {
     for (uint32_t index : mToBeDestroyed)
     {
         Slot& slot = mGameObjectSlots[index];
-        GameObject* gameObject = slot.gameObject.get();
+        GameObject* gameObject = slot.gameObject;
         ASSERT(!IsValid(gameObject->GetHandle()), "GameWorld: gameObjects is still AALLIIVVEEEE!");
 
         gameObject->Terminate();
-        slot.gameObject.reset();
+        gameObject->Reset();
+        mFreeGameObjects.push_back(gameObject);
+        slot.gameObject = nullptr;
         mFreeSlots.push_back(index);
     }
 
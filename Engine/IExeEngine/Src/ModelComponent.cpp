@@ -13,18 +13,18 @@ void ModelComponent::Initialize()
     {
         mModelId = mm->LoadModel(mFileName);
 
-        LOG("ModelComponent: Loading %zu animset(s) for %s",
+        LOG_INFO(Engine, "ModelComponent: Loading %zu animset(s) for %s",
             mAnimations.size(), mFileName.c_str());
 
         for (const std::string& animation : mAnimations)
         {
-            LOG("ModelComponent: Adding -> %s", animation.c_str());
+            LOG_VERBOSE(Engine, "ModelComponent: Adding -> %s", animation.c_str());
             mm->AddAnimation(mModelId, animation);
         }
     }
     else
     {
-        LOG("ModelComponent: CACHE HIT - animations skipped for %s", mFileName.c_str());
+        LOG_VERBOSE(Engine, "ModelComponent: CACHE HIT - animations skipped for %s", mFileName.c_str());
     }
 
     ASSERT(mm->GetModel(mModelId) != nullptr,
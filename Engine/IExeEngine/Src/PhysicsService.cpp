@@ -7,6 +7,7 @@ using namespace IExeEngine;
 
 void PhysicsService::Update(float deltaTime)
 {
+	PROFILE_SCOPE("PhysicsService::Update");
 	if (mEnabled)
 	{
 		Physics::PhysicsWorld::Get()->Update(deltaTime);
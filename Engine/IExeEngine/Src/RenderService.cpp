@@ -6,6 +6,7 @@
 #include "TransformComponent.h"
 #include "AnimatorComponent.h"
 #include "GameWorld.h"
+#include "IExeEngine.h"
 #include "SaveUtil.h"
 
 using namespace IExeEngine;
@@ -22,26 +23,40 @@ void RenderService::Initialize()
 
     mShadowEffect.Initialize();
     mShadowEffect.SetDirectionalLight(mDirectionalLight);
+
+    mTickListenerId = MainApp().AddTickListener([this]() { CaptureSimulationState(); });
 }
 
 void RenderService::Terminate()
 {
+    MainApp().RemoveTickListener(mTickListenerId);
     mShadowEffect.Terminate();
     mStandardEffect.Terminate();
 }
 
-void RenderService::Update(float deltaTime)
-{
-    mFPS = 1.0f / deltaTime; // 
-}
-
 void RenderService::Render()
 {
-    const Graphics::Camera& camera = mCameraService->GetMain();
+    PROFILE_SCOPE("RenderService::Render");
+    const App& app = MainApp();
+    mFPS = 1.0f / app.GetFrameTime();
+
+    // Draw between the last two ticks, with a fixed simulation rate this keeps motion smooth at any frame rate.
+    // The live transforms are the latest tick's, a camera that became main since then is drawn where it is
+    const float alpha = app.GetInterpolationAlpha();
+    const Graphics::Camera& mainCamera = mCameraService->GetMain();
+    Graphics::Camera camera = mainCamera;
+    if (&mainCamera == mCapturedCamera)
+    {
+        camera.SetPosition(Math::Lerp(mPreviousCameraPosition, mainCamera.GetPosition(), alpha));
+        if (Math::Dot(mPreviousCameraDirection, mainCamera.GetDirection()) > 0.0f)
+        {
+            camera.SetDirection(Math::Normalize(Math::Lerp(mPreviousCameraDirection, mainCamera.GetDirection(), alpha)));
+        }
+    }
     mStandardEffect.SetCamera(camera);
     for (Entry& entry : mRenderEntries)
     {
-        entry.renderGroup.transform = *entry.transformComponent;
+        entry.renderGroup.transform = Graphics::Lerp(entry.previousTransform, entry.transformComponent->GetWorldTransform(), alpha);
     }
 
     mShadowEffect.Begin();
@@ -109,16 +124,20 @@ void RenderService::Register(const RenderObjectComponent* renderObjectComponent)
     if (iter == mRenderEntries.end())
     {
         const Graphics::Animator* animator = nullptr;
+        const Graphics::AnimationUtil::BoneTransforms* skinningTransforms = nullptr;
         const AnimatorComponent* animatorComponent = renderObjectComponent->GetOwner().GetComponent<AnimatorComponent>();
         if (animatorComponent != nullptr)
         {
             animator = &animatorComponent->GetAnimator();
+            skinningTransforms = &animatorComponent->GetSkinningTransforms();
         }
         Entry& entry = mRenderEntries.emplace_back();
         entry.renderComponent = renderObjectComponent;
         entry.transformComponent = renderObjectComponent->GetOwner().GetComponent<TransformComponent>();
         entry.renderGroup.Initialize(renderObjectComponent->GetModel(), animator);
         entry.renderGroup.modelId = renderObjectComponent->GetModelId();
+        entry.renderGroup.skinningTransforms = skinningTransforms;
+        entry.previousTransform = entry.transformComponent->GetWorldTransform();
     }
 }
 
@@ -138,3 +157,18 @@ void RenderService::Unregister(const RenderObjectComponent* renderObjectComponen
         mRenderEntries.erase(iter);
     }
 }
+
+void RenderService::CaptureSimulationState()
+{
+    // Runs before every tick, so after several catch up ticks in one frame this holds the state before the last one.
+    // World transforms are the ones cached by the GameWorld pass at the end of the previous tick
+    for (Entry& entry : mRenderEntries)
+    {
+        entry.previousTransform = entry.transformComponent->GetWorldTransform();
+    }
+
+    const Graphics::Camera& camera = mCameraService->GetMain();
+    mCapturedCamera = &camera;
+    mPreviousCameraPosition = camera.GetPosition();
+    mPreviousCameraDirection = camera.GetDirection();
+}
@@ -6,13 +6,31 @@
 using namespace IExeEngine;
 using namespace IExeEngine::Graphics;
 
+namespace
+{
+	bool IsSame(const Transform& a, const Transform& b)
+	{
+		return a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z &&
+			a.rotation.x == b.rotation.x && a.rotation.y == b.rotation.y && a.rotation.z == b.rotation.z && a.rotation.w == b.rotation.w &&
+			a.scale.x == b.scale.x && a.scale.y == b.scale.y && a.scale.z == b.scale.z;
+	}
+}
+
+void TransformComponent::Initialize()
+{
+	// Parents are initialized first, so the walk sees their final starting transforms
+	mCachedLocal = *this;
+	mWorldTransform = ComputeWorldTransform();
+	mWorldMatrix = mWorldTransform.GetMatrix4();
+}
+
 void TransformComponent::DebugUI()
 {
 	ImGui::DragFloat3("Position", &position.x, 0.1f);
 	ImGui::DragFloat4("Rotation", &rotation.x, 0.0001f);
 	ImGui::DragFloat3("Scale", &scale.x, 0.1f);
 
-	SimpleDraw::AddTransform(GetMatrix4());
+	SimpleDraw::AddTransform(GetWorldMatrix());
 }
 
 void TransformComponent::Deserialize(const rapidjson::Value& value)
@@ -22,23 +40,43 @@ void TransformComponent::Deserialize(const rapidjson::Value& value)
     SaveUtil::ReadVector3("Scale", scale, value);
 }
 
-Transform TransformComponent::GetWorldTransform() const
+const Transform& TransformComponent::GetWorldTransform() const
+{
+	return mWorldTransform;
+}
+
+const Math::Matrix4& TransformComponent::GetWorldMatrix() const
 {
+	return mWorldMatrix;
+}
+
+Transform TransformComponent::ComputeWorldTransform() const
+{
+	// Compose position/rotation/scale up the chain, no matrices are built or decomposed. Parents without a
+	// transform pass their parent's through, as in the GameWorld pass
 	Transform worldTransform = *this;
 	const GameObject* parent = GetOwner().GetParent();
-	if (parent != nullptr)
+	while (parent != nullptr)
 	{
-		Math::Matrix4 matWorld = GetMatrix4();
-		while (parent != nullptr)
+		const TransformComponent* transformComponent = parent->GetComponent<TransformComponent>();
+		if (transformComponent != nullptr)
 		{
-			const TransformComponent* transformComponent = parent->GetComponent<TransformComponent>();
-            ASSERT(transformComponent != nullptr, "TransformComponent: Parent doesn't have a transform component!");
-			matWorld = matWorld * transformComponent->GetMatrix4();
-			parent = parent->GetParent();
+			worldTransform = worldTransform * (*transformComponent);
 		}
-		worldTransform.position = Math::GetTranslation(matWorld);
-		worldTransform.rotation = Math::Quaternion::CreateFromRotationMatrix(matWorld);
-        worldTransform.scale = Math::GetScale(matWorld);
+		parent = parent->GetParent();
 	}
 	return worldTransform;
+}
+
+bool TransformComponent::UpdateWorldTransform(const Transform* parentWorld, bool parentChanged)
+{
+	if (!parentChanged && IsSame(*this, mCachedLocal))
+	{
+		return false;
+	}
+
+	mCachedLocal = *this;
+	mWorldTransform = (parentWorld != nullptr) ? (*this) * (*parentWorld) : mCachedLocal;
+	mWorldMatrix = mWorldTransform.GetMatrix4();
+	return true;
 }
\ No newline at end of file
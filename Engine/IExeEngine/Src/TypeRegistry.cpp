@@ -0,0 +1,85 @@
+#include "Precompiled.h"
+#include "TypeRegistry.h"
+
+using namespace IExeEngine;
+
+namespace
+{
+    // Built on first use, types register from static initializers in any order. Map nodes never move, so the info
+    // pointers handed out stay valid as more types register
+    struct Registry
+    {
+        std::unordered_map<uint32_t, ComponentInfo> components;
+        std::array<const ComponentInfo*, GameObject::MaxComponentTypes> componentsById = {};
+        std::unordered_map<uint32_t, ServiceInfo> services;
+    };
+
+    Registry& GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    template<class Info>
+    const Info* Find(const std::unordered_map<uint32_t, Info>& infos, uint32_t nameHash)
+    {
+        auto iter = infos.find(nameHash);
+        return (iter != infos.end()) ? &iter->second : nullptr;
+    }
+
+    template<class Info>
+    const Info* FindByName(const std::unordered_map<uint32_t, Info>& infos, std::string_view name)
+    {
+        const Info* info = Find(infos, TypeRegistry::HashName(name));
+        return (info != nullptr && name == info->name) ? info : nullptr;
+    }
+}
+
+bool TypeRegistry::Register(const ComponentInfo& info)
+{
+    // Left out entirely, a name lookup that finds it would make a component no object can hold
+    if (info.typeId >= GameObject::MaxComponentTypes)
+    {
+        ASSERT(false, "TypeRegistry: Component %s has an ID past MaxComponentTypes!", info.name);
+        return false;
+    }
+    Registry& registry = GetRegistry();
+    auto [iter, added] = registry.components.emplace(info.nameHash, info);
+    ASSERT(added || strcmp(iter->second.name, info.name) == 0, "TypeRegistry: %s and %s have the same name hash!", iter->second.name, info.name);
+    ASSERT(registry.componentsById[info.typeId] == nullptr || registry.componentsById[info.typeId] == &iter->second,
+        "TypeRegistry: %s and %s have the same type id!", registry.componentsById[info.typeId]->name, info.name);
+    registry.componentsById[info.typeId] = &iter->second;
+    return added;
+}
+
+bool TypeRegistry::Register(const ServiceInfo& info)
+{
+    auto [iter, added] = GetRegistry().services.emplace(info.nameHash, info);
+    ASSERT(added || strcmp(iter->second.name, info.name) == 0, "TypeRegistry: %s and %s have the same name hash!", iter->second.name, info.name);
+    return added;
+}
+
+const ComponentInfo* TypeRegistry::FindComponent(std::string_view name)
+{
+    return FindByName(GetRegistry().components, name);
+}
+
+const ComponentInfo* TypeRegistry::FindComponent(uint32_t nameHash)
+{
+    return Find(GetRegistry().components, nameHash);
+}
+
+const ComponentInfo* TypeRegistry::GetComponentInfo(uint32_t typeId)
+{
+    return (typeId < GameObject::MaxComponentTypes) ? GetRegistry().componentsById[typeId] : nullptr;
+}
+
+const ServiceInfo* TypeRegistry::FindService(std::string_view name)
+{
+    return FindByName(GetRegistry().services, name);
+}
+
+const ServiceInfo* TypeRegistry::FindService(uint32_t nameHash)
+{
+    return Find(GetRegistry().services, nameHash);
+}
\ No newline at end of file
@@ -66,25 +66,7 @@ void UIButtonComponent::Render()
 	{
 		buttonStateIndex = 0;
 	}
-	Math::Vector2 worldPosition = GetPosition(false);
-	GameObject* parent = GetOwner().GetParent();
-	while (parent != nullptr)
-	{
-		UISpriteComponent* spriteComponent = parent->GetComponent<UISpriteComponent>();
-		if (spriteComponent != nullptr)
-		{
-			worldPosition += spriteComponent->GetPosition();
-		}
-		else
-		{
-			UIButtonComponent* buttonComponent = parent->GetComponent<UIButtonComponent>();
-			if (buttonComponent != nullptr)
-			{
-				worldPosition += buttonComponent->GetPosition();
-			}
-		}
-		parent = parent->GetParent();
-	}
+	const Math::Vector2 worldPosition = GetPosition(false) + GetParentOffset();
 	mButtonStates[buttonStateIndex].sprite.SetPosition({ worldPosition.x, worldPosition.y });
 	UISpriteRenderer::Get()->Render(mButtonStates[buttonStateIndex].sprite);
 }
@@ -1,6 +1,9 @@
 #include "Precompiled.h"
 #include "UIRenderService.h"
 #include "UIComponent.h"
+#include "UIButtonComponent.h"
+#include "UISpriteComponent.h"
+#include "GameObject.h"
 
 using namespace IExeEngine;
 using namespace IExeEngine::Graphics;
@@ -12,6 +15,8 @@ void UIRenderService::Terminate()
 
 void UIRenderService::Render()
 {
+	PROFILE_SCOPE("UIRenderService::Render");
+	UpdateParentOffsets();
 	UISpriteRenderer::Get()->BeginRender();
 
 		for (UIComponent* uiComponent : mUIComponents)
@@ -22,6 +27,34 @@ void UIRenderService::Render()
 	UISpriteRenderer::Get()->EndRender();
 }
 
+void UIRenderService::UpdateParentOffsets()
+{
+	// Components register as they initialize, parents before children, so the nearest UI parent's offset is
+	// already this frame's when a child reads it and no walk goes further up than that parent
+	for (UIComponent* uiComponent : mUIComponents)
+	{
+		Math::Vector2 offset = Math::Vector2::Zero;
+		GameObject* parent = uiComponent->GetOwner().GetParent();
+		while (parent != nullptr)
+		{
+			UISpriteComponent* spriteComponent = parent->GetComponent<UISpriteComponent>();
+			if (spriteComponent != nullptr)
+			{
+				offset = spriteComponent->GetPosition() + spriteComponent->GetParentOffset();
+				break;
+			}
+			UIButtonComponent* buttonComponent = parent->GetComponent<UIButtonComponent>();
+			if (buttonComponent != nullptr)
+			{
+				offset = buttonComponent->GetPosition() + buttonComponent->GetParentOffset();
+				break;
+			}
+			parent = parent->GetParent();
+		}
+		uiComponent->mParentOffset = offset;
+	}
+}
+
 void UIRenderService::Register(UIComponent* uiComponent)
 {
 	auto iter = std::find(mUIComponents.begin(), mUIComponents.end(), uiComponent);
@@ -34,28 +34,9 @@ void UISpriteComponent::Terminate()
 void UISpriteComponent::Render()
 {
 	//UISpriteRenderer::Get()->Render(mUISprite);
-	Math::Vector2 worldPos = GetPosition(false);
-	GameObject* parent = GetOwner().GetParent();
-	while (parent != nullptr)
-	{
-		UISpriteComponent* spriteComponent = parent->GetComponent<UISpriteComponent>();
-		if (spriteComponent != nullptr)
-		{
-			worldPos += spriteComponent->GetPosition();
-		}
-		else
-		{
-			UIButtonComponent* buttonComponent = parent->GetComponent<UIButtonComponent>();
-			if (buttonComponent != nullptr)
-			{
-				// We need to add the buttons position too as the button component is what is actually rendering the sprite,
-				// so the sprite component's position is relative to the button component, not the other way around
-				worldPos += buttonComponent->GetPosition();
-			}
-		}
-
-		parent = parent->GetParent();
-	}
+	// A parent button's position is part of the offset too, as the button component is what is actually rendering
+	// the sprite, so the sprite component's position is relative to the button component, not the other way around
+	const Math::Vector2 worldPos = GetPosition(false) + GetParentOffset();
 
     mUISprite.SetPosition({ worldPos.x, worldPos.y });
     UISpriteRenderer::Get()->Render(mUISprite);
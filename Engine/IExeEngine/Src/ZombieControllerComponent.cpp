@@ -146,7 +146,7 @@ void ZombieControllerComponent::TransitionToState(ZombieState newState)
     {
         if (mAnimatorComponent != nullptr)
         {
-            mAnimatorComponent->Play(mIdleAnimIndex, /*looping=*/true);
+            mAnimatorComponent->CrossFade(mIdleAnimIndex, /*looping=*/true, mBlendTime);
         }
         if (mSoundBankComponent != nullptr)
         {
@@ -161,7 +161,7 @@ void ZombieControllerComponent::TransitionToState(ZombieState newState)
     {
         if (mAnimatorComponent != nullptr)
         {
-            mAnimatorComponent->Play(mWalkAnimIndex, /*looping=*/true);
+            mAnimatorComponent->CrossFade(mWalkAnimIndex, /*looping=*/true, mBlendTime);
         }
         if (mSoundBankComponent != nullptr)
         {
@@ -179,7 +179,7 @@ void ZombieControllerComponent::TransitionToState(ZombieState newState)
 
         if (mAnimatorComponent != nullptr)
         {
-            mAnimatorComponent->Play(mAttackAnimIndex, /*looping=*/false);
+            mAnimatorComponent->CrossFade(mAttackAnimIndex, /*looping=*/false, mBlendTime);
         }
 
         if (mSoundBankComponent != nullptr)
@@ -248,6 +248,7 @@ void ZombieControllerComponent::DebugUI()
         ImGui::DragInt("Idle Anim", &mIdleAnimIndex, 1, 0, 20);
         ImGui::DragInt("Walk Anim", &mWalkAnimIndex, 1, 0, 20);
         ImGui::DragInt("Attack Anim", &mAttackAnimIndex, 1, 0, 20);
+        ImGui::DragFloat("BlendTime", &mBlendTime, 0.01f, 0.0f, 1.0f);
         ImGui::Separator();
 
         // Manual trigger for testing attack without spacebar
@@ -272,4 +273,5 @@ void ZombieControllerComponent::Deserialize(const rapidjson::Value& value)
     SaveUtil::ReadInt("IdleAnimIndex", mIdleAnimIndex, value);
     SaveUtil::ReadInt("WalkAnimIndex", mWalkAnimIndex, value);
     SaveUtil::ReadInt("AttackAnimIndex", mAttackAnimIndex, value);
+    SaveUtil::ReadFloat("BlendTime", mBlendTime, value);
 }
\ No newline at end of file
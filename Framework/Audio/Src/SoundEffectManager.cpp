@@ -45,6 +45,7 @@ void SoundEffectManager::SetRootPath(const std::filesystem::path& root)
 
 SoundId SoundEffectManager::Load(const std::filesystem::path& fileName)
 {
+    MEMORY_TAG(Audio);
     std::filesystem::path fullPath = mRoot / fileName;
     std::size_t soundId = std::filesystem::hash_value(fullPath);
     auto [iter, success] = mInventory.insert({ soundId, nullptr });
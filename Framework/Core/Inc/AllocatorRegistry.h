@@ -0,0 +1,39 @@
+#pragma once
+
+namespace IExeEngine::Core
+{
+    // A pool's numbers at the time it was asked, in blocks of blockSize bytes (byte pools use a block size of 1)
+    struct AllocatorStats
+    {
+        std::string name;
+        std::size_t blockSize = 0;
+        std::size_t blocksLive = 0;
+        std::size_t blocksPeak = 0;
+        // Blocks backed by memory, live or free
+        std::size_t blocksReserved = 0;
+        std::size_t pageCount = 0;
+        // Pages with nothing live on them that a Trim would give back
+        std::size_t emptyPageCount = 0;
+        // Share of the reserved blocks that are free but can't be given back because they share a page with
+        // live blocks, 0 when memory is either in use or returnable
+        float fragmentation = 0.0f;
+    };
+
+    // Every allocator adds itself when it is constructed and leaves when destroyed, so tools can list all of
+    // them without knowing where they live. Adding and removing allocators is thread safe, but the pools aren't
+    // locked while their stats are read: a BlockAllocator walks its pages, so GetStats and Dump belong on the
+    // thread that uses those pools, the main thread for the engine's
+    class AllocatorRegistry final
+    {
+    public:
+        using StatsQuery = std::function<void(AllocatorStats&)>;
+
+        static void Register(const void* allocator, StatsQuery query);
+        static void Unregister(const void* allocator);
+
+        static void GetStats(std::vector<AllocatorStats>& stats);
+
+        // One line per allocator, for a log or a console
+        static std::string Dump();
+    };
+}
\ No newline at end of file
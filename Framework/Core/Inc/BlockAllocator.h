@@ -2,10 +2,20 @@
 
 namespace IExeEngine::Core
 {
+    struct AllocatorStats;
+
+    // Hands out fixed size blocks from pages of memory. A fixed pool is one page of capacity blocks made up front,
+    // a paged pool starts empty and adds a page at a time as it fills, up to capacity blocks. Blocks never move,
+    // so pointers stay valid while the pool grows. Not thread safe, see ConcurrentBlockAllocator
     class BlockAllocator
     {
     public:
-        BlockAllocator(const char* name, std::size_t blockSize, std::size_t capacity);
+        // No limit on the number of blocks a paged pool can grow to
+        static constexpr std::size_t Unbounded = SIZE_MAX;
+
+        // Leave blocksPerPage at 0 for a fixed pool. Pages of a paged pool are rounded up to the OS allocation
+        // granularity so they may hold more blocks than asked for
+        BlockAllocator(const char* name, std::size_t blockSize, std::size_t capacity, std::size_t blocksPerPage = 0);
         virtual ~BlockAllocator();
 
         BlockAllocator(const BlockAllocator&) = delete;
@@ -17,15 +27,47 @@ namespace IExeEngine::Core
 
         void Free(void* ptr);
 
+        // Gives pages without live blocks back to the OS and returns how many bytes that was, fixed pools keep theirs
+        std::size_t Trim();
+
+        // Walks the pages, only safe on the thread that allocates from the pool like everything else here
+        void GetStats(AllocatorStats& stats) const;
+
     private:
+        struct Page
+        {
+            uint8_t* data = nullptr;
+            std::vector<void*> freeBlocks;
+            uint32_t blockCount = 0;
+            uint32_t blocksLive = 0;
+        };
+
+        static constexpr uint32_t InvalidPage = UINT32_MAX;
+
+        bool AddPage();
+        void ReleasePage(uint32_t pageIndex);
+        bool IsInPage(uint32_t pageIndex, uintptr_t address) const;
+        uint32_t FindPage(const void* ptr);
+
         std::string mName;
-        std::vector<void*> mFreeBlocks;
+        std::vector<Page> mPages;
+        // Slots in mPages whose page was trimmed, reused before the vector grows
+        std::vector<uint32_t> mUnusedPages;
+        // Pages that still have free blocks, the last one is allocated from
+        std::vector<uint32_t> mPagesWithFreeBlocks;
+        // Page index for every allocation granule a page covers, a block's page is found with one lookup
+        std::unordered_map<uintptr_t, uint32_t> mPageLookup;
+        // Frees tend to come in runs from the same page, checked before the lookup
+        uint32_t mLastFreedPage = InvalidPage;
 
-        void* mData = nullptr;
+        bool mPaged = false;
+        std::size_t mBlocksPerPage = 0;
+        std::size_t mPageSize = 0;
 
         // Data tracker variables
         std::size_t mBlockSize = 0;
         std::size_t mCapacity = 0;
+        std::size_t mBlocksReserved = 0;
         std::size_t mBlocksAllocatedCurrent = 0;
         std::size_t mBlocksAllocatedTotal = 0;
         std::size_t mBlocksFreed = 0;
@@ -0,0 +1,84 @@
+#pragma once
+
+namespace IExeEngine::Core
+{
+    struct AllocatorStats;
+
+    // Thread safe BlockAllocator for job threads. Free blocks form a lock-free intrusive list (the index of the
+    // next free block is stored in the block itself) and every thread keeps a small magazine of blocks, so most
+    // Allocate/Free calls never touch the shared list.
+    // Blocks cached in another thread's magazine can't be handed out, leave up to MagazineSize blocks of slack per thread.
+    // An exiting thread hands its magazines back and frees its slot, threads past MaxThreads alive at once go straight
+    // to the shared list
+    class ConcurrentBlockAllocator
+    {
+    public:
+        static constexpr std::size_t MaxThreads = 64;
+        static constexpr uint32_t MagazineSize = 32;
+
+        ConcurrentBlockAllocator(const char* name, std::size_t blockSize, std::size_t capacity);
+        virtual ~ConcurrentBlockAllocator();
+
+        ConcurrentBlockAllocator(const ConcurrentBlockAllocator&) = delete;
+        ConcurrentBlockAllocator(const ConcurrentBlockAllocator&&) = delete;
+        ConcurrentBlockAllocator& operator=(const ConcurrentBlockAllocator&) = delete;
+        ConcurrentBlockAllocator& operator=(const ConcurrentBlockAllocator&&) = delete;
+
+        void* Allocate();
+
+        void Free(void* ptr);
+
+        std::size_t GetBlocksAllocated() const;
+
+        void GetStats(AllocatorStats& stats) const;
+
+    private:
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+        // Only ever written by the thread that owns it, padded so neighbours don't share a cache line.
+        // The counters are atomics so any thread can read the stats, the owner updates them without a locked add
+        struct alignas(64) Magazine
+        {
+            uint32_t blocks[MagazineSize];
+            uint32_t count = 0;
+            std::atomic<std::size_t> blocksAllocated{ 0 };
+            std::atomic<std::size_t> blocksFreed{ 0 };
+        };
+
+        // Numbers the calling thread for the lifetime of the thread, defined in the .cpp
+        struct ThreadSlot;
+
+        Magazine* GetMagazine() const;
+        // Returns every block in the magazine to the shared list, only called once its thread has exited
+        void FlushMagazine(Magazine& magazine);
+        std::atomic<uint32_t>& GetNextLink(uint32_t index) const;
+
+        // Pushes the chain first -> ... -> last, the links inside the chain must already be set
+        void PushFree(uint32_t first, uint32_t last);
+        uint32_t PopFree();
+
+        // Counts blocks leaving (positive) or returning to (negative) the shared list
+        void TrackTaken(std::ptrdiff_t count);
+        std::size_t GetBlocksAllocatedTotal() const;
+        std::size_t GetBlocksFreed() const;
+
+        std::string mName;
+        std::unique_ptr<Magazine[]> mMagazines;
+
+        void* mData = nullptr;
+
+        // Head of the shared free list, the low 32 bits are the block index and the high 32 bits a tag
+        // bumped on every change so a block popped and pushed back between a load and a CAS is detected
+        alignas(64) std::atomic<uint64_t> mFreeHead{ 0 };
+
+        // Data tracker variables, all relaxed. Allocated/freed counts live in the magazines (plus these two for
+        // threads without one), the highest count includes blocks sitting in magazines since it is tracked
+        // where blocks leave the shared list
+        std::size_t mBlockSize = 0;
+        std::size_t mCapacity = 0;
+        std::atomic<std::size_t> mBlocksAllocatedShared{ 0 };
+        std::atomic<std::size_t> mBlocksFreedShared{ 0 };
+        std::atomic<std::size_t> mBlocksTaken{ 0 };
+        std::atomic<std::size_t> mBlocksHighest{ 0 };
+    };
+}
\ No newline at end of file
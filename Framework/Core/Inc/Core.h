@@ -3,10 +3,18 @@
 #include "Common.h"
 
 #include "DebugUtil.h"
+#include "Logger.h"
 #include "TimeUtil.h"
+#include "Profiler.h"
 #include "Window.h"
 #include "WindowMessageHandler.h"
 #include "Event.h"
 #include "EventManager.h"
+#include "MemoryTracker.h"
+#include "AllocatorRegistry.h"
 #include "BlockAllocator.h"
-#include "TypedAllocator.h"
\ No newline at end of file
+#include "ConcurrentBlockAllocator.h"
+#include "TypedAllocator.h"
+#include "JobSystem.h"
+#include "FrameAllocator.h"
+#include "MappedFile.h"
\ No newline at end of file
@@ -1,27 +1,65 @@
 #pragma once
 
+#include "Logger.h"
 #include "TimeUtil.h"
 
 using namespace IExeEngine;
 using namespace IExeEngine::Core;
 
+#if !defined(IEXE_LOG_MIN_LEVEL)
 #if defined(_DEBUG)
-#define LOG(format, ...);\
+#define IEXE_LOG_MIN_LEVEL 0
+#else
+#define IEXE_LOG_MIN_LEVEL 4
+#endif
+#endif
+
+// IEXE_LOG_MIN_LEVEL is the lowest LogLevel compiled in, 0 keeps everything and 4 strips every LOG
+#define IEXE_LOG(level, category, format, ...)\
 	do{\
-		char _buffer[256];\
-		int _res = snprintf(_buffer, std::size(_buffer), "{%.3f}: "##format##"\n", TimeUtil::GetTime(), __VA_ARGS__);\
-		OutputDebugStringA(_buffer);\
+		if (IExeEngine::Core::Logger::IsEnabled(IExeEngine::Core::LogLevel::level, IExeEngine::Core::LogCategory::category))\
+		{\
+			IExeEngine::Core::Logger::Write(IExeEngine::Core::LogLevel::level, IExeEngine::Core::LogCategory::category, format, __VA_ARGS__);\
+		}\
 	} while(false)
 
+#if IEXE_LOG_MIN_LEVEL <= 0
+#define LOG_VERBOSE(category, format, ...) IEXE_LOG(Verbose, category, format, __VA_ARGS__)
+#else
+#define LOG_VERBOSE(category, format, ...)
+#endif
+
+#if IEXE_LOG_MIN_LEVEL <= 1
+#define LOG_INFO(category, format, ...) IEXE_LOG(Info, category, format, __VA_ARGS__)
+#define LOG(format, ...) IEXE_LOG(Info, General, format, __VA_ARGS__)
+#else
+#define LOG_INFO(category, format, ...)
+#define LOG(format, ...)
+#endif
+
+#if IEXE_LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(category, format, ...) IEXE_LOG(Warning, category, format, __VA_ARGS__)
+#else
+#define LOG_WARNING(category, format, ...)
+#endif
+
+#if IEXE_LOG_MIN_LEVEL <= 3
+#define LOG_ERROR(category, format, ...) IEXE_LOG(Error, category, format, __VA_ARGS__)
+#else
+#define LOG_ERROR(category, format, ...)
+#endif
+
+#if defined(_DEBUG)
+// Flushed before breaking so the message is in the output window when the debugger stops
 #define ASSERT(condition, format, ...)\
 	do{\
 		if(!(condition))\
 		{\
-			LOG("ASSERT! %s(%d)\n"##format##, __FILE__, __LINE__, __VA_ARGS__);\
+			IExeEngine::Core::Logger::Write(IExeEngine::Core::LogLevel::Error, IExeEngine::Core::LogCategory::General, "ASSERT! %s(%d)\n" format, __FILE__, __LINE__, __VA_ARGS__);\
+			IExeEngine::Core::Logger::Flush();\
 			DebugBreak();\
 		}\
 	} while(false)
 #else
-#define LOG(format, ...)
 #define ASSERT(condition, format, ...) do{ (void) sizeof(condition); } while(false)
 #endif
\ No newline at end of file
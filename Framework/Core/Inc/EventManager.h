@@ -7,6 +7,9 @@ namespace IExeEngine::Core
     using EventListenerId = std::size_t;
     using EventCallback = std::function<void(const Event&)>;
 
+    // Listeners, Broadcast and DispatchQueued belong to the main thread, Post can be called from any thread.
+    // Listeners may be added or removed from inside a callback: a removed listener is skipped from then on and
+    // an added one first hears the next event of its type
     class EventManager final
     {
     public:
@@ -15,6 +18,13 @@ namespace IExeEngine::Core
         static EventManager* Get();
         static void Broadcast(const Event& e);
 
+        // Copies the event into its type's queue to be sent on the next DispatchQueued
+        template<class EventType>
+        static void Post(const EventType& e)
+        {
+            Get()->PostPrivate(e);
+        }
+
         EventManager() = default;
         ~EventManager();
 
@@ -24,11 +34,80 @@ namespace IExeEngine::Core
         EventListenerId AddListener(EventTypeId eventId, const EventCallback& cb);
         void RemoveListener(EventTypeId eventId, EventListenerId listenerId);
 
+        // Sends everything posted so far, one event type at a time and in posting order within a type.
+        // Events posted by the callbacks wait for the next call
+        void DispatchQueued();
+
     private:
+        class QueueBase
+        {
+        public:
+            virtual ~QueueBase() = default;
+            // Moves the posted events aside and returns whether there were any, called with mPostMutex held
+            virtual bool Swap() = 0;
+            virtual void Dispatch(EventManager& eventManager) = 0;
+        };
+
+        template<class EventType>
+        class Queue final : public QueueBase
+        {
+        public:
+            std::vector<EventType> posted;
+            std::vector<EventType> dispatching;
+
+            bool Swap() override
+            {
+                std::swap(posted, dispatching);
+                return !dispatching.empty();
+            }
+
+            void Dispatch(EventManager& eventManager) override
+            {
+                eventManager.DispatchBatch(EventType::StaticGetTypeId(), dispatching.data(), dispatching.size(), sizeof(EventType));
+                dispatching.clear();
+            }
+        };
+
+        struct Listener
+        {
+            EventListenerId id = 0;
+            EventCallback callback;
+            bool removed = false;
+        };
+
+        // Listeners stay sorted by id, those added during a dispatch wait in addedListeners until it ends
+        struct Channel
+        {
+            std::vector<Listener> listeners;
+            std::vector<Listener> addedListeners;
+            uint32_t dispatchDepth = 0;
+            bool hasRemovedListeners = false;
+        };
+
+        template<class EventType>
+        void PostPrivate(const EventType& e)
+        {
+            static_assert(std::is_base_of_v<Event, EventType>, "EventManager: Post needs an Event type");
+
+            std::lock_guard<std::mutex> lock(mPostMutex);
+            std::unique_ptr<QueueBase>& queue = mQueues[EventType::StaticGetTypeId()];
+            if (queue == nullptr)
+            {
+                queue = std::make_unique<Queue<EventType>>();
+            }
+            static_cast<Queue<EventType>*>(queue.get())->posted.push_back(e);
+        }
+
         void BroadcastPrivate(const Event& e);
+        void DispatchBatch(EventTypeId eventId, const Event* events, std::size_t count, std::size_t stride);
+        void ApplyListenerChanges(Channel& channel);
 
-        using EventListeners = std::unordered_map<EventTypeId, std::unordered_map<EventListenerId, EventCallback>>;
-        EventListeners mEventListeners;
+        std::unordered_map<EventTypeId, Channel> mChannels;
         EventListenerId mNextListenerId = 0;
+
+        std::mutex mPostMutex;
+        std::unordered_map<EventTypeId, std::unique_ptr<QueueBase>> mQueues;
+        std::vector<QueueBase*> mDispatchQueues;
+        bool mDispatchingQueued = false;
     };
 }
\ No newline at end of file
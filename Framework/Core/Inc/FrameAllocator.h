@@ -0,0 +1,135 @@
+#pragma once
+
+namespace IExeEngine::Core
+{
+    // Bump allocator for data that only lives for the frame it was made in. Allocate moves an offset forward and
+    // nothing is freed on its own, BeginFrame rewinds the oldest of FrameCount buffers and makes it current, so
+    // memory from this frame is still valid through the next one. Allocate is thread safe, BeginFrame is not.
+    // A full buffer falls back to the heap, those blocks are released when the buffer is rewound
+    class FrameAllocator final
+    {
+    public:
+        static constexpr uint32_t FrameCount = 2;
+        static constexpr std::size_t DefaultCapacity = 4 * 1024 * 1024;
+        // Written over a buffer's old contents when it is rewound with poisoning on
+        static constexpr uint8_t PoisonByte = 0xDD;
+
+        static void StaticInitialize(std::size_t capacity = DefaultCapacity);
+        static void StaticTerminate();
+        static FrameAllocator* Get();
+
+        FrameAllocator() = default;
+        ~FrameAllocator();
+
+        FrameAllocator(const FrameAllocator&) = delete;
+        FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+        // capacity is per buffer
+        void Initialize(std::size_t capacity);
+        void Terminate();
+
+        void BeginFrame();
+
+        // Null only when the buffer is full and the heap fallback fails too
+        void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        template<class T>
+        T* Allocate(std::size_t count)
+        {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // Gives back everything allocated while it is alive when it goes out of scope, so a loop that needs
+        // scratch memory per iteration keeps reusing the same cache hot bytes instead of walking the buffer.
+        // Only for code that is the sole user of the allocator at the time (e.g. rendering), memory a job
+        // allocated from another thread inside the scope would be handed out again
+        class Scope
+        {
+        public:
+            Scope();
+            explicit Scope(FrameAllocator& allocator);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            FrameAllocator& mAllocator;
+            uint32_t mBuffer = 0;
+            std::size_t mMarker = 0;
+        };
+
+        // On by default in debug builds, also covers memory given back by a Scope
+        void SetPoisonOnReset(bool poison);
+
+        std::size_t GetCapacity() const;
+        // Most bytes in use at once so far this frame, heap fallbacks included
+        std::size_t GetBytesUsed() const;
+        std::size_t GetLastFrameBytesUsed() const;
+        // Most bytes a single frame has used since Initialize, anything above the capacity went to the heap
+        std::size_t GetHighWaterMark() const;
+        std::size_t GetOverflowCount() const;
+
+    private:
+        struct Buffer
+        {
+            uint8_t* data = nullptr;
+            std::atomic<std::size_t> offset{ 0 };
+            // Highest offset before a Scope rewound it
+            std::size_t peakOffset = 0;
+
+            // Heap fallbacks once data is full
+            std::mutex overflowMutex;
+            std::vector<void*> overflowBlocks;
+            std::atomic<std::size_t> overflowBytes{ 0 };
+        };
+
+        void* AllocateOverflow(Buffer& buffer, std::size_t size, std::size_t alignment);
+        void Reset(Buffer& buffer);
+        void Rewind(Buffer& buffer, std::size_t marker);
+
+        std::array<Buffer, FrameCount> mBuffers;
+        uint32_t mCurrentBuffer = 0;
+        std::size_t mCapacity = 0;
+        bool mPoisonOnReset = false;
+
+        // Data tracker variables
+        std::size_t mLastFrameBytesUsed = 0;
+        std::size_t mHighWaterMark = 0;
+        std::atomic<std::size_t> mOverflowCount{ 0 };
+    };
+
+    // Lets the std containers take their memory from the FrameAllocator, deallocate does nothing.
+    // A container has to be done with its memory before its buffer is rewound, reserve up front so a growing
+    // container doesn't leave its old copies behind in the buffer
+    template<class T>
+    class FrameStlAllocator
+    {
+    public:
+        using value_type = T;
+
+        FrameStlAllocator() noexcept = default;
+        template<class U>
+        FrameStlAllocator(const FrameStlAllocator<U>&) noexcept {}
+
+        T* allocate(std::size_t count)
+        {
+            T* data = FrameAllocator::Get()->Allocate<T>(count);
+            if (data == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return data;
+        }
+
+        void deallocate(T*, std::size_t) noexcept {}
+
+        template<class U>
+        bool operator==(const FrameStlAllocator<U>&) const noexcept { return true; }
+        template<class U>
+        bool operator!=(const FrameStlAllocator<U>&) const noexcept { return false; }
+    };
+
+    template<class T>
+    using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+}
\ No newline at end of file
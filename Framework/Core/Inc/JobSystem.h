@@ -0,0 +1,97 @@
+#pragma once
+
+#include "TypedAllocator.h"
+
+namespace IExeEngine::Core
+{
+    using JobFunction = std::function<void()>;
+    using ParallelForFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+    // Counts the jobs started with it that haven't finished, JobSystem::Wait returns once it is back to zero.
+    // Must outlive its jobs, waiting on it before it goes out of scope is enough
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        ~JobCounter();
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const;
+
+    private:
+        friend class JobSystem;
+
+        struct Continuation
+        {
+            JobFunction function;
+            JobCounter* counter = nullptr;
+        };
+
+        std::atomic<uint32_t> mPending{ 0 };
+        // Guards the last decrement and the jobs waiting on this counter through RunAfter
+        mutable std::mutex mMutex;
+        std::vector<Continuation> mContinuations;
+    };
+
+    // Worker threads with one work-stealing queue each. A thread pushes and pops its own queue at the bottom
+    // (newest first, still hot in cache) while idle threads steal the oldest jobs from the top of the others.
+    // The thread that called Initialize owns queue 0 and works through jobs whenever it waits
+    class JobSystem final
+    {
+    public:
+        // 0 workers uses one per hardware thread minus the calling thread
+        static void StaticInitialize(uint32_t workerCount = 0);
+        static void StaticTerminate();
+        static JobSystem* Get();
+
+        JobSystem();
+        ~JobSystem();
+
+        void Initialize(uint32_t workerCount);
+        void Terminate();
+
+        // counter is optional, it is incremented now and decremented once function returns
+        void Run(JobFunction function, JobCounter* counter = nullptr);
+        // Holds function back until dependency is done
+        void RunAfter(JobCounter& dependency, JobFunction function, JobCounter* counter = nullptr);
+        // Calls function(begin, end) over [0, count) in batches of batchSize and returns once they all finished
+        void ParallelFor(uint32_t count, uint32_t batchSize, const ParallelForFunction& function);
+
+        // Runs queued jobs on the calling thread until counter is done
+        void Wait(const JobCounter& counter);
+
+        uint32_t GetWorkerCount() const;
+
+    private:
+        struct Job
+        {
+            JobFunction function;
+            JobCounter* counter = nullptr;
+        };
+        class WorkQueue;
+
+        void Submit(JobFunction function, JobCounter* counter);
+        Job* FindJob(int queueIndex);
+        void Execute(Job* job);
+        void Finish(JobCounter* counter);
+        void WorkerLoop(int queueIndex);
+
+        // Queue 0 belongs to the thread that called Initialize, 1..N to the workers
+        std::vector<std::unique_ptr<WorkQueue>> mQueues;
+        std::vector<std::thread> mWorkers;
+        std::unique_ptr<TypedAllocator<Job, ConcurrentBlockAllocator>> mJobPool;
+
+        // Jobs from threads without a queue of their own, or overflow from a full queue
+        std::mutex mSharedMutex;
+        std::deque<Job*> mSharedJobs;
+        std::atomic<uint32_t> mSharedJobCount{ 0 };
+
+        std::mutex mSleepMutex;
+        std::condition_variable mWakeUp;
+        std::atomic<uint32_t> mQueuedJobs{ 0 };
+        std::atomic<uint32_t> mSleepingWorkers{ 0 };
+        std::atomic<bool> mQuit{ false };
+    };
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#pragma once
+
+namespace IExeEngine::Core
+{
+    enum class LogLevel : uint8_t
+    {
+        Verbose,
+        Info,
+        Warning,
+        Error,
+        Off
+    };
+
+    enum class LogCategory : uint8_t
+    {
+        General,
+        Core,
+        Graphics,
+        Physics,
+        Audio,
+        Input,
+        Engine,
+        Count
+    };
+
+    const char* GetLogLevelName(LogLevel level);
+    const char* GetLogCategoryName(LogCategory category);
+
+    namespace LogDetail
+    {
+        constexpr std::size_t PayloadCapacity = 216;
+
+        using FormatFunc = int(*)(char* buffer, std::size_t size, const char* format, const std::byte* payload);
+
+        // A message as it travels from the logging thread to the logger thread, the arguments are packed
+        // into payload and only turned into text by formatFunc on the other side
+        struct Record
+        {
+            uint64_t timestamp = 0;
+            const char* format = nullptr;
+            FormatFunc formatFunc = nullptr;
+            LogLevel level = LogLevel::Info;
+            LogCategory category = LogCategory::General;
+            std::byte payload[PayloadCapacity];
+        };
+
+        template<class T>
+        constexpr bool IsString = std::is_same_v<T, const char*>;
+
+        // Strings always need their length and terminator, their characters get whatever room is left
+        template<class T>
+        constexpr std::size_t FixedSize = IsString<T> ? sizeof(uint16_t) + 1 : sizeof(T);
+
+        template<class T>
+        using StoredType = std::conditional_t<std::is_same_v<T, char*>, const char*, T>;
+
+        template<class T>
+        void EncodeArg(std::byte*& cursor, const std::byte* end, std::size_t reserved, T value)
+        {
+            if constexpr (IsString<T>)
+            {
+                // Copied, the string is usually a c_str() that is gone by the time the logger thread formats it
+                const char* text = (value != nullptr) ? value : "(null)";
+                const std::size_t available = static_cast<std::size_t>(end - cursor) - reserved - sizeof(uint16_t) - 1;
+                const uint16_t length = static_cast<uint16_t>(strnlen(text, available));
+                memcpy(cursor, &length, sizeof(length));
+                memcpy(cursor + sizeof(length), text, length);
+                cursor[sizeof(length) + length] = std::byte{ 0 };
+                cursor += sizeof(length) + length + 1;
+            }
+            else
+            {
+                memcpy(cursor, &value, sizeof(T));
+                cursor += sizeof(T);
+            }
+        }
+
+        template<class T>
+        T DecodeArg(const std::byte*& cursor)
+        {
+            if constexpr (IsString<T>)
+            {
+                uint16_t length = 0;
+                memcpy(&length, cursor, sizeof(length));
+                const char* text = reinterpret_cast<const char*>(cursor + sizeof(length));
+                cursor += sizeof(length) + length + 1;
+                return text;
+            }
+            else
+            {
+                T value;
+                memcpy(&value, cursor, sizeof(T));
+                cursor += sizeof(T);
+                return value;
+            }
+        }
+
+        template<class... Args>
+        int Format(char* buffer, std::size_t size, const char* format, const std::byte* payload)
+        {
+            const std::byte* cursor = payload;
+            // Braced initialization decodes the arguments left to right
+            const std::tuple<Args...> values{ DecodeArg<Args>(cursor)... };
+            return std::apply([&](auto... args) { return snprintf(buffer, size, format, args...); }, values);
+        }
+
+        template<class... Args>
+        void Encode(Record& record, const char* format, Args... args)
+        {
+            static_assert(((std::is_arithmetic_v<Args> || std::is_enum_v<Args> || std::is_pointer_v<Args>) && ...),
+                "Logger: only numbers, enums and pointers can be logged, pass strings as c_str()");
+            static_assert(((!std::is_same_v<Args, const wchar_t*> && !std::is_same_v<Args, wchar_t*>) && ...),
+                "Logger: wide strings are not supported, convert them first");
+            static_assert((FixedSize<Args> + ... + 0) <= PayloadCapacity, "Logger: too many arguments");
+
+            record.format = format;
+            record.formatFunc = &Format<Args...>;
+            std::byte* cursor = record.payload;
+            std::size_t reserved = (FixedSize<Args> + ... + 0);
+            (EncodeArg(cursor, record.payload + PayloadCapacity, reserved -= FixedSize<Args>, args), ...);
+        }
+    }
+
+    // Logging front end that only copies the format pointer and arguments into a lock free queue, the text is
+    // formatted and written to the sinks by a background thread. Write works from any thread, and before
+    // StaticInitialize or after StaticTerminate it formats and writes to the debugger on the calling thread.
+    // A full queue makes the writer wait for room rather than lose messages
+    class Logger final
+    {
+    public:
+        struct Settings
+        {
+            bool debuggerOutput = true;
+            bool consoleOutput = false;
+            // Also written to this file when set
+            std::filesystem::path filePath;
+        };
+
+        static constexpr uint32_t QueueCapacity = 4096;
+        // Longer messages are cut off
+        static constexpr std::size_t MaxLineLength = 1024;
+
+        static void StaticInitialize(const Settings& settings);
+        static void StaticTerminate();
+        static Logger* Get();
+
+        template<class... Args>
+        static void Write(LogLevel level, LogCategory category, const char* format, Args... args)
+        {
+            LogDetail::Record record;
+            record.level = level;
+            record.category = category;
+            LogDetail::Encode<LogDetail::StoredType<Args>...>(record, format, args...);
+            Submit(record);
+        }
+
+        // Per category threshold, messages below it are dropped before their arguments are even evaluated.
+        // Everything starts at Info
+        static bool IsEnabled(LogLevel level, LogCategory category);
+        static void SetLevel(LogCategory category, LogLevel level);
+        static LogLevel GetLevel(LogCategory category);
+
+        // Blocks until everything logged so far has reached the sinks
+        static void Flush();
+
+        explicit Logger(const Settings& settings);
+        ~Logger();
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        // Times a writer found the queue full and had to wait
+        uint64_t GetStallCount() const;
+
+    private:
+        struct Slot;
+
+        static void Submit(LogDetail::Record& record);
+
+        void Push(const LogDetail::Record& record);
+        // Logger thread only, whether the next record is ready to write
+        bool HasQueued() const;
+        uint32_t WriteQueued();
+        void WriteLine(const char* line);
+        void Run();
+
+        Settings mSettings;
+        FILE* mFile = nullptr;
+
+        std::unique_ptr<Slot[]> mSlots;
+        alignas(64) std::atomic<uint64_t> mEnqueuePos{ 0 };
+        alignas(64) std::atomic<uint64_t> mWrittenPos{ 0 };
+        uint64_t mReadPos = 0;
+        std::atomic<uint64_t> mStallCount{ 0 };
+
+        std::thread mThread;
+        std::mutex mWakeMutex;
+        std::condition_variable mWakeCondition;
+        std::atomic<bool> mStopping{ false };
+        // Set while the logger thread waits on mWakeCondition, so Push only notifies when there is someone to wake
+        std::atomic<bool> mSleeping{ false };
+    };
+}
\ No newline at end of file
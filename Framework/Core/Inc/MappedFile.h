@@ -0,0 +1,30 @@
+#pragma once
+
+namespace IExeEngine::Core
+{
+    // Read only view of a file mapped into memory, the view stays valid until Close is called
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(const MappedFile&&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&&) = delete;
+
+        bool Open(const std::filesystem::path& filePath);
+        void Close();
+
+        bool IsOpen() const;
+        const uint8_t* GetData() const;
+        std::size_t GetSize() const;
+
+    private:
+        HANDLE mFile = INVALID_HANDLE_VALUE;
+        HANDLE mMapping = nullptr;
+        const uint8_t* mData = nullptr;
+        std::size_t mSize = 0;
+    };
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+namespace IExeEngine::Core
+{
+    // Who an allocation is charged to, set for a block of code with MEMORY_TAG
+    enum class MemoryTag : uint8_t
+    {
+        Untagged,
+        Models,
+        Animation,
+        Textures,
+        Audio,
+        Physics,
+        Components,
+        Count
+    };
+
+    const char* GetMemoryTagName(MemoryTag tag);
+
+    // Global operator new/delete are replaced so every heap allocation is counted against the MemoryTag active on
+    // the allocating thread, and a free is taken off the tag it was allocated under. Each allocation carries a
+    // 16 byte header for that. Libraries with their own allocator hooks (Bullet) are routed through Allocate/Free.
+    // Building with IEXE_DISABLE_MEMORY_TRACKING leaves the default operator new in place and every count at 0
+    class MemoryTracker final
+    {
+    public:
+        static constexpr uint32_t MaxCallstackDepth = 16;
+        static constexpr uint32_t MaxCallstacks = 512;
+
+        struct TagStats
+        {
+            std::size_t bytesLive = 0;
+            std::size_t bytesPeak = 0;
+            std::size_t allocationsLive = 0;
+            std::size_t allocationsTotal = 0;
+        };
+
+        // One sampled call site, counts are of the samples rather than of every allocation made there
+        struct Callstack
+        {
+            MemoryTag tag = MemoryTag::Untagged;
+            uint64_t samples = 0;
+            uint64_t bytes = 0;
+            std::vector<std::string> frames;
+        };
+
+        static bool IsEnabled();
+
+        static MemoryTag GetThreadTag();
+        static void SetThreadTag(MemoryTag tag);
+
+        // For C style allocator hooks, memory from here must go back through Free
+        static void* Allocate(std::size_t size, std::size_t alignment);
+        static void Free(void* ptr);
+
+        static TagStats GetTagStats(MemoryTag tag);
+
+        // Starts counting a new frame, call once per frame from the main loop
+        static void BeginFrame();
+        // Allocations from every thread since BeginFrame, and over the whole previous frame
+        static uint64_t GetFrameAllocationCount();
+        static uint64_t GetLastFrameAllocationCount();
+        static std::size_t GetLastFrameAllocatedBytes();
+        // Allocations the calling thread has made so far, compare two reads to check a loop doesn't allocate
+        static uint64_t GetThreadAllocationCount();
+
+        // Records the callstack of every interval'th allocation on each thread, 0 turns sampling off
+        static void SetCallstackSampleInterval(uint32_t interval);
+        static uint32_t GetCallstackSampleInterval();
+        // Call sites with the most sampled bytes first, symbols are resolved here so this is slow
+        static void GetTopCallstacks(std::vector<Callstack>& callstacks, std::size_t maxCount);
+        static void ClearCallstacks();
+
+        // Tags, frame counts and the top sampled call sites as text
+        static std::string Report(std::size_t callstackCount = 10);
+        static bool WriteReport(const std::filesystem::path& filePath, std::size_t callstackCount = 10);
+    };
+
+    class MemoryTagScope
+    {
+    public:
+        explicit MemoryTagScope(MemoryTag tag);
+        ~MemoryTagScope();
+
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+    private:
+        MemoryTag mPrevious = MemoryTag::Untagged;
+    };
+
+    // Asserts when the scope ends if the thread allocated inside it, for loops that are meant to be allocation free
+    class NoAllocationScope
+    {
+    public:
+        explicit NoAllocationScope(const char* name);
+        ~NoAllocationScope();
+
+        NoAllocationScope(const NoAllocationScope&) = delete;
+        NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+
+    private:
+        const char* mName = nullptr;
+        uint64_t mStartCount = 0;
+    };
+}
+
+#define MEMORY_CONCAT_INNER(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_INNER(a, b)
+
+#if defined(IEXE_DISABLE_MEMORY_TRACKING)
+#define MEMORY_TAG(tag)
+#define NO_ALLOCATION_SCOPE(name)
+#else
+#define MEMORY_TAG(tag) IExeEngine::Core::MemoryTagScope MEMORY_CONCAT(_memoryTag, __LINE__)(IExeEngine::Core::MemoryTag::tag)
+#if defined(_DEBUG)
+#define NO_ALLOCATION_SCOPE(name) IExeEngine::Core::NoAllocationScope MEMORY_CONCAT(_noAllocationScope, __LINE__)(name)
+#else
+#define NO_ALLOCATION_SCOPE(name)
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+namespace IExeEngine::Core
+{
+    // Hierarchical CPU timings. PROFILE_SCOPE records a begin/end pair into a ring buffer owned by the calling
+    // thread (single writer, no locks), so scopes are cheap enough to leave in hot paths and work from jobs.
+    // The DebugUI timeline and the Chrome trace export read the buffers back while threads keep recording.
+    // Scope names are kept by pointer, use string literals
+    class Profiler final
+    {
+    public:
+        // Per thread, older events are overwritten
+        static constexpr uint32_t EventCapacity = 1 << 15;
+        static constexpr uint32_t FrameHistory = 128;
+
+        struct Event
+        {
+            const char* name = nullptr;
+            uint64_t start = 0;
+            uint64_t end = 0;
+            uint32_t depth = 0;
+        };
+
+        struct Frame
+        {
+            uint64_t start = 0;
+            uint64_t end = 0;
+        };
+
+        struct ThreadEvents
+        {
+            std::string name;
+            uint32_t threadId = 0;
+            std::vector<Event> events;
+        };
+
+        static void StaticInitialize();
+        static void StaticTerminate();
+        static Profiler* Get();
+        static bool IsInitialized();
+
+        // TimeUtil::GetTimeNanoseconds(), every timestamp the profiler hands out is on this clock
+        static uint64_t GetTimestamp();
+
+        Profiler();
+        ~Profiler();
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        // Closes the previous frame and starts the next one, call once per frame from the main loop
+        void BeginFrame();
+
+        // Shown in the timeline and the trace, copied
+        void SetThreadName(const char* name);
+
+        // Paused profilers record nothing, so the last frames stay around to be inspected
+        void SetPaused(bool paused);
+        bool IsPaused() const;
+
+        // Completed frames, oldest first
+        void GetFrames(std::vector<Frame>& frames) const;
+        // Events of every thread that overlap [start, end], in the order they finished
+        void GetEvents(uint64_t start, uint64_t end, std::vector<ThreadEvents>& threads) const;
+
+        // Writes everything still in the buffers as Chrome trace_event JSON (chrome://tracing, Perfetto)
+        bool ExportChromeTrace(const std::filesystem::path& filePath) const;
+
+    private:
+        friend class ProfileScope;
+
+        struct ThreadBuffer;
+
+        ThreadBuffer* GetThreadBuffer();
+        void CopyEvents(const ThreadBuffer& buffer, uint64_t start, uint64_t end, std::vector<Event>& events) const;
+
+        // Tells the buffers threads cached for an earlier profiler apart from this one's
+        uint32_t mGeneration = 0;
+
+        // Buffers are only added, threads keep a pointer to theirs
+        mutable std::mutex mThreadsMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> mThreads;
+
+        mutable std::mutex mFramesMutex;
+        std::array<Frame, FrameHistory> mFrames;
+        uint32_t mFrameCount = 0;
+        uint64_t mFrameStart = 0;
+
+        std::atomic<bool> mPaused{ false };
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name);
+        ~ProfileScope();
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        Profiler::ThreadBuffer* mBuffer = nullptr;
+        const char* mName = nullptr;
+        uint64_t mStart = 0;
+    };
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if defined(IEXE_DISABLE_PROFILER)
+#define PROFILE_SCOPE(name)
+#else
+#define PROFILE_SCOPE(name) IExeEngine::Core::ProfileScope PROFILE_CONCAT(_profileScope, __LINE__)(name)
+#endif
\ No newline at end of file
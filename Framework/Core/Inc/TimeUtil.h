@@ -5,4 +5,10 @@ namespace IExeEngine::Core::TimeUtil
 	float GetTime();
 	
 	float GetDeltaTime();
+
+	// Nanoseconds on a monotonic clock since startup, take differences of these wherever float seconds lose precision
+	uint64_t GetTimeNanoseconds();
+
+	// Blocks until GetTimeNanoseconds() reaches deadline, sleeping on a high resolution timer and spinning only the last stretch
+	void SleepUntil(uint64_t deadline);
 }
\ No newline at end of file
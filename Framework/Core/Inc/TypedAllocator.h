@@ -1,16 +1,25 @@
 #pragma once
 
 #include "BlockAllocator.h"
+#include "ConcurrentBlockAllocator.h"
 
 namespace IExeEngine::Core
 {
-    template<class DataType>
+    // AllocatorType is BlockAllocator for single threaded pools or ConcurrentBlockAllocator when job threads share the pool
+    template<class DataType, class AllocatorType = BlockAllocator>
 
-    class TypedAllocator : private BlockAllocator
+    class TypedAllocator : private AllocatorType
     {
     public:
         TypedAllocator(const char* name, std::size_t capacity)
-            : BlockAllocator(name, sizeof(DataType), capacity)
+            : AllocatorType(name, sizeof(DataType), capacity)
+        {
+
+        }
+
+        // Paged pool, BlockAllocator only
+        TypedAllocator(const char* name, std::size_t capacity, std::size_t blocksPerPage)
+            : AllocatorType(name, sizeof(DataType), capacity, blocksPerPage)
         {
 
         }
@@ -18,8 +27,11 @@ namespace IExeEngine::Core
         template<class... Args>
         DataType* New(Args&&... args)
         {
-            DataType* instance = static_cast<DataType*>(Allocate());
-            new(instance) DataType(std::forward<Args>(args)...);
+            DataType* instance = static_cast<DataType*>(AllocatorType::Allocate());
+            if (instance != nullptr)
+            {
+                new(instance) DataType(std::forward<Args>(args)...);
+            }
             return instance;
         }
 
@@ -30,7 +42,12 @@ namespace IExeEngine::Core
                 return;
             }
             ptr->~DataType();
-            Free(ptr);
+            AllocatorType::Free(ptr);
+        }
+
+        std::size_t Trim()
+        {
+            return AllocatorType::Trim();
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "Precompiled.h"
+#include "AllocatorRegistry.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    struct Entry
+    {
+        const void* allocator = nullptr;
+        AllocatorRegistry::StatsQuery query;
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<Entry> entries;
+    };
+
+    // Built on first use, allocators can be globals constructed before anything is initialized
+    Registry& GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    void FormatBytes(char* buffer, std::size_t size, std::size_t bytes)
+    {
+        if (bytes >= 1024 * 1024)
+        {
+            snprintf(buffer, size, "%.2f MB", bytes / (1024.0 * 1024.0));
+        }
+        else if (bytes >= 1024)
+        {
+            snprintf(buffer, size, "%.2f KB", bytes / 1024.0);
+        }
+        else
+        {
+            snprintf(buffer, size, "%zu B", bytes);
+        }
+    }
+}
+
+void AllocatorRegistry::Register(const void* allocator, StatsQuery query)
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.entries.push_back({ allocator, std::move(query) });
+}
+
+void AllocatorRegistry::Unregister(const void* allocator)
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto iter = std::find_if(registry.entries.begin(), registry.entries.end(),
+        [allocator](const Entry& entry) { return entry.allocator == allocator; });
+    if (iter != registry.entries.end())
+    {
+        registry.entries.erase(iter);
+    }
+}
+
+void AllocatorRegistry::GetStats(std::vector<AllocatorStats>& stats)
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    stats.resize(registry.entries.size());
+    for (std::size_t i = 0; i < registry.entries.size(); ++i)
+    {
+        stats[i] = AllocatorStats();
+        registry.entries[i].query(stats[i]);
+    }
+}
+
+std::string AllocatorRegistry::Dump()
+{
+    std::vector<AllocatorStats> stats;
+    GetStats(stats);
+
+    std::string text;
+    char line[256];
+    snprintf(line, std::size(line), "%-24s %8s %10s %10s %12s %12s %7s %6s\n",
+        "Allocator", "Block", "Live", "Peak", "Live bytes", "Reserved", "Pages", "Frag");
+    text += line;
+    for (const AllocatorStats& stat : stats)
+    {
+        char liveBytes[32];
+        char reservedBytes[32];
+        FormatBytes(liveBytes, std::size(liveBytes), stat.blocksLive * stat.blockSize);
+        FormatBytes(reservedBytes, std::size(reservedBytes), stat.blocksReserved * stat.blockSize);
+        snprintf(line, std::size(line), "%-24s %8zu %10zu %10zu %12s %12s %3zu/%-3zu %5.1f%%\n",
+            stat.name.c_str(), stat.blockSize, stat.blocksLive, stat.blocksPeak, liveBytes, reservedBytes,
+            stat.pageCount - stat.emptyPageCount, stat.pageCount, stat.fragmentation * 100.0f);
+        text += line;
+    }
+    return text;
+}
\ No newline at end of file
@@ -1,53 +1,107 @@
 #include "Precompiled.h"
 #include "BlockAllocator.h"
+#include "AllocatorRegistry.h"
 #include "DebugUtil.h"
 
 using namespace IExeEngine;
 using namespace IExeEngine::Core;
 
-BlockAllocator::BlockAllocator(const char* name, std::size_t blockSize, std::size_t capacity)
+namespace
+{
+    // Paged pools take their pages straight from the OS, which hands out memory in granules of this size
+    std::size_t GetAllocationGranularity()
+    {
+        static const std::size_t granularity = []()
+        {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return static_cast<std::size_t>(info.dwAllocationGranularity);
+        }();
+        return granularity;
+    }
+
+    uint32_t GetGranuleShift()
+    {
+        static const uint32_t shift = []()
+        {
+            uint32_t result = 0;
+            while ((std::size_t(1) << result) < GetAllocationGranularity())
+            {
+                ++result;
+            }
+            return result;
+        }();
+        return shift;
+    }
+}
+
+BlockAllocator::BlockAllocator(const char* name, std::size_t blockSize, std::size_t capacity, std::size_t blocksPerPage)
     : mName(name)
+    , mPaged(blocksPerPage > 0)
     , mBlockSize(blockSize)
     , mCapacity(capacity)
-    , mFreeBlocks(capacity)
 {
     ASSERT(blockSize > 0, "BlockAllocator: %s invalid block size!", mName.c_str());
     ASSERT(capacity > 0, "BlockAllocator: %s invalid capacity!", mName.c_str());
 
-    mData = std::malloc(blockSize * capacity);
-
-    for (std::size_t i = 0; i < capacity; ++i)
+    if (mPaged)
+    {
+        const std::size_t granularity = GetAllocationGranularity();
+        mPageSize = (std::min(blocksPerPage, capacity) * blockSize + granularity - 1) & ~(granularity - 1);
+        mBlocksPerPage = mPageSize / blockSize;
+        ASSERT(mBlocksPerPage < InvalidPage, "BlockAllocator: %s too many blocks per page!", mName.c_str());
+        LOG("%s paged, %zu blocks per page, blocks size: %zu", mName.c_str(), mBlocksPerPage, blockSize);
+    }
+    else
     {
-        mFreeBlocks[i] = static_cast<uint8_t*>(mData) + (i * blockSize);
+        ASSERT(capacity < InvalidPage, "BlockAllocator: %s fixed capacity too large!", mName.c_str());
+        mBlocksPerPage = capacity;
+        mPageSize = blockSize * capacity;
+        AddPage();
+        LOG("%s allocated %zu blocks, blocks size: %zu", mName.c_str(), capacity, blockSize);
     }
-    LOG("%s allocated %zu blocks, blocks size: %zu", mName.c_str(), capacity, blockSize);
+
+    AllocatorRegistry::Register(this, [this](AllocatorStats& stats) { GetStats(stats); });
 }
 
 BlockAllocator::~BlockAllocator()
 {
+    AllocatorRegistry::Unregister(this);
+
     ASSERT(mBlocksAllocatedTotal == mBlocksFreed, "BlockAllocator: %s not all blocks are freed!", mName.c_str());
-    std::free(mData);
-    mData = nullptr;
+    for (uint32_t i = 0; i < mPages.size(); ++i)
+    {
+        if (mPages[i].data != nullptr)
+        {
+            ReleasePage(i);
+        }
+    }
     LOG("%s destructed, Allocated: %zu, Freed %zu, Highest: %zu",
         mName.c_str(), mBlocksAllocatedCurrent, mBlocksFreed, mBlocksHighest);
 }
 
 void* BlockAllocator::Allocate()
 {
-    if (mFreeBlocks.empty())
+    if (mPagesWithFreeBlocks.empty() && !AddPage())
     {
-        LOG("%s allocation failed, no free blocks available!", mName.c_str());
+        LOG_WARNING(Core, "%s allocation failed, no free blocks available!", mName.c_str());
         return nullptr;
     }
 
-    void* freeBlock = mFreeBlocks.back();
-    mFreeBlocks.pop_back();
+    Page& page = mPages[mPagesWithFreeBlocks.back()];
+    void* freeBlock = page.freeBlocks.back();
+    page.freeBlocks.pop_back();
+    if (page.freeBlocks.empty())
+    {
+        mPagesWithFreeBlocks.pop_back();
+    }
+    ++page.blocksLive;
 
     ++mBlocksAllocatedTotal;
     ++mBlocksAllocatedCurrent;
     mBlocksHighest = std::max(mBlocksHighest, mBlocksAllocatedCurrent);
 
-    LOG("%s allocated blocks at %p, Allocated: %zu, Freed %zu, Highest: %zu",
+    LOG_VERBOSE(Core, "%s allocated blocks at %p, Allocated: %zu, Freed %zu, Highest: %zu",
         mName.c_str(), freeBlock, mBlocksAllocatedCurrent, mBlocksFreed, mBlocksHighest);
 
     return freeBlock;
@@ -57,19 +111,188 @@ void BlockAllocator::Free(void* ptr)
 {
     if (ptr == nullptr)
     {
-        LOG("%s free failed, null pointer provided!", mName.c_str());
+        LOG_WARNING(Core, "%s free failed, null pointer provided!", mName.c_str());
         return;
     }
 
-    const uint8_t* start = static_cast<uint8_t*>(mData);
-    const uint8_t* end = static_cast<uint8_t*>(mData) + (mBlockSize * mCapacity);
-    const uint8_t* current = static_cast<uint8_t*>(ptr);
-    const auto diff = current - start;
-    ASSERT(current >= start && current < end && static_cast<std::size_t>(diff) % mBlockSize == 0,
+    const uint32_t pageIndex = FindPage(ptr);
+    ASSERT(pageIndex != InvalidPage && static_cast<std::size_t>(static_cast<uint8_t*>(ptr) - mPages[pageIndex].data) % mBlockSize == 0,
         "BlockAllocator: %s free failed, Invalid address being freed!", mName.c_str());
+    if (pageIndex == InvalidPage)
+    {
+        return;
+    }
 
-    LOG("%s free %p", mName.c_str(), ptr);
+    Page& page = mPages[pageIndex];
+    if (page.freeBlocks.empty())
+    {
+        mPagesWithFreeBlocks.push_back(pageIndex);
+    }
+    page.freeBlocks.push_back(ptr);
+    --page.blocksLive;
+
+    LOG_VERBOSE(Core, "%s free %p", mName.c_str(), ptr);
     --mBlocksAllocatedCurrent;
     ++mBlocksFreed;
-    mFreeBlocks.push_back(ptr);
+}
+
+std::size_t BlockAllocator::Trim()
+{
+    if (!mPaged)
+    {
+        return 0;
+    }
+
+    std::size_t bytesReleased = 0;
+    for (uint32_t i = 0; i < mPages.size(); ++i)
+    {
+        if (mPages[i].data != nullptr && mPages[i].blocksLive == 0)
+        {
+            ReleasePage(i);
+            bytesReleased += mPageSize;
+        }
+    }
+    if (bytesReleased > 0)
+    {
+        mPagesWithFreeBlocks.erase(std::remove_if(mPagesWithFreeBlocks.begin(), mPagesWithFreeBlocks.end(),
+            [this](uint32_t pageIndex) { return mPages[pageIndex].data == nullptr; }), mPagesWithFreeBlocks.end());
+        LOG_VERBOSE(Core, "%s trimmed %zu bytes", mName.c_str(), bytesReleased);
+    }
+    return bytesReleased;
+}
+
+void BlockAllocator::GetStats(AllocatorStats& stats) const
+{
+    stats.name = mName;
+    stats.blockSize = mBlockSize;
+    stats.blocksLive = mBlocksAllocatedCurrent;
+    stats.blocksPeak = mBlocksHighest;
+    stats.blocksReserved = mBlocksReserved;
+
+    std::size_t strandedBlocks = 0;
+    for (const Page& page : mPages)
+    {
+        if (page.data == nullptr)
+        {
+            continue;
+        }
+        ++stats.pageCount;
+        if (page.blocksLive > 0)
+        {
+            strandedBlocks += page.freeBlocks.size();
+        }
+        else if (mPaged)
+        {
+            ++stats.emptyPageCount;
+        }
+    }
+    stats.fragmentation = (mBlocksReserved > 0) ? static_cast<float>(strandedBlocks) / static_cast<float>(mBlocksReserved) : 0.0f;
+}
+
+bool BlockAllocator::AddPage()
+{
+    const std::size_t blockCount = std::min(mBlocksPerPage, mCapacity - mBlocksReserved);
+    if (blockCount == 0)
+    {
+        return false;
+    }
+
+    Page page;
+    if (mPaged)
+    {
+        page.data = static_cast<uint8_t*>(VirtualAlloc(nullptr, mPageSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    }
+    else
+    {
+        page.data = static_cast<uint8_t*>(std::malloc(mPageSize));
+    }
+    if (page.data == nullptr)
+    {
+        return false;
+    }
+
+    // Handed out from the start of the page
+    page.blockCount = static_cast<uint32_t>(blockCount);
+    page.freeBlocks.resize(blockCount);
+    for (uint32_t i = 0; i < page.blockCount; ++i)
+    {
+        page.freeBlocks[i] = page.data + ((page.blockCount - 1 - i) * mBlockSize);
+    }
+
+    uint32_t pageIndex = static_cast<uint32_t>(mPages.size());
+    if (!mUnusedPages.empty())
+    {
+        pageIndex = mUnusedPages.back();
+        mUnusedPages.pop_back();
+        mPages[pageIndex] = std::move(page);
+    }
+    else
+    {
+        mPages.push_back(std::move(page));
+    }
+
+    // Paged pages start on a granule and fill whole ones, so no granule is shared by two pages
+    const uintptr_t start = reinterpret_cast<uintptr_t>(mPages[pageIndex].data);
+    const uintptr_t end = start + (blockCount * mBlockSize);
+    for (uintptr_t granule = start >> GetGranuleShift(); granule <= ((end - 1) >> GetGranuleShift()); ++granule)
+    {
+        mPageLookup[granule] = pageIndex;
+    }
+
+    mPagesWithFreeBlocks.push_back(pageIndex);
+    mBlocksReserved += blockCount;
+    LOG_VERBOSE(Core, "%s added page %u, Reserved: %zu", mName.c_str(), pageIndex, mBlocksReserved);
+    return true;
+}
+
+void BlockAllocator::ReleasePage(uint32_t pageIndex)
+{
+    Page& page = mPages[pageIndex];
+    const uintptr_t start = reinterpret_cast<uintptr_t>(page.data);
+    const uintptr_t end = start + (page.blockCount * mBlockSize);
+    for (uintptr_t granule = start >> GetGranuleShift(); granule <= ((end - 1) >> GetGranuleShift()); ++granule)
+    {
+        mPageLookup.erase(granule);
+    }
+
+    if (mPaged)
+    {
+        VirtualFree(page.data, 0, MEM_RELEASE);
+    }
+    else
+    {
+        std::free(page.data);
+    }
+    mBlocksReserved -= page.blockCount;
+    page = Page();
+    mUnusedPages.push_back(pageIndex);
+    if (mLastFreedPage == pageIndex)
+    {
+        mLastFreedPage = InvalidPage;
+    }
+}
+
+bool BlockAllocator::IsInPage(uint32_t pageIndex, uintptr_t address) const
+{
+    // The granule of a fixed pool's page can reach past either end of it
+    const Page& page = mPages[pageIndex];
+    const uintptr_t start = reinterpret_cast<uintptr_t>(page.data);
+    return address >= start && address < start + (page.blockCount * mBlockSize);
+}
+
+uint32_t BlockAllocator::FindPage(const void* ptr)
+{
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    if (mLastFreedPage != InvalidPage && IsInPage(mLastFreedPage, address))
+    {
+        return mLastFreedPage;
+    }
+
+    auto iter = mPageLookup.find(address >> GetGranuleShift());
+    if (iter == mPageLookup.end() || !IsInPage(iter->second, address))
+    {
+        return InvalidPage;
+    }
+    mLastFreedPage = iter->second;
+    return iter->second;
 }
\ No newline at end of file
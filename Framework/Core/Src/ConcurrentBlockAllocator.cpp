@@ -0,0 +1,312 @@
+#include "Precompiled.h"
+#include "ConcurrentBlockAllocator.h"
+#include "AllocatorRegistry.h"
+#include "DebugUtil.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    // Guards the slot numbers and the list of allocators, only taken when a thread starts or exits and when an
+    // allocator is made or destroyed
+    std::mutex sThreadMutex;
+    std::vector<uint32_t> sFreeThreadIndices;
+    uint32_t sNextThreadIndex = 0;
+    std::vector<ConcurrentBlockAllocator*> sAllocators;
+
+    // Single writer counter, a plain load and store instead of a locked add
+    void Increment(std::atomic<std::size_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    constexpr uint64_t MakeHead(uint32_t index, uint32_t tag)
+    {
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+}
+
+// Threads are numbered on first use and keep the same magazine slot in every allocator until they exit, then the
+// slot's blocks go back to the shared lists and the number is handed to the next thread
+struct ConcurrentBlockAllocator::ThreadSlot
+{
+    uint32_t index = UINT32_MAX;
+
+    ThreadSlot()
+    {
+        std::lock_guard<std::mutex> lock(sThreadMutex);
+        if (!sFreeThreadIndices.empty())
+        {
+            index = sFreeThreadIndices.back();
+            sFreeThreadIndices.pop_back();
+        }
+        else if (sNextThreadIndex < MaxThreads)
+        {
+            index = sNextThreadIndex++;
+        }
+    }
+
+    ~ThreadSlot()
+    {
+        if (index >= MaxThreads)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(sThreadMutex);
+        for (ConcurrentBlockAllocator* allocator : sAllocators)
+        {
+            allocator->FlushMagazine(allocator->mMagazines[index]);
+        }
+        sFreeThreadIndices.push_back(index);
+    }
+};
+
+ConcurrentBlockAllocator::ConcurrentBlockAllocator(const char* name, std::size_t blockSize, std::size_t capacity)
+    : mName(name)
+    , mMagazines(std::make_unique<Magazine[]>(MaxThreads))
+    , mBlockSize(blockSize)
+    , mCapacity(capacity)
+{
+    ASSERT(blockSize > 0, "ConcurrentBlockAllocator: %s invalid block size!", mName.c_str());
+    ASSERT(capacity > 0 && capacity < InvalidIndex, "ConcurrentBlockAllocator: %s invalid capacity!", mName.c_str());
+
+    // Every free block holds the index of the next one, round up so the link fits and stays aligned
+    mBlockSize = std::max(blockSize, sizeof(std::atomic<uint32_t>));
+    mBlockSize = (mBlockSize + alignof(std::atomic<uint32_t>) - 1) & ~(alignof(std::atomic<uint32_t>) - 1);
+
+    mData = std::malloc(mBlockSize * capacity);
+
+    for (std::size_t i = 0; i < capacity; ++i)
+    {
+        const uint32_t next = (i + 1 < capacity) ? static_cast<uint32_t>(i + 1) : InvalidIndex;
+        new (static_cast<uint8_t*>(mData) + (i * mBlockSize)) std::atomic<uint32_t>(next);
+    }
+    mFreeHead.store(MakeHead(0, 0), std::memory_order_relaxed);
+    LOG("%s allocated %zu blocks, blocks size: %zu", mName.c_str(), capacity, mBlockSize);
+
+    {
+        std::lock_guard<std::mutex> lock(sThreadMutex);
+        sAllocators.push_back(this);
+    }
+    AllocatorRegistry::Register(this, [this](AllocatorStats& stats) { GetStats(stats); });
+}
+
+ConcurrentBlockAllocator::~ConcurrentBlockAllocator()
+{
+    AllocatorRegistry::Unregister(this);
+    {
+        std::lock_guard<std::mutex> lock(sThreadMutex);
+        sAllocators.erase(std::find(sAllocators.begin(), sAllocators.end(), this));
+    }
+
+    ASSERT(GetBlocksAllocatedTotal() == GetBlocksFreed(), "ConcurrentBlockAllocator: %s not all blocks are freed!", mName.c_str());
+    std::free(mData);
+    mData = nullptr;
+    LOG("%s destructed, Allocated: %zu, Freed %zu, Highest: %zu",
+        mName.c_str(), GetBlocksAllocatedTotal(), GetBlocksFreed(), mBlocksHighest.load());
+}
+
+void* ConcurrentBlockAllocator::Allocate()
+{
+    uint32_t index = InvalidIndex;
+    Magazine* magazine = GetMagazine();
+    if (magazine != nullptr)
+    {
+        if (magazine->count == 0)
+        {
+            // Refill to half so a thread alternating Allocate/Free doesn't go back to the shared list every call
+            while (magazine->count < MagazineSize / 2)
+            {
+                const uint32_t freeIndex = PopFree();
+                if (freeIndex == InvalidIndex)
+                {
+                    break;
+                }
+                magazine->blocks[magazine->count++] = freeIndex;
+            }
+            TrackTaken(magazine->count);
+        }
+        if (magazine->count > 0)
+        {
+            index = magazine->blocks[--magazine->count];
+            Increment(magazine->blocksAllocated);
+        }
+    }
+    else
+    {
+        index = PopFree();
+        if (index != InvalidIndex)
+        {
+            TrackTaken(1);
+            mBlocksAllocatedShared.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (index == InvalidIndex)
+    {
+        LOG_WARNING(Core, "%s allocation failed, no free blocks available!", mName.c_str());
+        return nullptr;
+    }
+
+    return static_cast<uint8_t*>(mData) + (index * mBlockSize);
+}
+
+void ConcurrentBlockAllocator::Free(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        LOG_WARNING(Core, "%s free failed, null pointer provided!", mName.c_str());
+        return;
+    }
+
+    const uint8_t* start = static_cast<uint8_t*>(mData);
+    const uint8_t* end = static_cast<uint8_t*>(mData) + (mBlockSize * mCapacity);
+    const uint8_t* current = static_cast<uint8_t*>(ptr);
+    const auto diff = current - start;
+    ASSERT(current >= start && current < end && static_cast<std::size_t>(diff) % mBlockSize == 0,
+        "ConcurrentBlockAllocator: %s free failed, Invalid address being freed!", mName.c_str());
+
+    const uint32_t index = static_cast<uint32_t>(static_cast<std::size_t>(diff) / mBlockSize);
+    new (ptr) std::atomic<uint32_t>(InvalidIndex);
+
+    Magazine* magazine = GetMagazine();
+    if (magazine == nullptr)
+    {
+        PushFree(index, index);
+        TrackTaken(-1);
+        mBlocksFreedShared.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (magazine->count == MagazineSize)
+    {
+        // Hand the older half back as one chain, a single CAS no matter how many blocks
+        constexpr uint32_t flushCount = MagazineSize / 2;
+        for (uint32_t i = 0; i + 1 < flushCount; ++i)
+        {
+            GetNextLink(magazine->blocks[i]).store(magazine->blocks[i + 1], std::memory_order_relaxed);
+        }
+        PushFree(magazine->blocks[0], magazine->blocks[flushCount - 1]);
+        for (uint32_t i = flushCount; i < MagazineSize; ++i)
+        {
+            magazine->blocks[i - flushCount] = magazine->blocks[i];
+        }
+        magazine->count -= flushCount;
+        TrackTaken(-static_cast<std::ptrdiff_t>(flushCount));
+    }
+    magazine->blocks[magazine->count++] = index;
+    Increment(magazine->blocksFreed);
+}
+
+std::size_t ConcurrentBlockAllocator::GetBlocksAllocated() const
+{
+    // A snapshot while other threads are allocating, exact once they are idle
+    const std::size_t freed = GetBlocksFreed();
+    const std::size_t total = GetBlocksAllocatedTotal();
+    return (total > freed) ? total - freed : 0;
+}
+
+void ConcurrentBlockAllocator::GetStats(AllocatorStats& stats) const
+{
+    // One slab, its free blocks are stranded whenever any block is live
+    stats.name = mName;
+    stats.blockSize = mBlockSize;
+    stats.blocksLive = GetBlocksAllocated();
+    stats.blocksPeak = mBlocksHighest.load(std::memory_order_relaxed);
+    stats.blocksReserved = mCapacity;
+    stats.pageCount = 1;
+    stats.fragmentation = (stats.blocksLive > 0) ? static_cast<float>(mCapacity - stats.blocksLive) / static_cast<float>(mCapacity) : 0.0f;
+}
+
+std::size_t ConcurrentBlockAllocator::GetBlocksAllocatedTotal() const
+{
+    std::size_t total = mBlocksAllocatedShared.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < MaxThreads; ++i)
+    {
+        total += mMagazines[i].blocksAllocated.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::size_t ConcurrentBlockAllocator::GetBlocksFreed() const
+{
+    std::size_t freed = mBlocksFreedShared.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < MaxThreads; ++i)
+    {
+        freed += mMagazines[i].blocksFreed.load(std::memory_order_relaxed);
+    }
+    return freed;
+}
+
+ConcurrentBlockAllocator::Magazine* ConcurrentBlockAllocator::GetMagazine() const
+{
+    // Threads past MaxThreads go straight to the shared list
+    thread_local const ThreadSlot threadSlot;
+    return (threadSlot.index < MaxThreads) ? &mMagazines[threadSlot.index] : nullptr;
+}
+
+void ConcurrentBlockAllocator::FlushMagazine(Magazine& magazine)
+{
+    if (magazine.count == 0)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i + 1 < magazine.count; ++i)
+    {
+        GetNextLink(magazine.blocks[i]).store(magazine.blocks[i + 1], std::memory_order_relaxed);
+    }
+    PushFree(magazine.blocks[0], magazine.blocks[magazine.count - 1]);
+    TrackTaken(-static_cast<std::ptrdiff_t>(magazine.count));
+    magazine.count = 0;
+}
+
+std::atomic<uint32_t>& ConcurrentBlockAllocator::GetNextLink(uint32_t index) const
+{
+    return *reinterpret_cast<std::atomic<uint32_t>*>(static_cast<uint8_t*>(mData) + (index * mBlockSize));
+}
+
+void ConcurrentBlockAllocator::PushFree(uint32_t first, uint32_t last)
+{
+    uint64_t head = mFreeHead.load(std::memory_order_relaxed);
+    do
+    {
+        GetNextLink(last).store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while (!mFreeHead.compare_exchange_weak(head, MakeHead(first, static_cast<uint32_t>(head >> 32) + 1),
+        std::memory_order_release, std::memory_order_relaxed));
+}
+
+uint32_t ConcurrentBlockAllocator::PopFree()
+{
+    uint64_t head = mFreeHead.load(std::memory_order_acquire);
+    while (true)
+    {
+        const uint32_t index = static_cast<uint32_t>(head);
+        if (index == InvalidIndex)
+        {
+            return InvalidIndex;
+        }
+
+        // If another thread takes this block first the link may already be overwritten by its owner,
+        // the tag in the head changes with it so the CAS fails and the stale link is never used
+        const uint32_t next = GetNextLink(index).load(std::memory_order_relaxed);
+        if (mFreeHead.compare_exchange_weak(head, MakeHead(next, static_cast<uint32_t>(head >> 32) + 1),
+            std::memory_order_acquire, std::memory_order_acquire))
+        {
+            return index;
+        }
+    }
+}
+
+void ConcurrentBlockAllocator::TrackTaken(std::ptrdiff_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    const std::size_t taken = mBlocksTaken.fetch_add(static_cast<std::size_t>(count), std::memory_order_relaxed) + static_cast<std::size_t>(count);
+    std::size_t highest = mBlocksHighest.load(std::memory_order_relaxed);
+    while (count > 0 && taken > highest && !mBlocksHighest.compare_exchange_weak(highest, taken, std::memory_order_relaxed))
+    {
+    }
+}
\ No newline at end of file
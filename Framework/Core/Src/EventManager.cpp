@@ -39,50 +39,144 @@ void EventManager::Broadcast(const Event& e)
 
 EventManager::~EventManager()
 {
-    ASSERT(mEventListeners.empty(), "EventManager: Terminate must be called!");
+    ASSERT(mChannels.empty(), "EventManager: Terminate must be called!");
 }
 
 void EventManager::Initialize()
 {
-    mEventListeners.clear();
+    mChannels.clear();
 }
 
 void EventManager::Terminate()
 {
-    mEventListeners.clear();
+    mChannels.clear();
+
+    std::lock_guard<std::mutex> lock(mPostMutex);
+    mQueues.clear();
 }
 
 EventListenerId EventManager::AddListener(EventTypeId eventId, const EventCallback& cb)
 {
     ++mNextListenerId;
-    mEventListeners[eventId][mNextListenerId] = cb;
+    Channel& channel = mChannels[eventId];
+    // Ids only grow, so appending keeps the list sorted
+    std::vector<Listener>& listeners = (channel.dispatchDepth > 0) ? channel.addedListeners : channel.listeners;
+    listeners.push_back({ mNextListenerId, cb });
 
     return mNextListenerId;
 }
 
 void EventManager::RemoveListener(EventTypeId eventId, EventListenerId listenerId)
 {
-    auto eventGroupListeners = mEventListeners.find(eventId);
+    auto channelIter = mChannels.find(eventId);
+    if (channelIter == mChannels.end())
+    {
+        return;
+    }
+
+    Channel& channel = channelIter->second;
+    auto findListener = [listenerId](std::vector<Listener>& listeners)
+    {
+        auto iter = std::lower_bound(listeners.begin(), listeners.end(), listenerId,
+            [](const Listener& listener, EventListenerId id) { return listener.id < id; });
+        return (iter != listeners.end() && iter->id == listenerId) ? iter : listeners.end();
+    };
 
-    if (eventGroupListeners != mEventListeners.end())
+    auto listener = findListener(channel.listeners);
+    if (listener != channel.listeners.end())
     {
-        auto listener = eventGroupListeners->second.find(listenerId);
-        if (listener != eventGroupListeners->second.end())
+        if (channel.dispatchDepth > 0)
         {
-            eventGroupListeners->second.erase(listener);
+            // The callback may be the one running, so it is only destroyed once the dispatch is over
+            listener->removed = true;
+            channel.hasRemovedListeners = true;
         }
+        else
+        {
+            channel.listeners.erase(listener);
+        }
+        return;
+    }
+
+    auto addedListener = findListener(channel.addedListeners);
+    if (addedListener != channel.addedListeners.end())
+    {
+        channel.addedListeners.erase(addedListener);
     }
 }
 
+void EventManager::DispatchQueued()
+{
+    ASSERT(!mDispatchingQueued, "EventManager: DispatchQueued can't be called from an event callback!");
+    mDispatchingQueued = true;
+    {
+        std::lock_guard<std::mutex> lock(mPostMutex);
+        for (auto& [eventId, queue] : mQueues)
+        {
+            if (queue->Swap())
+            {
+                mDispatchQueues.push_back(queue.get());
+            }
+        }
+    }
+
+    for (QueueBase* queue : mDispatchQueues)
+    {
+        queue->Dispatch(*this);
+    }
+    mDispatchQueues.clear();
+    mDispatchingQueued = false;
+}
+
 void EventManager::BroadcastPrivate(const Event& e)
 {
-    auto eventGroupListeners = mEventListeners.find(e.GetTypeId());
+    DispatchBatch(e.GetTypeId(), &e, 1, 0);
+}
 
-    if (eventGroupListeners != mEventListeners.end())
+void EventManager::DispatchBatch(EventTypeId eventId, const Event* events, std::size_t count, std::size_t stride)
+{
+    auto channelIter = mChannels.find(eventId);
+    if (channelIter == mChannels.end())
     {
-        for (auto& cb : eventGroupListeners->second)
+        return;
+    }
+
+    Channel& channel = channelIter->second;
+    ++channel.dispatchDepth;
+    // Nothing is added to or erased from the list while dispatchDepth is up, so the pointers stay valid
+    const Listener* listenersBegin = channel.listeners.data();
+    const Listener* listenersEnd = listenersBegin + channel.listeners.size();
+    const std::byte* event = reinterpret_cast<const std::byte*>(events);
+    for (std::size_t i = 0; i < count; ++i, event += stride)
+    {
+        const Event& e = *reinterpret_cast<const Event*>(event);
+        for (const Listener* listener = listenersBegin; listener != listenersEnd; ++listener)
         {
-            cb.second(e);
+            if (!listener->removed)
+            {
+                listener->callback(e);
+            }
         }
     }
+
+    if (--channel.dispatchDepth == 0 && (channel.hasRemovedListeners || !channel.addedListeners.empty()))
+    {
+        ApplyListenerChanges(channel);
+    }
+}
+
+void EventManager::ApplyListenerChanges(Channel& channel)
+{
+    if (channel.hasRemovedListeners)
+    {
+        channel.listeners.erase(std::remove_if(channel.listeners.begin(), channel.listeners.end(),
+            [](const Listener& listener) { return listener.removed; }), channel.listeners.end());
+        channel.hasRemovedListeners = false;
+    }
+    if (!channel.addedListeners.empty())
+    {
+        channel.listeners.insert(channel.listeners.end(),
+            std::make_move_iterator(channel.addedListeners.begin()), std::make_move_iterator(channel.addedListeners.end()));
+        channel.addedListeners.clear();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "Precompiled.h"
+#include "FrameAllocator.h"
+#include "AllocatorRegistry.h"
+#include "DebugUtil.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    std::unique_ptr<FrameAllocator> sFrameAllocator;
+
+    uintptr_t AlignUp(uintptr_t address, std::size_t alignment)
+    {
+        return (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    }
+}
+
+void FrameAllocator::StaticInitialize(std::size_t capacity)
+{
+    ASSERT(sFrameAllocator == nullptr, "FrameAllocator: Is already initialized!");
+    sFrameAllocator = std::make_unique<FrameAllocator>();
+    sFrameAllocator->Initialize(capacity);
+}
+
+void FrameAllocator::StaticTerminate()
+{
+    if (sFrameAllocator != nullptr)
+    {
+        sFrameAllocator->Terminate();
+        sFrameAllocator.reset();
+    }
+}
+
+FrameAllocator* FrameAllocator::Get()
+{
+    ASSERT(sFrameAllocator != nullptr, "FrameAllocator: Isn't initialized!");
+    return sFrameAllocator.get();
+}
+
+FrameAllocator::~FrameAllocator()
+{
+    ASSERT(mBuffers[0].data == nullptr, "FrameAllocator: Terminate must be called!");
+}
+
+void FrameAllocator::Initialize(std::size_t capacity)
+{
+    ASSERT(capacity > 0, "FrameAllocator: invalid capacity!");
+    mCapacity = capacity;
+    for (Buffer& buffer : mBuffers)
+    {
+        buffer.data = static_cast<uint8_t*>(std::malloc(capacity));
+        buffer.offset = 0;
+    }
+    mCurrentBuffer = 0;
+    mLastFrameBytesUsed = 0;
+    mHighWaterMark = 0;
+    mOverflowCount = 0;
+#if defined(_DEBUG)
+    mPoisonOnReset = true;
+#endif
+    LOG("FrameAllocator allocated %u buffers of %zu bytes", FrameCount, capacity);
+
+    // A bump allocator has nothing to fragment, live bytes are the current frame's
+    AllocatorRegistry::Register(this, [this](AllocatorStats& stats)
+    {
+        stats.name = "FrameAllocator";
+        stats.blockSize = 1;
+        stats.blocksLive = GetBytesUsed();
+        stats.blocksPeak = GetHighWaterMark();
+        stats.blocksReserved = mCapacity * FrameCount;
+        stats.pageCount = FrameCount;
+    });
+}
+
+void FrameAllocator::Terminate()
+{
+    AllocatorRegistry::Unregister(this);
+    for (Buffer& buffer : mBuffers)
+    {
+        Reset(buffer);
+        std::free(buffer.data);
+        buffer.data = nullptr;
+    }
+    LOG("FrameAllocator destructed, Highest: %zu bytes, Overflows: %zu", GetHighWaterMark(), mOverflowCount.load());
+}
+
+void FrameAllocator::BeginFrame()
+{
+    const std::size_t bytesUsed = GetBytesUsed();
+    mLastFrameBytesUsed = bytesUsed;
+    mHighWaterMark = std::max(mHighWaterMark, bytesUsed);
+
+    mCurrentBuffer = (mCurrentBuffer + 1) % FrameCount;
+    Reset(mBuffers[mCurrentBuffer]);
+}
+
+void* FrameAllocator::Allocate(std::size_t size, std::size_t alignment)
+{
+    ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "FrameAllocator: alignment must be a power of two!");
+    Buffer& buffer = mBuffers[mCurrentBuffer];
+    const uintptr_t base = reinterpret_cast<uintptr_t>(buffer.data);
+
+    std::size_t offset = buffer.offset.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const std::size_t start = AlignUp(base + offset, alignment) - base;
+        const std::size_t end = start + size;
+        if (end > mCapacity)
+        {
+            return AllocateOverflow(buffer, size, alignment);
+        }
+        if (buffer.offset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+        {
+            return buffer.data + start;
+        }
+    }
+}
+
+FrameAllocator::Scope::Scope()
+    : Scope(*FrameAllocator::Get())
+{
+}
+
+FrameAllocator::Scope::Scope(FrameAllocator& allocator)
+    : mAllocator(allocator)
+    , mBuffer(allocator.mCurrentBuffer)
+    , mMarker(allocator.mBuffers[allocator.mCurrentBuffer].offset.load(std::memory_order_relaxed))
+{
+}
+
+FrameAllocator::Scope::~Scope()
+{
+    ASSERT(mBuffer == mAllocator.mCurrentBuffer, "FrameAllocator: Scope can't span BeginFrame!");
+    mAllocator.Rewind(mAllocator.mBuffers[mBuffer], mMarker);
+}
+
+void FrameAllocator::SetPoisonOnReset(bool poison)
+{
+    mPoisonOnReset = poison;
+}
+
+std::size_t FrameAllocator::GetCapacity() const
+{
+    return mCapacity;
+}
+
+std::size_t FrameAllocator::GetBytesUsed() const
+{
+    const Buffer& buffer = mBuffers[mCurrentBuffer];
+    const std::size_t offset = std::max(buffer.peakOffset, buffer.offset.load(std::memory_order_relaxed));
+    return offset + buffer.overflowBytes.load(std::memory_order_relaxed);
+}
+
+std::size_t FrameAllocator::GetLastFrameBytesUsed() const
+{
+    return mLastFrameBytesUsed;
+}
+
+std::size_t FrameAllocator::GetHighWaterMark() const
+{
+    return std::max(mHighWaterMark, GetBytesUsed());
+}
+
+std::size_t FrameAllocator::GetOverflowCount() const
+{
+    return mOverflowCount.load(std::memory_order_relaxed);
+}
+
+void* FrameAllocator::AllocateOverflow(Buffer& buffer, std::size_t size, std::size_t alignment)
+{
+    // Rare, the mutex only guards the list of heap blocks
+    void* block = _aligned_malloc(size, alignment);
+    if (block == nullptr)
+    {
+        LOG("FrameAllocator out of space and the heap fallback of %zu bytes failed", size);
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(buffer.overflowMutex);
+        buffer.overflowBlocks.push_back(block);
+        buffer.overflowBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (mOverflowCount.fetch_add(1, std::memory_order_relaxed) == 0)
+    {
+        LOG("FrameAllocator out of space, %zu bytes per frame isn't enough, falling back to the heap", mCapacity);
+    }
+    return block;
+}
+
+void FrameAllocator::Reset(Buffer& buffer)
+{
+    if (mPoisonOnReset && buffer.data != nullptr)
+    {
+        std::memset(buffer.data, PoisonByte, buffer.offset.load(std::memory_order_relaxed));
+    }
+    buffer.offset.store(0, std::memory_order_relaxed);
+    buffer.peakOffset = 0;
+
+    for (void* block : buffer.overflowBlocks)
+    {
+        _aligned_free(block);
+    }
+    buffer.overflowBlocks.clear();
+    buffer.overflowBytes = 0;
+}
+
+void FrameAllocator::Rewind(Buffer& buffer, std::size_t marker)
+{
+    const std::size_t offset = buffer.offset.load(std::memory_order_relaxed);
+    ASSERT(offset >= marker, "FrameAllocator: Scopes must be released in reverse order!");
+    buffer.peakOffset = std::max(buffer.peakOffset, offset);
+    if (mPoisonOnReset)
+    {
+        std::memset(buffer.data + marker, PoisonByte, offset - marker);
+    }
+    buffer.offset.store(marker, std::memory_order_relaxed);
+}
\ No newline at end of file
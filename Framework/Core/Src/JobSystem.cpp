@@ -0,0 +1,418 @@
+#include "Precompiled.h"
+#include "JobSystem.h"
+#include "DebugUtil.h"
+#include "Profiler.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    std::unique_ptr<JobSystem> sJobSystem;
+
+    // Queue owned by the current thread, -1 for threads the JobSystem didn't start (other than the one that initialized it)
+    thread_local int sQueueIndex = -1;
+
+    constexpr std::size_t JobPoolCapacity = 16384;
+
+    // Empty polls before an idle worker goes to sleep, long enough to ride out the gaps between small jobs
+    constexpr uint32_t IdleSpinCount = 64;
+
+    uint32_t GetRandom()
+    {
+        thread_local uint32_t state = 2463534242u ^ static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+}
+
+// Chase-Lev deque with a fixed capacity, Push/Pop from the owning thread only, Steal from any thread
+class JobSystem::WorkQueue
+{
+public:
+    static constexpr int64_t Capacity = 4096;
+
+    bool Push(Job* job)
+    {
+        const int64_t bottom = mBottom.load(std::memory_order_relaxed);
+        const int64_t top = mTop.load(std::memory_order_acquire);
+        if (bottom - top >= Capacity)
+        {
+            return false;
+        }
+        mJobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+        mBottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* Pop()
+    {
+        const int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+        mBottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = mTop.load(std::memory_order_relaxed);
+        if (top > bottom)
+        {
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = mJobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // Last job, race the thieves for it
+            if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* Steal()
+    {
+        int64_t top = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = mBottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        Job* job = mJobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+        if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            // Lost to the owner or another thief
+            return nullptr;
+        }
+        return job;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> mTop{ 0 };
+    alignas(64) std::atomic<int64_t> mBottom{ 0 };
+    std::array<std::atomic<Job*>, Capacity> mJobs;
+};
+
+JobCounter::~JobCounter()
+{
+    ASSERT(mPending == 0, "JobCounter: destroyed while jobs are still running!");
+}
+
+bool JobCounter::IsDone() const
+{
+    if (mPending.load(std::memory_order_acquire) != 0)
+    {
+        return false;
+    }
+    // The last job decrements under the lock, taking it makes sure that job is done touching this counter
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPending.load(std::memory_order_relaxed) == 0;
+}
+
+void JobSystem::StaticInitialize(uint32_t workerCount)
+{
+    ASSERT(sJobSystem == nullptr, "JobSystem: Is already initialized!");
+    sJobSystem = std::make_unique<JobSystem>();
+    sJobSystem->Initialize(workerCount);
+}
+
+void JobSystem::StaticTerminate()
+{
+    if (sJobSystem != nullptr)
+    {
+        sJobSystem->Terminate();
+        sJobSystem.reset();
+    }
+}
+
+JobSystem* JobSystem::Get()
+{
+    ASSERT(sJobSystem != nullptr, "JobSystem: Isn't initialized!");
+    return sJobSystem.get();
+}
+
+JobSystem::JobSystem() = default;
+
+JobSystem::~JobSystem()
+{
+    ASSERT(mWorkers.empty(), "JobSystem: Terminate must be called!");
+}
+
+void JobSystem::Initialize(uint32_t workerCount)
+{
+    if (workerCount == 0)
+    {
+        const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+    }
+
+    mJobPool = std::make_unique<TypedAllocator<Job, ConcurrentBlockAllocator>>("JobPool", JobPoolCapacity);
+    mQuit = false;
+    for (uint32_t i = 0; i <= workerCount; ++i)
+    {
+        mQueues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    sQueueIndex = 0;
+    for (uint32_t i = 1; i <= workerCount; ++i)
+    {
+        mWorkers.emplace_back(&JobSystem::WorkerLoop, this, static_cast<int>(i));
+    }
+    LOG("JobSystem: started %u workers", workerCount);
+}
+
+void JobSystem::Terminate()
+{
+    // Drain what is still queued so no job or counter is left dangling
+    while (mQueuedJobs.load() > 0)
+    {
+        Job* job = FindJob(sQueueIndex);
+        if (job != nullptr)
+        {
+            Execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mQuit = true;
+    }
+    mWakeUp.notify_all();
+    for (std::thread& worker : mWorkers)
+    {
+        worker.join();
+    }
+    mWorkers.clear();
+    mQueues.clear();
+    mJobPool.reset();
+    sQueueIndex = -1;
+}
+
+void JobSystem::Run(JobFunction function, JobCounter* counter)
+{
+    if (counter != nullptr)
+    {
+        counter->mPending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Submit(std::move(function), counter);
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, JobFunction function, JobCounter* counter)
+{
+    if (counter != nullptr)
+    {
+        counter->mPending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        // Finish takes the same lock for the last decrement, so the job either sees the dependency done or is picked up by it
+        std::lock_guard<std::mutex> lock(dependency.mMutex);
+        if (dependency.mPending.load(std::memory_order_acquire) != 0)
+        {
+            dependency.mContinuations.push_back({ std::move(function), counter });
+            return;
+        }
+    }
+    Submit(std::move(function), counter);
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const ParallelForFunction& function)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    batchSize = std::max(batchSize, 1u);
+
+    JobCounter counter;
+    for (uint32_t begin = batchSize; begin < count; begin += batchSize)
+    {
+        const uint32_t end = std::min(begin + batchSize, count);
+        Run([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+
+    // The calling thread takes the first batch itself, then helps with the rest
+    function(0, std::min(batchSize, count));
+    Wait(counter);
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+    const int queueIndex = sQueueIndex;
+    while (!counter.IsDone())
+    {
+        Job* job = FindJob(queueIndex);
+        if (job != nullptr)
+        {
+            Execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint32_t JobSystem::GetWorkerCount() const
+{
+    return static_cast<uint32_t>(mWorkers.size());
+}
+
+void JobSystem::Submit(JobFunction function, JobCounter* counter)
+{
+    Job* job = mJobPool->New();
+    if (job == nullptr)
+    {
+        // Pool exhausted, running it here keeps the counters right
+        LOG("JobSystem: job pool exhausted, running job inline");
+        function();
+        Finish(counter);
+        return;
+    }
+    job->function = std::move(function);
+    job->counter = counter;
+
+    // Counted before it becomes visible so a thief can't take it and decrement first
+    mQueuedJobs.fetch_add(1);
+    const int queueIndex = sQueueIndex;
+    if (queueIndex < 0 || static_cast<std::size_t>(queueIndex) >= mQueues.size() || !mQueues[queueIndex]->Push(job))
+    {
+        std::lock_guard<std::mutex> lock(mSharedMutex);
+        mSharedJobs.push_back(job);
+        mSharedJobCount.fetch_add(1);
+    }
+
+    // A worker counts itself as sleeping before its last look at mQueuedJobs, so one of the two always sees the other
+    if (mSleepingWorkers.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+        }
+        mWakeUp.notify_one();
+    }
+}
+
+JobSystem::Job* JobSystem::FindJob(int queueIndex)
+{
+    Job* job = nullptr;
+    if (queueIndex >= 0)
+    {
+        job = mQueues[queueIndex]->Pop();
+    }
+
+    if (job == nullptr && mSharedJobCount.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(mSharedMutex);
+        if (!mSharedJobs.empty())
+        {
+            job = mSharedJobs.front();
+            mSharedJobs.pop_front();
+            mSharedJobCount.fetch_sub(1);
+        }
+    }
+
+    if (job == nullptr)
+    {
+        // Start at a random victim so thieves spread out instead of all hitting queue 0
+        const std::size_t queueCount = mQueues.size();
+        const std::size_t start = GetRandom() % queueCount;
+        for (std::size_t i = 0; i < queueCount && job == nullptr; ++i)
+        {
+            const std::size_t victim = (start + i) % queueCount;
+            if (static_cast<int>(victim) != queueIndex)
+            {
+                job = mQueues[victim]->Steal();
+            }
+        }
+    }
+
+    if (job != nullptr)
+    {
+        mQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void JobSystem::Execute(Job* job)
+{
+    job->function();
+    JobCounter* counter = job->counter;
+    mJobPool->Delete(job);
+    Finish(counter);
+}
+
+void JobSystem::Finish(JobCounter* counter)
+{
+    if (counter == nullptr)
+    {
+        return;
+    }
+
+    // Not the last job, no one can be waiting to destroy the counter yet
+    uint32_t pending = counter->mPending.load(std::memory_order_relaxed);
+    while (pending > 1)
+    {
+        if (counter->mPending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+
+    std::vector<JobCounter::Continuation> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->mMutex);
+        if (counter->mPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            continuations.swap(counter->mContinuations);
+        }
+    }
+
+    // The counter may be gone from here on, the continuations were already counted on their own counters
+    for (JobCounter::Continuation& continuation : continuations)
+    {
+        Submit(std::move(continuation.function), continuation.counter);
+    }
+}
+
+void JobSystem::WorkerLoop(int queueIndex)
+{
+    sQueueIndex = queueIndex;
+    if (Profiler::IsInitialized())
+    {
+        const std::string threadName = "Worker " + std::to_string(queueIndex);
+        Profiler::Get()->SetThreadName(threadName.c_str());
+    }
+    while (!mQuit.load(std::memory_order_acquire))
+    {
+        Job* job = FindJob(queueIndex);
+        if (job != nullptr)
+        {
+            Execute(job);
+            continue;
+        }
+
+        bool hasWork = false;
+        for (uint32_t i = 0; i < IdleSpinCount && !hasWork; ++i)
+        {
+            std::this_thread::yield();
+            hasWork = mQueuedJobs.load(std::memory_order_relaxed) > 0;
+        }
+        if (hasWork)
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleepingWorkers.fetch_add(1);
+        mWakeUp.wait(lock, [this]() { return mQuit.load() || mQueuedJobs.load() > 0; });
+        mSleepingWorkers.fetch_sub(1);
+    }
+}
\ No newline at end of file
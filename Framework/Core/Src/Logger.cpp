@@ -0,0 +1,300 @@
+#include "Precompiled.h"
+#include "Logger.h"
+#include "TimeUtil.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    std::unique_ptr<Logger> sLogger;
+
+    std::atomic<LogLevel> sLevels[] =
+    {
+        LogLevel::Info, LogLevel::Info, LogLevel::Info, LogLevel::Info, LogLevel::Info, LogLevel::Info, LogLevel::Info
+    };
+    static_assert(std::size(sLevels) == static_cast<std::size_t>(LogCategory::Count), "Logger: one level per category");
+
+    // "{time}: [Category] Level: message", General and Info are left out so plain LOG output reads as before
+    void FormatLine(const LogDetail::Record& record, char* line, std::size_t size)
+    {
+        int length = snprintf(line, size, "{%.3f}: ", record.timestamp * 1e-9);
+        if (record.category != LogCategory::General)
+        {
+            length += snprintf(line + length, size - length, "[%s] ", GetLogCategoryName(record.category));
+        }
+        if (record.level != LogLevel::Info)
+        {
+            length += snprintf(line + length, size - length, "%s: ", GetLogLevelName(record.level));
+        }
+
+        // Room is kept for the newline even when the message is cut off
+        const int written = record.formatFunc(line + length, size - length - 1, record.format, record.payload);
+        length = std::min(length + std::max(written, 0), static_cast<int>(size) - 2);
+        line[length] = '\n';
+        line[length + 1] = '\0';
+    }
+}
+
+struct Logger::Slot
+{
+    std::atomic<uint64_t> sequence{ 0 };
+    LogDetail::Record record;
+};
+
+const char* IExeEngine::Core::GetLogLevelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Verbose: return "Verbose";
+    case LogLevel::Info: return "Info";
+    case LogLevel::Warning: return "Warning";
+    case LogLevel::Error: return "Error";
+    case LogLevel::Off: return "Off";
+    }
+    return "";
+}
+
+const char* IExeEngine::Core::GetLogCategoryName(LogCategory category)
+{
+    switch (category)
+    {
+    case LogCategory::General: return "General";
+    case LogCategory::Core: return "Core";
+    case LogCategory::Graphics: return "Graphics";
+    case LogCategory::Physics: return "Physics";
+    case LogCategory::Audio: return "Audio";
+    case LogCategory::Input: return "Input";
+    case LogCategory::Engine: return "Engine";
+    case LogCategory::Count: break;
+    }
+    return "";
+}
+
+void Logger::StaticInitialize(const Settings& settings)
+{
+    if (sLogger == nullptr)
+    {
+        sLogger = std::make_unique<Logger>(settings);
+    }
+}
+
+void Logger::StaticTerminate()
+{
+    sLogger.reset();
+}
+
+Logger* Logger::Get()
+{
+    return sLogger.get();
+}
+
+bool Logger::IsEnabled(LogLevel level, LogCategory category)
+{
+    return level >= sLevels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+}
+
+void Logger::SetLevel(LogCategory category, LogLevel level)
+{
+    sLevels[static_cast<std::size_t>(category)].store(level, std::memory_order_relaxed);
+}
+
+LogLevel Logger::GetLevel(LogCategory category)
+{
+    return sLevels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+}
+
+void Logger::Flush()
+{
+    Logger* logger = sLogger.get();
+    if (logger == nullptr)
+    {
+        return;
+    }
+
+    const uint64_t target = logger->mEnqueuePos.load(std::memory_order_acquire);
+    while (logger->mWrittenPos.load(std::memory_order_acquire) < target)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void Logger::Submit(LogDetail::Record& record)
+{
+    record.timestamp = TimeUtil::GetTimeNanoseconds();
+
+    Logger* logger = sLogger.get();
+    if (logger != nullptr)
+    {
+        logger->Push(record);
+        return;
+    }
+
+    char line[MaxLineLength];
+    FormatLine(record, line, std::size(line));
+    OutputDebugStringA(line);
+}
+
+Logger::Logger(const Settings& settings)
+    : mSettings(settings)
+    , mSlots(std::make_unique<Slot[]>(QueueCapacity))
+{
+    for (uint32_t i = 0; i < QueueCapacity; ++i)
+    {
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    if (!mSettings.filePath.empty())
+    {
+        fopen_s(&mFile, mSettings.filePath.u8string().c_str(), "w");
+    }
+
+    mThread = std::thread(&Logger::Run, this);
+}
+
+Logger::~Logger()
+{
+    mStopping.store(true, std::memory_order_release);
+    {
+        // Not between its check of mStopping and the wait once this has the lock
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+    }
+    mWakeCondition.notify_one();
+    mThread.join();
+
+    if (mFile != nullptr)
+    {
+        fclose(mFile);
+    }
+}
+
+uint64_t Logger::GetStallCount() const
+{
+    return mStallCount.load(std::memory_order_relaxed);
+}
+
+// Bounded MPMC queue (Vyukov) with a single consumer. A slot's sequence equals the position that may write it
+// next, becomes position + 1 once the record is in, and position + capacity once the logger thread is done with it
+void Logger::Push(const LogDetail::Record& record)
+{
+    uint64_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    bool stalled = false;
+    while (true)
+    {
+        slot = &mSlots[pos & (QueueCapacity - 1)];
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0)
+        {
+            if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Full, wait for the logger thread to catch up
+            if (!stalled)
+            {
+                stalled = true;
+                mStallCount.fetch_add(1, std::memory_order_relaxed);
+                mWakeCondition.notify_one();
+            }
+            std::this_thread::yield();
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = record;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    // Pairs with the fence in Run, either the logger thread sees this record before it sleeps or this sees it asleep.
+    // A busy logger thread costs the writer nothing more than the fence
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mSleeping.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mWakeCondition.notify_one();
+    }
+}
+
+bool Logger::HasQueued() const
+{
+    return mSlots[mReadPos & (QueueCapacity - 1)].sequence.load(std::memory_order_acquire) == mReadPos + 1;
+}
+
+uint32_t Logger::WriteQueued()
+{
+    char line[MaxLineLength];
+    uint32_t count = 0;
+    while (true)
+    {
+        Slot& slot = mSlots[mReadPos & (QueueCapacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != mReadPos + 1)
+        {
+            break;
+        }
+
+        FormatLine(slot.record, line, std::size(line));
+        slot.sequence.store(mReadPos + QueueCapacity, std::memory_order_release);
+        ++mReadPos;
+        ++count;
+
+        WriteLine(line);
+    }
+
+    if (count > 0)
+    {
+        if (mFile != nullptr)
+        {
+            fflush(mFile);
+        }
+        mWrittenPos.store(mReadPos, std::memory_order_release);
+    }
+    return count;
+}
+
+void Logger::WriteLine(const char* line)
+{
+    if (mSettings.debuggerOutput)
+    {
+        OutputDebugStringA(line);
+    }
+    if (mSettings.consoleOutput)
+    {
+        fputs(line, stdout);
+    }
+    if (mFile != nullptr)
+    {
+        fputs(line, mFile);
+    }
+}
+
+void Logger::Run()
+{
+    while (true)
+    {
+        // Read before draining so everything logged ahead of StaticTerminate still gets written
+        const bool stopping = mStopping.load(std::memory_order_acquire);
+        if (WriteQueued() > 0)
+        {
+            continue;
+        }
+        if (stopping)
+        {
+            break;
+        }
+
+        // Sleeps until Push or the destructor wakes it, an idle logger doesn't use any CPU
+        std::unique_lock<std::mutex> lock(mWakeMutex);
+        mSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        mWakeCondition.wait(lock, [this]() { return HasQueued() || mStopping.load(std::memory_order_acquire); });
+        mSleeping.store(false, std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "Precompiled.h"
+#include "MappedFile.h"
+#include "DebugUtil.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::filesystem::path& filePath)
+{
+    Close();
+
+    mFile = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(mFile, &fileSize) || fileSize.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    mMapping = CreateFileMappingW(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mMapping == nullptr)
+    {
+        LOG("MappedFile: Failed to create mapping for %s", filePath.u8string().c_str());
+        Close();
+        return false;
+    }
+
+    mData = static_cast<const uint8_t*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+    if (mData == nullptr)
+    {
+        LOG("MappedFile: Failed to map view of %s", filePath.u8string().c_str());
+        Close();
+        return false;
+    }
+
+    mSize = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (mData != nullptr)
+    {
+        UnmapViewOfFile(mData);
+        mData = nullptr;
+    }
+    if (mMapping != nullptr)
+    {
+        CloseHandle(mMapping);
+        mMapping = nullptr;
+    }
+    if (mFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mFile);
+        mFile = INVALID_HANDLE_VALUE;
+    }
+    mSize = 0;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return mData != nullptr;
+}
+
+const uint8_t* MappedFile::GetData() const
+{
+    return mData;
+}
+
+std::size_t MappedFile::GetSize() const
+{
+    return mSize;
+}
@@ -0,0 +1,516 @@
+#include "Precompiled.h"
+#include "MemoryTracker.h"
+#include "DebugUtil.h"
+
+#include <DbgHelp.h>
+#include <new>
+
+#pragma comment(lib, "dbghelp.lib")
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    constexpr std::size_t TagCount = static_cast<std::size_t>(MemoryTag::Count);
+    constexpr std::size_t HeaderSize = 16;
+    constexpr uint16_t HeaderGuard = 0xA110;
+
+    // Sits right in front of every pointer handed out
+    struct AllocationHeader
+    {
+        uint64_t size;
+        // From the start of the block malloc returned to the pointer handed out
+        uint32_t offset;
+        MemoryTag tag;
+        bool aligned;
+        uint16_t guard;
+    };
+    static_assert(sizeof(AllocationHeader) == HeaderSize, "MemoryTracker: header must keep allocations aligned");
+
+    // Live counts are derived from totals and frees so an allocation touches three counters
+    struct alignas(64) TagCounters
+    {
+        std::atomic<std::size_t> bytesLive{ 0 };
+        std::atomic<std::size_t> bytesPeak{ 0 };
+        std::atomic<std::size_t> bytesTotal{ 0 };
+        std::atomic<std::size_t> allocationsTotal{ 0 };
+        std::atomic<std::size_t> frees{ 0 };
+    };
+    TagCounters sTags[TagCount];
+
+    thread_local MemoryTag sThreadTag = MemoryTag::Untagged;
+    thread_local uint64_t sThreadAllocationCount = 0;
+    thread_local uint32_t sThreadSampleCountdown = 0;
+
+    // Written by BeginFrame on the main thread
+    uint64_t sFrameStartCount = 0;
+    std::size_t sFrameStartBytes = 0;
+    uint64_t sLastFrameCount = 0;
+    std::size_t sLastFrameBytes = 0;
+
+    struct CallstackEntry
+    {
+        uint32_t hash = 0;
+        uint32_t depth = 0;
+        MemoryTag tag = MemoryTag::Untagged;
+        uint64_t samples = 0;
+        uint64_t bytes = 0;
+        void* frames[MemoryTracker::MaxCallstackDepth] = {};
+    };
+
+    // Open addressing table filled from inside operator new, so nothing in it may allocate. Nothing allocates
+    // while the lock is held either, a sampling thread would spin on itself
+    std::atomic<uint32_t> sSampleInterval{ 0 };
+    std::atomic_flag sCallstackLock = ATOMIC_FLAG_INIT;
+    CallstackEntry sCallstacks[MemoryTracker::MaxCallstacks];
+    std::atomic<uint64_t> sDroppedSamples{ 0 };
+
+    // DbgHelp is single threaded
+    std::mutex sSymbolMutex;
+
+    void LockCallstacks()
+    {
+        while (sCallstackLock.test_and_set(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void UnlockCallstacks()
+    {
+        sCallstackLock.clear(std::memory_order_release);
+    }
+
+    // Skips itself, RecordAllocation and TrackedAllocate
+    void RecordCallstack(std::size_t size, MemoryTag tag)
+    {
+        void* frames[MemoryTracker::MaxCallstackDepth];
+        ULONG hash = 0;
+        const uint32_t depth = RtlCaptureStackBackTrace(3, MemoryTracker::MaxCallstackDepth, frames, &hash);
+
+        LockCallstacks();
+        for (uint32_t probe = 0; probe < MemoryTracker::MaxCallstacks; ++probe)
+        {
+            CallstackEntry& entry = sCallstacks[(hash + probe) % MemoryTracker::MaxCallstacks];
+            if (entry.samples == 0)
+            {
+                entry.hash = hash;
+                entry.depth = depth;
+                entry.tag = tag;
+                std::copy(frames, frames + depth, entry.frames);
+            }
+            else if (entry.hash != hash || entry.depth != depth || entry.tag != tag || !std::equal(frames, frames + depth, entry.frames))
+            {
+                continue;
+            }
+            ++entry.samples;
+            entry.bytes += size;
+            UnlockCallstacks();
+            return;
+        }
+        UnlockCallstacks();
+        sDroppedSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RecordAllocation(std::size_t size, MemoryTag tag)
+    {
+        TagCounters& counters = sTags[static_cast<std::size_t>(tag)];
+        const std::size_t bytesLive = counters.bytesLive.fetch_add(size, std::memory_order_relaxed) + size;
+        std::size_t bytesPeak = counters.bytesPeak.load(std::memory_order_relaxed);
+        while (bytesLive > bytesPeak && !counters.bytesPeak.compare_exchange_weak(bytesPeak, bytesLive, std::memory_order_relaxed))
+        {
+        }
+        counters.bytesTotal.fetch_add(size, std::memory_order_relaxed);
+        counters.allocationsTotal.fetch_add(1, std::memory_order_relaxed);
+        ++sThreadAllocationCount;
+
+        const uint32_t interval = sSampleInterval.load(std::memory_order_relaxed);
+        if (interval > 0 && ++sThreadSampleCountdown >= interval)
+        {
+            sThreadSampleCountdown = 0;
+            RecordCallstack(size, tag);
+        }
+    }
+
+    void* TrackedAllocate(std::size_t size, std::size_t alignment)
+    {
+        // malloc already aligns to max_align_t, and the header keeps that for the pointer behind it
+        const bool aligned = alignment > alignof(std::max_align_t);
+        const std::size_t offset = aligned ? std::max(alignment, HeaderSize) : HeaderSize;
+        if (size > SIZE_MAX - offset)
+        {
+            return nullptr;
+        }
+
+        uint8_t* block = static_cast<uint8_t*>(aligned ? _aligned_malloc(size + offset, alignment) : std::malloc(size + offset));
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+
+        uint8_t* ptr = block + offset;
+        AllocationHeader* header = reinterpret_cast<AllocationHeader*>(ptr - HeaderSize);
+        header->size = size;
+        header->offset = static_cast<uint32_t>(offset);
+        header->tag = sThreadTag;
+        header->aligned = aligned;
+        header->guard = HeaderGuard;
+        RecordAllocation(size, header->tag);
+        return ptr;
+    }
+
+    void TrackedFree(void* ptr)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        AllocationHeader* header = reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(ptr) - HeaderSize);
+        ASSERT(header->guard == HeaderGuard, "MemoryTracker: freeing %p that wasn't allocated through the tracker!", ptr);
+
+        TagCounters& counters = sTags[static_cast<std::size_t>(header->tag)];
+        counters.bytesLive.fetch_sub(static_cast<std::size_t>(header->size), std::memory_order_relaxed);
+        counters.frees.fetch_add(1, std::memory_order_relaxed);
+
+        header->guard = 0;
+        void* block = static_cast<uint8_t*>(ptr) - header->offset;
+        if (header->aligned)
+        {
+            _aligned_free(block);
+        }
+        else
+        {
+            std::free(block);
+        }
+    }
+
+    uint64_t GetAllocationCount()
+    {
+        uint64_t count = 0;
+        for (const TagCounters& counters : sTags)
+        {
+            count += counters.allocationsTotal.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    std::size_t GetAllocatedBytes()
+    {
+        std::size_t bytes = 0;
+        for (const TagCounters& counters : sTags)
+        {
+            bytes += counters.bytesTotal.load(std::memory_order_relaxed);
+        }
+        return bytes;
+    }
+
+    std::string DescribeAddress(void* address)
+    {
+        std::lock_guard<std::mutex> lock(sSymbolMutex);
+        static const bool symbolsLoaded = []()
+        {
+            SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+            return SymInitialize(GetCurrentProcess(), nullptr, TRUE) != FALSE;
+        }();
+
+        char text[512];
+        snprintf(text, std::size(text), "%p", address);
+        if (!symbolsLoaded)
+        {
+            return text;
+        }
+
+        alignas(SYMBOL_INFO) char symbolBuffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+        SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(symbolBuffer);
+        symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+        symbol->MaxNameLen = MAX_SYM_NAME;
+        DWORD64 displacement = 0;
+        if (SymFromAddr(GetCurrentProcess(), reinterpret_cast<DWORD64>(address), &displacement, symbol))
+        {
+            IMAGEHLP_LINE64 line = {};
+            line.SizeOfStruct = sizeof(IMAGEHLP_LINE64);
+            DWORD lineDisplacement = 0;
+            if (SymGetLineFromAddr64(GetCurrentProcess(), reinterpret_cast<DWORD64>(address), &lineDisplacement, &line))
+            {
+                snprintf(text, std::size(text), "%s (%s:%lu)", symbol->Name, line.FileName, line.LineNumber);
+            }
+            else
+            {
+                snprintf(text, std::size(text), "%s", symbol->Name);
+            }
+        }
+        return text;
+    }
+}
+
+const char* IExeEngine::Core::GetMemoryTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::Untagged: return "Untagged";
+    case MemoryTag::Models: return "Models";
+    case MemoryTag::Animation: return "Animation";
+    case MemoryTag::Textures: return "Textures";
+    case MemoryTag::Audio: return "Audio";
+    case MemoryTag::Physics: return "Physics";
+    case MemoryTag::Components: return "Components";
+    case MemoryTag::Count: break;
+    }
+    return "";
+}
+
+bool MemoryTracker::IsEnabled()
+{
+#if defined(IEXE_DISABLE_MEMORY_TRACKING)
+    return false;
+#else
+    return true;
+#endif
+}
+
+MemoryTag MemoryTracker::GetThreadTag()
+{
+    return sThreadTag;
+}
+
+void MemoryTracker::SetThreadTag(MemoryTag tag)
+{
+    sThreadTag = tag;
+}
+
+void* MemoryTracker::Allocate(std::size_t size, std::size_t alignment)
+{
+#if defined(IEXE_DISABLE_MEMORY_TRACKING)
+    return _aligned_malloc(size, std::max(alignment, alignof(std::max_align_t)));
+#else
+    return TrackedAllocate(size, alignment);
+#endif
+}
+
+void MemoryTracker::Free(void* ptr)
+{
+#if defined(IEXE_DISABLE_MEMORY_TRACKING)
+    _aligned_free(ptr);
+#else
+    TrackedFree(ptr);
+#endif
+}
+
+MemoryTracker::TagStats MemoryTracker::GetTagStats(MemoryTag tag)
+{
+    const TagCounters& counters = sTags[static_cast<std::size_t>(tag)];
+    TagStats stats;
+    stats.bytesLive = counters.bytesLive.load(std::memory_order_relaxed);
+    stats.bytesPeak = counters.bytesPeak.load(std::memory_order_relaxed);
+    // Frees first, so a free racing with this read can't make the live count go negative
+    const std::size_t frees = counters.frees.load(std::memory_order_relaxed);
+    stats.allocationsTotal = counters.allocationsTotal.load(std::memory_order_relaxed);
+    stats.allocationsLive = stats.allocationsTotal - std::min(frees, stats.allocationsTotal);
+    return stats;
+}
+
+void MemoryTracker::BeginFrame()
+{
+    const uint64_t count = GetAllocationCount();
+    const std::size_t bytes = GetAllocatedBytes();
+    sLastFrameCount = count - sFrameStartCount;
+    sLastFrameBytes = bytes - sFrameStartBytes;
+    sFrameStartCount = count;
+    sFrameStartBytes = bytes;
+}
+
+uint64_t MemoryTracker::GetFrameAllocationCount()
+{
+    return GetAllocationCount() - sFrameStartCount;
+}
+
+uint64_t MemoryTracker::GetLastFrameAllocationCount()
+{
+    return sLastFrameCount;
+}
+
+std::size_t MemoryTracker::GetLastFrameAllocatedBytes()
+{
+    return sLastFrameBytes;
+}
+
+uint64_t MemoryTracker::GetThreadAllocationCount()
+{
+    return sThreadAllocationCount;
+}
+
+void MemoryTracker::SetCallstackSampleInterval(uint32_t interval)
+{
+    sSampleInterval.store(interval, std::memory_order_relaxed);
+}
+
+uint32_t MemoryTracker::GetCallstackSampleInterval()
+{
+    return sSampleInterval.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::GetTopCallstacks(std::vector<Callstack>& callstacks, std::size_t maxCount)
+{
+    // Copied out first, resolving symbols allocates
+    std::vector<CallstackEntry> entries(MaxCallstacks);
+    LockCallstacks();
+    std::copy(std::begin(sCallstacks), std::end(sCallstacks), entries.begin());
+    UnlockCallstacks();
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](const CallstackEntry& entry) { return entry.samples == 0; }), entries.end());
+    std::sort(entries.begin(), entries.end(), [](const CallstackEntry& a, const CallstackEntry& b) { return a.bytes > b.bytes; });
+    entries.resize(std::min(entries.size(), maxCount));
+
+    callstacks.resize(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        Callstack& callstack = callstacks[i];
+        callstack.tag = entries[i].tag;
+        callstack.samples = entries[i].samples;
+        callstack.bytes = entries[i].bytes;
+        callstack.frames.clear();
+        for (uint32_t f = 0; f < entries[i].depth; ++f)
+        {
+            callstack.frames.push_back(DescribeAddress(entries[i].frames[f]));
+        }
+    }
+}
+
+void MemoryTracker::ClearCallstacks()
+{
+    LockCallstacks();
+    std::fill(std::begin(sCallstacks), std::end(sCallstacks), CallstackEntry());
+    UnlockCallstacks();
+    sDroppedSamples.store(0, std::memory_order_relaxed);
+}
+
+std::string MemoryTracker::Report(std::size_t callstackCount)
+{
+    std::string text;
+    char line[512];
+    snprintf(line, std::size(line), "%-12s %14s %14s %12s %12s\n", "Tag", "Live bytes", "Peak bytes", "Live allocs", "Total allocs");
+    text += line;
+    for (std::size_t i = 0; i < TagCount; ++i)
+    {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        const TagStats stats = GetTagStats(tag);
+        snprintf(line, std::size(line), "%-12s %14zu %14zu %12zu %12zu\n", GetMemoryTagName(tag),
+            stats.bytesLive, stats.bytesPeak, stats.allocationsLive, stats.allocationsTotal);
+        text += line;
+    }
+    snprintf(line, std::size(line), "Last frame: %llu allocations, %zu bytes\n",
+        static_cast<unsigned long long>(sLastFrameCount), sLastFrameBytes);
+    text += line;
+
+    const uint32_t interval = GetCallstackSampleInterval();
+    if (interval == 0)
+    {
+        return text;
+    }
+
+    std::vector<Callstack> callstacks;
+    GetTopCallstacks(callstacks, callstackCount);
+    snprintf(line, std::size(line), "Top call sites, sampled every %u allocations (%llu samples dropped)\n",
+        interval, static_cast<unsigned long long>(sDroppedSamples.load(std::memory_order_relaxed)));
+    text += line;
+    for (const Callstack& callstack : callstacks)
+    {
+        snprintf(line, std::size(line), "  %llu samples, %llu bytes [%s]\n", static_cast<unsigned long long>(callstack.samples),
+            static_cast<unsigned long long>(callstack.bytes), GetMemoryTagName(callstack.tag));
+        text += line;
+        for (const std::string& frame : callstack.frames)
+        {
+            text += "    ";
+            text += frame;
+            text += "\n";
+        }
+    }
+    return text;
+}
+
+bool MemoryTracker::WriteReport(const std::filesystem::path& filePath, std::size_t callstackCount)
+{
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    const std::string text = Report(callstackCount);
+    fputs(text.c_str(), file);
+    fclose(file);
+    return true;
+}
+
+MemoryTagScope::MemoryTagScope(MemoryTag tag)
+    : mPrevious(sThreadTag)
+{
+    sThreadTag = tag;
+}
+
+MemoryTagScope::~MemoryTagScope()
+{
+    sThreadTag = mPrevious;
+}
+
+NoAllocationScope::NoAllocationScope(const char* name)
+    : mName(name)
+    , mStartCount(sThreadAllocationCount)
+{
+}
+
+NoAllocationScope::~NoAllocationScope()
+{
+    const uint64_t allocations = sThreadAllocationCount - mStartCount;
+    ASSERT(allocations == 0, "MemoryTracker: %s made %llu allocations!", mName, static_cast<unsigned long long>(allocations));
+}
+
+#if !defined(IEXE_DISABLE_MEMORY_TRACKING)
+
+namespace
+{
+    void* AllocateOrThrow(std::size_t size, std::size_t alignment)
+    {
+        while (true)
+        {
+            void* ptr = TrackedAllocate(size, alignment);
+            if (ptr != nullptr)
+            {
+                return ptr;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+}
+
+void* operator new(std::size_t size) { return AllocateOrThrow(size, 0); }
+void* operator new[](std::size_t size) { return AllocateOrThrow(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<std::size_t>(alignment)); }
+
+// The header knows the size and alignment, the sized and aligned forms don't need theirs
+void operator delete(void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+
+#endif
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "Precompiled.h"
+#include "Profiler.h"
+#include "DebugUtil.h"
+#include "TimeUtil.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    std::unique_ptr<Profiler> sProfiler;
+    std::atomic<uint32_t> sGeneration{ 0 };
+
+    // The current thread's buffer in the profiler of generation sThreadGeneration
+    thread_local void* sThreadBuffer = nullptr;
+    thread_local uint32_t sThreadGeneration = 0;
+
+    void WriteEscaped(FILE* file, const char* text)
+    {
+        for (const char* c = text; *c != '\0'; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                fputc('\\', file);
+            }
+            fputc(*c, file);
+        }
+    }
+
+    double ToMicroseconds(uint64_t nanoseconds)
+    {
+        return static_cast<double>(nanoseconds) / 1000.0;
+    }
+}
+
+// Written by its thread only. Every field is a relaxed atomic so readers can copy events while the owner records,
+// written is published with release so everything below it is complete unless the writer has lapped the reader
+struct Profiler::ThreadBuffer
+{
+    struct Slot
+    {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<uint64_t> start{ 0 };
+        std::atomic<uint64_t> end{ 0 };
+        std::atomic<uint32_t> depth{ 0 };
+    };
+
+    std::unique_ptr<Slot[]> slots = std::make_unique<Slot[]>(EventCapacity);
+    std::atomic<uint64_t> written{ 0 };
+    // Open scopes on this thread, only touched by the owner
+    uint32_t depth = 0;
+
+    uint32_t threadId = 0;
+    std::string name;
+};
+
+void Profiler::StaticInitialize()
+{
+    ASSERT(sProfiler == nullptr, "Profiler: Is already initialized!");
+    sProfiler = std::make_unique<Profiler>();
+    sProfiler->SetThreadName("Main");
+}
+
+void Profiler::StaticTerminate()
+{
+    sProfiler.reset();
+}
+
+Profiler* Profiler::Get()
+{
+    ASSERT(sProfiler != nullptr, "Profiler: Isn't initialized!");
+    return sProfiler.get();
+}
+
+bool Profiler::IsInitialized()
+{
+    return sProfiler != nullptr;
+}
+
+uint64_t Profiler::GetTimestamp()
+{
+    return TimeUtil::GetTimeNanoseconds();
+}
+
+Profiler::Profiler()
+    : mGeneration(++sGeneration)
+    , mFrameStart(GetTimestamp())
+{
+}
+
+Profiler::~Profiler() = default;
+
+void Profiler::BeginFrame()
+{
+    const uint64_t now = GetTimestamp();
+    std::lock_guard<std::mutex> lock(mFramesMutex);
+    if (!IsPaused())
+    {
+        mFrames[mFrameCount % FrameHistory] = { mFrameStart, now };
+        ++mFrameCount;
+    }
+    mFrameStart = now;
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(mThreadsMutex);
+    buffer->name = name;
+}
+
+void Profiler::SetPaused(bool paused)
+{
+    mPaused = paused;
+}
+
+bool Profiler::IsPaused() const
+{
+    return mPaused.load(std::memory_order_relaxed);
+}
+
+void Profiler::GetFrames(std::vector<Frame>& frames) const
+{
+    std::lock_guard<std::mutex> lock(mFramesMutex);
+    const uint32_t count = std::min(mFrameCount, FrameHistory);
+    frames.clear();
+    for (uint32_t i = mFrameCount - count; i < mFrameCount; ++i)
+    {
+        frames.push_back(mFrames[i % FrameHistory]);
+    }
+}
+
+void Profiler::GetEvents(uint64_t start, uint64_t end, std::vector<ThreadEvents>& threads) const
+{
+    std::lock_guard<std::mutex> lock(mThreadsMutex);
+    threads.resize(mThreads.size());
+    for (size_t i = 0; i < mThreads.size(); ++i)
+    {
+        threads[i].name = mThreads[i]->name;
+        threads[i].threadId = mThreads[i]->threadId;
+        threads[i].events.clear();
+        CopyEvents(*mThreads[i], start, end, threads[i].events);
+    }
+}
+
+bool Profiler::ExportChromeTrace(const std::filesystem::path& filePath) const
+{
+    FILE* file = nullptr;
+    fopen_s(&file, filePath.u8string().c_str(), "w");
+    if (file == nullptr)
+    {
+        LOG("Profiler: failed to open %s", filePath.u8string().c_str());
+        return false;
+    }
+
+    std::vector<ThreadEvents> threads;
+    GetEvents(0, UINT64_MAX, threads);
+    std::vector<Frame> frames;
+    GetFrames(frames);
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    const char* separator = "";
+    for (const ThreadEvents& thread : threads)
+    {
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", separator, thread.threadId);
+        WriteEscaped(file, thread.name.c_str());
+        fprintf(file, "\"}}");
+        separator = ",\n";
+
+        for (const Event& event : thread.events)
+        {
+            fprintf(file, ",\n{\"name\":\"");
+            WriteEscaped(file, event.name);
+            fprintf(file, "\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                ToMicroseconds(event.start), ToMicroseconds(event.end - event.start), thread.threadId);
+        }
+    }
+    // Frame boundaries as global instant events, drawn as lines across every thread
+    for (const Frame& frame : frames)
+    {
+        fprintf(file, "%s{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":0}", separator, ToMicroseconds(frame.start));
+        separator = ",\n";
+    }
+    fprintf(file, "\n]}\n");
+
+    const bool success = ferror(file) == 0;
+    fclose(file);
+    return success;
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+    if (sThreadGeneration != mGeneration || sThreadBuffer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mThreadsMutex);
+        std::unique_ptr<ThreadBuffer>& buffer = mThreads.emplace_back(std::make_unique<ThreadBuffer>());
+        buffer->threadId = static_cast<uint32_t>(mThreads.size() - 1);
+        buffer->name = "Thread " + std::to_string(buffer->threadId);
+        sThreadBuffer = buffer.get();
+        sThreadGeneration = mGeneration;
+    }
+    return static_cast<ThreadBuffer*>(sThreadBuffer);
+}
+
+void Profiler::CopyEvents(const ThreadBuffer& buffer, uint64_t start, uint64_t end, std::vector<Event>& events) const
+{
+    const uint64_t written = buffer.written.load(std::memory_order_acquire);
+    const uint64_t first = (written > EventCapacity) ? written - EventCapacity : 0;
+    const size_t firstCopied = events.size();
+    std::vector<uint64_t> indices;
+    for (uint64_t i = first; i < written; ++i)
+    {
+        const ThreadBuffer::Slot& slot = buffer.slots[i % EventCapacity];
+        Event event;
+        event.start = slot.start.load(std::memory_order_relaxed);
+        event.end = slot.end.load(std::memory_order_relaxed);
+        if (event.end >= start && event.start <= end)
+        {
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.depth = slot.depth.load(std::memory_order_relaxed);
+            events.push_back(event);
+            indices.push_back(i);
+        }
+    }
+
+    // Slots the owner reused while they were being copied may be half written, drop them. That includes the
+    // slot it may be writing right now, which isn't counted in written yet
+    const uint64_t writtenAfter = buffer.written.load(std::memory_order_acquire) + 1;
+    const uint64_t firstIntact = (writtenAfter > EventCapacity) ? writtenAfter - EventCapacity : 0;
+    const size_t overwritten = std::lower_bound(indices.begin(), indices.end(), firstIntact) - indices.begin();
+    events.erase(events.begin() + firstCopied, events.begin() + firstCopied + overwritten);
+}
+
+ProfileScope::ProfileScope(const char* name)
+{
+    Profiler* profiler = sProfiler.get();
+    if (profiler != nullptr && !profiler->IsPaused())
+    {
+        mBuffer = profiler->GetThreadBuffer();
+        mName = name;
+        ++mBuffer->depth;
+        mStart = Profiler::GetTimestamp();
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (mBuffer != nullptr)
+    {
+        const uint64_t end = Profiler::GetTimestamp();
+        const uint32_t depth = --mBuffer->depth;
+        const uint64_t index = mBuffer->written.load(std::memory_order_relaxed);
+        Profiler::ThreadBuffer::Slot& slot = mBuffer->slots[index % Profiler::EventCapacity];
+        slot.name.store(mName, std::memory_order_relaxed);
+        slot.start.store(mStart, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        slot.depth.store(depth, std::memory_order_relaxed);
+        mBuffer->written.store(index + 1, std::memory_order_release);
+    }
+}
\ No newline at end of file
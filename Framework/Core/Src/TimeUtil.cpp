@@ -4,22 +4,111 @@
 using namespace IExeEngine;
 using namespace IExeEngine::Core;
 
-float TimeUtil::GetTime()
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace
 {
-	static const auto startTime = std::chrono::high_resolution_clock::now();
-	const auto currentTime = std::chrono::high_resolution_clock::now();
-	const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - startTime).count();
+	using Clock = std::chrono::steady_clock;
+
+	// Function static so LOG calls made during static initialization still get a valid start time
+	Clock::time_point GetStartTime()
+	{
+		static const Clock::time_point startTime = Clock::now();
+		return startTime;
+	}
+
+	// High resolution timers wake up within a few hundred microseconds, the rest is spun out to hit the deadline
+	constexpr uint64_t SpinThreshold = 250'000;
+	// Plain Sleep(1) can overshoot by a whole scheduler tick, so the fallback only sleeps while a couple of milliseconds remain
+	constexpr uint64_t SleepThreshold = 2'000'000;
+
+	class SleepTimer
+	{
+	public:
+		SleepTimer()
+			: mHandle(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS))
+		{
+		}
+
+		~SleepTimer()
+		{
+			if (mHandle != nullptr)
+			{
+				CloseHandle(mHandle);
+			}
+		}
+
+		// Returns false when the high resolution timer is unavailable (pre 1803 Windows 10)
+		bool Wait(uint64_t nanoseconds)
+		{
+			if (mHandle == nullptr)
+			{
+				return false;
+			}
+
+			// Negative due times are relative, in 100ns units
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -static_cast<LONGLONG>(nanoseconds / 100);
+			if (!SetWaitableTimerEx(mHandle, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+			{
+				return false;
+			}
+			WaitForSingleObject(mHandle, INFINITE);
+			return true;
+		}
+
+	private:
+		HANDLE mHandle = nullptr;
+	};
+}
 
-	return milliseconds / 1000.0f;
+float TimeUtil::GetTime()
+{
+	const auto elapsed = Clock::now() - GetStartTime();
+	return std::chrono::duration<float>(elapsed).count();
 }
 
 float TimeUtil::GetDeltaTime()
 {
-	static auto lastCallTime = std::chrono::high_resolution_clock::now();
-	const auto currentTime = std::chrono::high_resolution_clock::now();
-	const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastCallTime).count();
+	static auto lastCallTime = Clock::now();
+	const auto currentTime = Clock::now();
+	const auto elapsed = currentTime - lastCallTime;
 
 	lastCallTime = currentTime;
 
-	return milliseconds / 1000.0f;
+	return std::chrono::duration<float>(elapsed).count();
+}
+
+uint64_t TimeUtil::GetTimeNanoseconds()
+{
+	const auto elapsed = Clock::now() - GetStartTime();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void TimeUtil::SleepUntil(uint64_t deadline)
+{
+	thread_local SleepTimer timer;
+
+	uint64_t now = GetTimeNanoseconds();
+	while (now + SpinThreshold < deadline)
+	{
+		const uint64_t remaining = deadline - now;
+		if (!timer.Wait(remaining - SpinThreshold))
+		{
+			if (remaining < SleepThreshold)
+			{
+				break;
+			}
+			Sleep(1);
+		}
+		now = GetTimeNanoseconds();
+	}
+
+	while (now < deadline)
+	{
+		std::this_thread::yield();
+		now = GetTimeNanoseconds();
+	}
 }
@@ -5,18 +5,42 @@
 
 namespace IExeEngine::Graphics
 {
+    // Remembers the last keyframe used by each track so forward playback doesn't search from the start
+    struct AnimationCursor
+    {
+        uint32_t positionKey = 0;
+        uint32_t rotationKey = 0;
+        uint32_t scaleKey = 0;
+    };
+
     class Animation
     {
     public:
         Transform GetTransform(float time) const;
+        Transform GetTransform(float time, AnimationCursor& cursor) const;
         float GetDuration() const;
 
         void PlayEvents(float prevTime, float curTime);
 
+        // Position and rotation keys are empty once the animation is quantized
+        const PositionKeys& GetPositionKeys() const;
+        const RotationKeys& GetRotationKeys() const;
+        const ScaleKeys& GetScaleKeys() const;
+
+        // Replaces the position and rotation keys with their 48 bit packed form, sampling decodes them on the fly
+        void Quantize();
+        bool IsQuantized() const;
+
+        // Bytes used by the key arrays, for compression reports
+        size_t GetKeyDataSize() const;
+
     private:
-        Math::Vector3 GetPosition(float time) const;
-        Math::Quaternion GetRotation(float time) const;
-        Math::Vector3 GetScale(float time) const;
+        Math::Vector3 GetPosition(float time, uint32_t& cursor) const;
+        Math::Quaternion GetRotation(float time, uint32_t& cursor) const;
+        Math::Vector3 GetScale(float time, uint32_t& cursor) const;
+
+        PositionKeys GetDecodedPositionKeys() const;
+        RotationKeys GetDecodedRotationKeys() const;
 
         friend class AnimationBuilder;
         friend class AnimationIO; // Forward declaration to allow access to private members "Worry about it later"
@@ -26,5 +50,10 @@ namespace IExeEngine::Graphics
         ScaleKeys mScaleKeys;
         EventKeys mEventKeys;
         float mDuration = 0.0f;
+
+        PackedPositionKeys mPackedPositionKeys;
+        PackedRotationKeys mPackedRotationKeys;
+        Math::Vector3 mPositionMin = Math::Vector3::Zero;
+        Math::Vector3 mPositionExtent = Math::Vector3::Zero;
     };
 }
\ No newline at end of file
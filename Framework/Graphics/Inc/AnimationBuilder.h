@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Animation.h"
+#include "CompiledAnimationClip.h"
 
 namespace IExeEngine::Graphics
 {
@@ -15,6 +16,16 @@ namespace IExeEngine::Graphics
 
         [[nodiscard]] Animation Build();
 
+        static constexpr float MaxSamplesPerSecond = 240.0f;
+        // Largest difference from the authored tracks a compiled clip may have, see CompiledAnimationClip::GetMaxError
+        static constexpr float CompileTolerance = 1e-3f;
+
+        // Resamples every bone track of an authored clip into the structure-of-arrays runtime form. The rate starts at
+        // the spacing of the closest keys so each key can land on a frame, and doubles until the result matches the
+        // authored tracks within CompileTolerance at every key and between frames. Empty if even MaxSamplesPerSecond
+        // doesn't, the clip then plays from its authored tracks
+        [[nodiscard]] static CompiledAnimationClip Build(const AnimationClip& clip);
+
     private:
         Animation mWorkingCopy;
     };
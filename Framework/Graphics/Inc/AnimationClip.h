@@ -1,14 +1,22 @@
 #pragma once
 
 #include "Animation.h"
+#include "CompiledAnimationClip.h"
 
 namespace IExeEngine::Graphics
 {
+	using AnimationCursors = std::vector<AnimationCursor>;
+
 	struct AnimationClip
 	{
 		std::string name;
 		float tickDuration = 0.0f;
 		float ticksPerSecond = 0.0f;
 		std::vector<std::unique_ptr<Animation>> boneAnimations;
+		CompiledAnimationClip compiled; // Empty until built with AnimationBuilder::Build(clip), or if it can't match the tracks
+
+		// Samples every bone track at tick in a single pass, cursors and transforms are resized to the bone count
+		// Bones without an animation track are left untouched
+		void SampleBoneTransforms(float tick, AnimationCursors& cursors, std::vector<Transform>& transforms) const;
 	};
 }
\ No newline at end of file
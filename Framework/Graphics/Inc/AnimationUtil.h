@@ -16,4 +16,10 @@ namespace IExeEngine::Graphics::AnimationUtil
 
     // To be called to apply bone offsets for skinning data
     void ApplyBoneOffsets(ModelId modelId, BoneTransforms& boneTransforms);
+
+    // ComputeBoneTransforms and ApplyBoneOffsets in one pass, boneTransforms receives the model space pose
+    void ComputeSkinningTransforms(ModelId modelId, BoneTransforms& boneTransforms, BoneTransforms& skinningTransforms, const Animator* animator = nullptr);
+    // Same into caller owned arrays (e.g. frame memory) of boneCount matrices. Bones from boneCount on are skipped and
+    // read as the identity by their children, the arrays must start out as identities for that
+    void ComputeSkinningTransforms(ModelId modelId, Math::Matrix4* boneTransforms, Math::Matrix4* skinningTransforms, size_t boneCount, const Animator* animator = nullptr);
 }
\ No newline at end of file
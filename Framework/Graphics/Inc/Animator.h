@@ -1,26 +1,96 @@
 #pragma once
 
 #include "ModelManager.h"
+#include "BoneMask.h"
 
 namespace IExeEngine::Graphics
 {
 	struct Bone;
 
+	enum class AnimationBlendMode
+	{
+		Override,	// Blends towards the layer pose by weight
+		Additive	// Adds the layer's motion relative to its first frame on top of the layers below
+	};
+
 	class Animator
 	{
 	public:
+		// Layer 0 is the base layer driven by PlayAnimation/CrossFade, the others are blended on top in order
+		static constexpr uint32_t MaxLayers = 4;
+
 		void Initialize(ModelId id);
 		void PlayAnimation(int clipIndex, bool looping);
+		// Fades the base layer from the current pose into clipIndex over fadeDuration seconds
+		void CrossFade(int clipIndex, bool looping, float fadeDuration);
 		void Update(float deltaTime);
 
+		// The mask must outlive the layer, null applies the layer to every bone
+		void SetLayer(uint32_t layerIndex, int clipIndex, bool looping, float weight,
+			AnimationBlendMode blendMode = AnimationBlendMode::Override, const BoneMask* boneMask = nullptr);
+		void SetLayerWeight(uint32_t layerIndex, float weight);
+		void ClearLayer(uint32_t layerIndex);
+
 		bool IsFinished() const;
 		size_t GetAnimationCount() const;
 		bool GetToParentTransform(const Bone* bone, Math::Matrix4& transform) const;
+		bool GetToParentTransform(int boneIndex, Math::Matrix4& transform) const;
 
 	private:
+		struct Layer
+		{
+			int clipIndex = -1;
+			float tick = 0.0f;
+			bool isLooping = false;
+			float weight = 1.0f;
+			AnimationBlendMode blendMode = AnimationBlendMode::Override;
+			const BoneMask* boneMask = nullptr;
+		};
+
+		// One sampled pose per clip, shared by every layer playing that clip at the same tick
+		struct CachedPose
+		{
+			int clipIndex = -1;
+			float tick = 0.0f;
+			uint64_t frame = 0;
+			AnimationCursors cursors;
+			std::vector<Transform> pose;
+			std::vector<Transform> referencePose; // First frame of the clip, used by additive layers
+			bool hasReferencePose = false;
+		};
+
+		// Samples the current clip at the playhead into the cached pose
+		void SamplePose(const AnimationClip& animClip);
+		// Picks the fast single clip path or the layer blend
+		void EvaluatePose(const Model& model);
+		// Blends the fade and every active layer into the local pose
+		void BlendLayers(const Model& model);
+		// Returns the pose of clipIndex at tick, only sampling when no cache entry holds it yet
+		const CachedPose& GetCachedPose(const Model& model, int clipIndex, float tick, bool needsReferencePose);
+		// Stores the base layer blended with the running fade, so a new fade starts from what is on screen
+		void FreezeFadePose(const Model& model);
+		void AdvanceLayer(const Model& model, Layer& layer, float deltaTime) const;
+		void ResetBoneAnimatedFlags(const AnimationClip& animClip);
+		bool IsBlending() const;
+
 		ModelId mModelId = 0;
-		int mClipIndex = -1;
-		float mAnimationTick = 0.0f;
-		bool mIsLooping = false;
+		Layer mLayers[MaxLayers];
+		Layer mFadeLayer; // Outgoing base layer during a cross-fade
+		float mFadeTime = 0.0f;
+		float mFadeDuration = 0.0f;
+		std::vector<Transform> mFadePose; // Fades out instead of the fade layer's clip when a fade was interrupted
+		bool mIsFadePoseFrozen = false;
+
+		CachedPose mPoseCache[MaxLayers + 1];
+		AnimationCursors mReferenceCursors; // Scratch for sampling reference poses, kept to reuse its storage
+		uint64_t mFrame = 0;
+		std::vector<Transform> mBindPose;
+		std::vector<Transform> mBlendedPose;
+		bool mIsPoseBlended = false;
+
+		AnimationCursors mCursors;
+		std::vector<Transform> mPose;
+		std::vector<Math::Matrix4> mToParentTransforms;
+		std::vector<bool> mIsBoneAnimated;
 	};
 }
\ No newline at end of file
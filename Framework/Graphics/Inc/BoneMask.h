@@ -0,0 +1,23 @@
+#pragma once
+
+namespace IExeEngine::Graphics
+{
+    struct Skeleton;
+
+    // Per-bone layer weights, 0 leaves the bone to the layers below and 1 gives it fully to the masked layer
+    class BoneMask
+    {
+    public:
+        void Initialize(const Skeleton& skeleton, float weight = 0.0f);
+
+        // Sets the weight of the named bone, and of everything below it when includeChildren is set
+        bool SetBoneWeight(const Skeleton& skeleton, const std::string& boneName, float weight, bool includeChildren = true);
+        void SetBoneWeight(const Skeleton& skeleton, int boneIndex, float weight, bool includeChildren = true);
+
+        float GetWeight(size_t boneIndex) const;
+        size_t GetBoneCount() const;
+
+    private:
+        std::vector<float> mWeights;
+    };
+}
\ No newline at end of file
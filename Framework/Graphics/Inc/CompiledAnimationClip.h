@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Transform.h"
+
+namespace IExeEngine::Graphics
+{
+    struct AnimationClip;
+
+    // Runtime form of an AnimationClip, every bone track is resampled at a fixed rate and stored
+    // structure-of-arrays: each frame holds one contiguous array per channel component across all bones
+    // (px.., py.., pz.., rx.., ry.., rz.., rw.., sx.., sy.., sz..) so a pose is evaluated several bones per instruction
+    class CompiledAnimationClip
+    {
+    public:
+        static constexpr uint32_t ComponentCount = 10;
+
+        void Compile(const AnimationClip& clip, float samplesPerSecond);
+
+        // Evaluates the pose at tick and writes the to-parent matrix of every animated bone
+        // Bones without an animation track are left untouched, toParentTransforms must hold at least GetBoneCount() matrices
+        void Evaluate(float tick, std::vector<Math::Matrix4>& toParentTransforms) const;
+
+        // Largest difference from the authored tracks of clip at the given ticks, taken over the to-parent matrix
+        // elements of every animated bone and relative to the authored value once it is past 1
+        float GetMaxError(const AnimationClip& clip, const std::vector<float>& ticks) const;
+
+        bool IsBoneAnimated(uint32_t boneIndex) const;
+        uint32_t GetBoneCount() const;
+        uint32_t GetFrameCount() const;
+
+    private:
+        std::vector<float> mSamples;
+        std::vector<uint8_t> mIsBoneAnimated;
+        uint32_t mBoneCount = 0;
+        uint32_t mLaneBoneCount = 0; // Bone count padded to the SIMD width
+        uint32_t mFrameCount = 0;
+        float mFramesPerTick = 0.0f;
+    };
+}
\ No newline at end of file
@@ -17,4 +17,11 @@ namespace IExeEngine::Graphics::DebugUI
 
 	void BeginRender();
 	void EndRender();
+
+	// Frame timeline and scope totals from the Core::Profiler, call between BeginRender and EndRender
+	void ShowProfiler();
+
+	// Heap use per Core::MemoryTag, allocations per frame, sampled call sites, and the live, peak, reserved and
+	// fragmentation of every allocator in the Core::AllocatorRegistry
+	void ShowMemory();
 }
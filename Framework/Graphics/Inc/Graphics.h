@@ -68,6 +68,8 @@
 
 #include "Keyframe.h"
 
+#include "KeyframeCompression.h"
+
 #include "Animation.h"
 
 #include "AnimationBuilder.h"
@@ -80,6 +82,10 @@
 
 #include "AnimationClip.h"
 
+#include "CompiledAnimationClip.h"
+
+#include "BoneMask.h"
+
 #include "Animator.h"
 
 #include "ParticleSystemEffect.h"
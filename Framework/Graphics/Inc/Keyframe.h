@@ -27,4 +27,18 @@ namespace IExeEngine::Graphics
     using ScaleKeys = Keyframes<Math::Vector3>;
 
     using EventKeys = Keyframes<AnimationCallback>;
+
+    // Quantized key values written by the ModelImporter compression stage, see KeyframeCompression.h
+    struct PackedVector3
+    {
+        uint16_t data[3] = {};
+    };
+
+    struct PackedQuaternion
+    {
+        uint16_t data[3] = {};
+    };
+
+    using PackedPositionKeys = Keyframes<PackedVector3>;
+    using PackedRotationKeys = Keyframes<PackedQuaternion>;
 }
\ No newline at end of file
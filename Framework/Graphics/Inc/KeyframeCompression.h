@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Keyframe.h"
+
+namespace IExeEngine::Graphics::KeyframeCompression
+{
+    // Smallest-three encoding in 48 bits: the index of the largest component in 2 bits
+    // and the other three components in 15 bits each, the largest is rebuilt from the unit length
+    PackedQuaternion PackQuaternion(const Math::Quaternion& q);
+    Math::Quaternion UnpackQuaternion(const PackedQuaternion& packed);
+
+    // 16 bits per component relative to the track's range, extent is max - min
+    PackedVector3 PackVector3(const Math::Vector3& v, const Math::Vector3& min, const Math::Vector3& extent);
+    Math::Vector3 UnpackVector3(const PackedVector3& packed, const Math::Vector3& min, const Math::Vector3& extent);
+}
\ No newline at end of file
@@ -11,6 +11,10 @@ namespace IExeEngine::Graphics
     public:
         static void Write(FILE* file, const Animation& animation);
         static void Read(FILE* file, Animation& animation);
+
+        // Binary keyframe blocks, ReadBinary returns the position after the animation or nullptr if the data is truncated
+        static void WriteBinary(FILE* file, const Animation& animation);
+        static const uint8_t* ReadBinary(const uint8_t* data, const uint8_t* end, Animation& animation);
     };
 
     namespace ModelIO
@@ -26,5 +30,20 @@ namespace IExeEngine::Graphics
 
         void SaveAnimation(std::filesystem::path filePath, Model& model);
         void LoadAnimation(std::filesystem::path filePath, Model& model);
+
+        // Versioned binary containers (.bmodel, .bskeleton, .banimset) written next to the text files
+        // The loaders map the file into memory and copy whole vertex/index/key blocks,
+        // they return false when the file is missing or invalid so the text path can be used instead
+        constexpr uint32_t BinaryMagic = 0x42584549; // "IEXB"
+        constexpr uint16_t BinaryVersion = 2; // 2: animations can store quantized position/rotation keys
+
+        void SaveModelBinary(std::filesystem::path filePath, const Model& model);
+        bool LoadModelBinary(std::filesystem::path filePath, Model& model);
+
+        void SaveSkeletonBinary(std::filesystem::path filePath, const Model& model);
+        bool LoadSkeletonBinary(std::filesystem::path filePath, Model& model);
+
+        void SaveAnimationBinary(std::filesystem::path filePath, const Model& model);
+        bool LoadAnimationBinary(std::filesystem::path filePath, Model& model);
     }
 }
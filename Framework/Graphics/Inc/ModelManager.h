@@ -22,6 +22,8 @@ namespace IExeEngine::Graphics
         ModelManager& operator=(const ModelManager&&) = delete;
 
         void SetRootDirectory(const std::filesystem::path& rootPath);
+        // When disabled only the text .model/.skeleton/.animset files are read (debug fallback)
+        void SetUseBinary(bool useBinary);
         ModelId GetModelId(const std::filesystem::path& filePath);
         ModelId LoadModel(const std::filesystem::path& filePath);
 
@@ -34,5 +36,6 @@ namespace IExeEngine::Graphics
         Inventory mInventory;
 
         std::filesystem::path mRootDirectory;
+        bool mUseBinary = true;
     };
 }
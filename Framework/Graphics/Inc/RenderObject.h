@@ -40,5 +40,6 @@ namespace IExeEngine::Graphics
 
         const Skeleton* skeleton = nullptr; // Skeleton for animation
         const Animator* animator = nullptr; // Animator for animation
+        const std::vector<Math::Matrix4>* skinningTransforms = nullptr; // Precomputed bone palette, built from the animator when null
     };
 }
\ No newline at end of file
@@ -8,5 +8,15 @@ namespace IExeEngine::Graphics
     {
         Bone* root = nullptr;
         std::vector<std::unique_ptr<Bone>> bones;
+
+        // Flat copy of the hierarchy for pose evaluation, sorted so parents always come before their children
+        // Each array is indexed by sorted position, call BuildFlatHierarchy again after editing the bones
+        std::vector<int> sortedBoneIndices;
+        std::vector<int> sortedParentIndices; // Bone index of the parent, -1 for roots
+        std::vector<Math::Matrix4> sortedToParentTransforms;
+        std::vector<Math::Matrix4> sortedOffsetTransforms;
+
+        // False if the bones aren't a tree: a bone reached twice, a child index out of range or a bone no root reaches
+        bool BuildFlatHierarchy();
     };
-}
+}
\ No newline at end of file
@@ -9,13 +9,37 @@ namespace IExeEngine::Graphics
         Math::Vector3 scale = Math::Vector3::One;
 
         Math::Matrix4 GetMatrix4() const
-        {   
-            // S * R * P
+        {
+            // S * R * P, written out since scaling and translating the rotation rows needs no multiplies
+            const Math::Matrix4 r = Math::Matrix4::MatrixRotationQuaternion(rotation);
             return {
-                Math::Matrix4::Scaling(scale) *
-                Math::Matrix4::MatrixRotationQuaternion(rotation) *
-                Math::Matrix4::Translation(position)
+                r._11 * scale.x, r._12 * scale.x, r._13 * scale.x, 0.0f,
+                r._21 * scale.y, r._22 * scale.y, r._23 * scale.y, 0.0f,
+                r._31 * scale.z, r._32 * scale.z, r._33 * scale.z, 0.0f,
+                position.x, position.y, position.z, 1.0f
             };
         }
+
+        // Chains this (child) transform under parent, matching GetMatrix4() * parent.GetMatrix4() without building either matrix.
+        // Exact when the parent scale is uniform, a non-uniform parent scale under a rotated child would need shear and is dropped
+        Transform operator*(const Transform& parent) const
+        {
+            Transform result;
+            const Math::Vector3 scaledPosition = { position.x * parent.scale.x, position.y * parent.scale.y, position.z * parent.scale.z };
+            result.position = Math::Rotate(scaledPosition, parent.rotation) + parent.position;
+            result.rotation = parent.rotation * rotation;
+            result.scale = { scale.x * parent.scale.x, scale.y * parent.scale.y, scale.z * parent.scale.z };
+            return result;
+        }
     };
+
+    // Blends position and scale linearly and rotation along the shortest arc, for drawing between two simulation states
+    inline Transform Lerp(const Transform& a, const Transform& b, float t)
+    {
+        Transform result;
+        result.position = Math::Lerp(a.position, b.position, t);
+        result.rotation = Math::Quaternion::Slerp(a.rotation, b.rotation, t);
+        result.scale = Math::Lerp(a.scale, b.scale, t);
+        return result;
+    }
 }
@@ -1,5 +1,6 @@
 #include  "Precompiled.h"
 #include "Animation.h"
+#include "KeyframeCompression.h"
 
 using namespace IExeEngine;
 using namespace IExeEngine::Graphics;
@@ -11,14 +12,65 @@ namespace
         float t = (time - startTime) / (endTime - startTime);
         return Math::Clamp(t, 0.0f, 1.0f);
     }
+
+    // Returns the index of the first key after time (at least 1), walking forward from the cursor
+    // when the playhead moved forward and falling back to a binary search when it didn't
+    template<class T>
+    uint32_t FindNextKey(const Keyframes<T>& keys, float time, uint32_t& cursor)
+    {
+        const uint32_t keyCount = static_cast<uint32_t>(keys.size());
+        if (cursor == 0 || cursor > keyCount || (cursor > 1 && time < keys[cursor - 1].time))
+        {
+            auto next = std::upper_bound(keys.begin(), keys.end(), time,
+                [](float t, const Keyframe<T>& keyframe) { return t < keyframe.time; });
+            cursor = Math::Max(static_cast<uint32_t>(std::distance(keys.begin(), next)), 1u);
+        }
+
+        while (cursor < keyCount && time >= keys[cursor].time)
+        {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    // Decode turns a stored key into its value, so packed and plain tracks share the same lookup
+    template<class T, class Decode, class Interpolate>
+    auto SampleKeys(const Keyframes<T>& keys, float time, uint32_t& cursor, Decode decode, Interpolate interpolate)
+    {
+        const uint32_t next = FindNextKey(keys, time, cursor);
+        if (next >= keys.size())
+        {
+            return decode(keys.back().key); // Past the last keyframe
+        }
+
+        float t = GetLerpTime(keys[next - 1].time, keys[next].time, time);
+        return interpolate(decode(keys[next - 1].key), decode(keys[next].key), t);
+    }
+
+    template<class T>
+    T Identity(const T& value)
+    {
+        return value;
+    }
+
+    Math::Vector3 LerpVector3(const Math::Vector3& a, const Math::Vector3& b, float t)
+    {
+        return Math::Lerp(a, b, t);
+    }
 }
 
 Transform Animation::GetTransform(float time) const
+{
+    AnimationCursor cursor;
+    return GetTransform(time, cursor);
+}
+
+Transform Animation::GetTransform(float time, AnimationCursor& cursor) const
 {
     Transform transform;
-    transform.position = GetPosition(time);
-    transform.rotation = GetRotation(time);
-    transform.scale = GetScale(time);
+    transform.position = GetPosition(time, cursor.positionKey);
+    transform.rotation = GetRotation(time, cursor.rotationKey);
+    transform.scale = GetScale(time, cursor.scaleKey);
 
     return transform;
 }
@@ -39,56 +91,143 @@ void Animation::PlayEvents(float prevTime, float curTime)
     }
 }
 
-Math::Vector3 Animation::GetPosition(float time) const
+const PositionKeys& Animation::GetPositionKeys() const
 {
-    if (mPositionKeys.empty())
+    return mPositionKeys;
+}
+
+const RotationKeys& Animation::GetRotationKeys() const
+{
+    return mRotationKeys;
+}
+
+const ScaleKeys& Animation::GetScaleKeys() const
+{
+    return mScaleKeys;
+}
+
+void Animation::Quantize()
+{
+    if (IsQuantized())
     {
-        return Math::Vector3::Zero;
+        return;
     }
 
-    for (uint32_t i = 1; i < mPositionKeys.size(); ++i)
+    // Positions are stored relative to the range of the track
+    if (!mPositionKeys.empty())
     {
-        if (time < mPositionKeys[i].time) // Greater than previous keyframe time and less than current keyframe time
+        Math::Vector3 max = mPositionKeys.front().key;
+        mPositionMin = max;
+        for (const auto& key : mPositionKeys)
         {
-            float t = GetLerpTime(mPositionKeys[i - 1].time, mPositionKeys[i].time, time);
-            return Math::Lerp(mPositionKeys[i - 1].key, mPositionKeys[i].key, t);
+            mPositionMin = { Math::Min(mPositionMin.x, key.key.x), Math::Min(mPositionMin.y, key.key.y), Math::Min(mPositionMin.z, key.key.z) };
+            max = { Math::Max(max.x, key.key.x), Math::Max(max.y, key.key.y), Math::Max(max.z, key.key.z) };
         }
+        mPositionExtent = max - mPositionMin;
+    }
+
+    mPackedPositionKeys.reserve(mPositionKeys.size());
+    for (const auto& key : mPositionKeys)
+    {
+        mPackedPositionKeys.emplace_back(KeyframeCompression::PackVector3(key.key, mPositionMin, mPositionExtent), key.time);
+    }
+    mPackedRotationKeys.reserve(mRotationKeys.size());
+    for (const auto& key : mRotationKeys)
+    {
+        mPackedRotationKeys.emplace_back(KeyframeCompression::PackQuaternion(key.key), key.time);
+    }
+
+    mPositionKeys = PositionKeys();
+    mRotationKeys = RotationKeys();
+}
+
+bool Animation::IsQuantized() const
+{
+    return !mPackedPositionKeys.empty() || !mPackedRotationKeys.empty();
+}
+
+size_t Animation::GetKeyDataSize() const
+{
+    size_t size = mPositionKeys.size() * sizeof(PositionKeys::value_type)
+        + mRotationKeys.size() * sizeof(RotationKeys::value_type)
+        + mScaleKeys.size() * sizeof(ScaleKeys::value_type)
+        + mPackedPositionKeys.size() * sizeof(PackedPositionKeys::value_type)
+        + mPackedRotationKeys.size() * sizeof(PackedRotationKeys::value_type);
+    if (!mPackedPositionKeys.empty())
+    {
+        size += sizeof(mPositionMin) + sizeof(mPositionExtent);
     }
-    return mPositionKeys.back().key; // Return last keyframe position
+    return size;
 }
 
-Math::Quaternion Animation::GetRotation(float time) const
+Math::Vector3 Animation::GetPosition(float time, uint32_t& cursor) const
 {
-    if (mRotationKeys.empty())
+    if (!mPackedPositionKeys.empty())
     {
-        return Math::Quaternion::Identity;
+        return SampleKeys(mPackedPositionKeys, time, cursor,
+            [this](const PackedVector3& packed) { return KeyframeCompression::UnpackVector3(packed, mPositionMin, mPositionExtent); },
+            LerpVector3);
     }
+    if (mPositionKeys.empty())
+    {
+        return Math::Vector3::Zero;
+    }
+
+    return SampleKeys(mPositionKeys, time, cursor, Identity<Math::Vector3>, LerpVector3);
+}
 
-    for (uint32_t i = 1; i < mRotationKeys.size(); ++i)
+Math::Quaternion Animation::GetRotation(float time, uint32_t& cursor) const
+{
+    if (!mPackedRotationKeys.empty())
     {
-        if (time < mRotationKeys[i].time) // Greater than previous keyframe time and less than current keyframe time
-        {
-            float t = GetLerpTime(mRotationKeys[i - 1].time, mRotationKeys[i].time, time);
-            return Math::Quaternion::Slerp(mRotationKeys[i - 1].key, mRotationKeys[i].key, t);
-        }
+        return SampleKeys(mPackedRotationKeys, time, cursor, KeyframeCompression::UnpackQuaternion, Math::Quaternion::Slerp);
+    }
+    if (mRotationKeys.empty())
+    {
+        return Math::Quaternion::Identity;
     }
-    return mRotationKeys.back().key; // Return last keyframe rotation
+
+    return SampleKeys(mRotationKeys, time, cursor, Identity<Math::Quaternion>, Math::Quaternion::Slerp);
 }
 
-Math::Vector3 Animation::GetScale(float time) const
+Math::Vector3 Animation::GetScale(float time, uint32_t& cursor) const
 {
     if (mScaleKeys.empty())
     {
         return Math::Vector3::One;
     }
 
-    for (uint32_t i = 1; i < mScaleKeys.size(); ++i)
+    return SampleKeys(mScaleKeys, time, cursor, Identity<Math::Vector3>, LerpVector3);
+}
+
+PositionKeys Animation::GetDecodedPositionKeys() const
+{
+    if (mPackedPositionKeys.empty())
     {
-        if (time < mScaleKeys[i].time) // Greater than previous keyframe time and less than current keyframe time
-        {
-            float t = GetLerpTime(mScaleKeys[i - 1].time, mScaleKeys[i].time, time);
-            return Math::Lerp(mScaleKeys[i - 1].key, mScaleKeys[i].key, t);
-        }
+        return mPositionKeys;
+    }
+
+    PositionKeys keys;
+    keys.reserve(mPackedPositionKeys.size());
+    for (const auto& key : mPackedPositionKeys)
+    {
+        keys.emplace_back(KeyframeCompression::UnpackVector3(key.key, mPositionMin, mPositionExtent), key.time);
+    }
+    return keys;
+}
+
+RotationKeys Animation::GetDecodedRotationKeys() const
+{
+    if (mPackedRotationKeys.empty())
+    {
+        return mRotationKeys;
+    }
+
+    RotationKeys keys;
+    keys.reserve(mPackedRotationKeys.size());
+    for (const auto& key : mPackedRotationKeys)
+    {
+        keys.emplace_back(KeyframeCompression::UnpackQuaternion(key.key), key.time);
     }
-    return mScaleKeys.back().key; // Return last keyframe scale
+    return keys;
 }
\ No newline at end of file
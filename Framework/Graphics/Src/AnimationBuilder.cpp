@@ -1,6 +1,8 @@
 #include "Precompiled.h"
 #include "AnimationBuilder.h"
 
+#include "AnimationClip.h"
+
 using namespace IExeEngine;
 using namespace IExeEngine::Graphics;
 
@@ -12,6 +14,15 @@ namespace
         ASSERT(keyframes.empty() || keyframes.back().time <= t, "AnimaionBuilder: Can't add keyframe with time less than previous keyframe time.");
         keyframes.emplace_back(value, t);
     }
+
+    template<class T>
+    void AppendKeyTimes(const Keyframes<T>& keyframes, std::vector<float>& times)
+    {
+        for (const Keyframe<T>& keyframe : keyframes)
+        {
+            times.push_back(keyframe.time);
+        }
+    }
 }
 
 AnimationBuilder& AnimationBuilder::AddPositionKey(const Math::Vector3& position, float time)
@@ -52,3 +63,63 @@ Animation AnimationBuilder::Build()
 
     return std::move(mWorkingCopy);
 }
+
+CompiledAnimationClip AnimationBuilder::Build(const AnimationClip& clip)
+{
+    std::vector<float> keyTicks;
+    for (const std::unique_ptr<Animation>& animation : clip.boneAnimations)
+    {
+        if (animation != nullptr)
+        {
+            AppendKeyTimes(animation->mPositionKeys, keyTicks);
+            AppendKeyTimes(animation->mPackedPositionKeys, keyTicks);
+            AppendKeyTimes(animation->mRotationKeys, keyTicks);
+            AppendKeyTimes(animation->mPackedRotationKeys, keyTicks);
+            AppendKeyTimes(animation->mScaleKeys, keyTicks);
+        }
+    }
+    // Keys past the end can't be checked, playback never gets there
+    keyTicks.erase(std::remove_if(keyTicks.begin(), keyTicks.end(),
+        [&clip](float tick) { return tick < 0.0f || tick > clip.tickDuration; }), keyTicks.end());
+    std::sort(keyTicks.begin(), keyTicks.end());
+    keyTicks.erase(std::unique(keyTicks.begin(), keyTicks.end()), keyTicks.end());
+
+    // A clip without two distinct keys only needs its first and last frame
+    float keyGap = clip.tickDuration;
+    for (size_t i = 1; i < keyTicks.size(); ++i)
+    {
+        keyGap = Math::Min(keyGap, keyTicks[i] - keyTicks[i - 1]);
+    }
+    const float ticksPerSecond = (clip.ticksPerSecond > 0.0f) ? clip.ticksPerSecond : 1.0f;
+    float samplesPerSecond = (keyGap > 0.0f) ? Math::Min(ticksPerSecond / keyGap, MaxSamplesPerSecond) : 1.0f;
+
+    CompiledAnimationClip compiled;
+    std::vector<float> checkTicks;
+    while (true)
+    {
+        compiled.Compile(clip, samplesPerSecond);
+
+        // Frames hold exact samples, so the error shows at keys that fell between frames and where nlerp strays
+        // furthest from slerp, a quarter and three quarters of the way between frames
+        checkTicks = keyTicks;
+        const uint32_t frameCount = compiled.GetFrameCount();
+        const float ticksPerFrame = (frameCount > 1) ? clip.tickDuration / (frameCount - 1) : 0.0f;
+        for (uint32_t frame = 0; frame + 1 < frameCount; ++frame)
+        {
+            checkTicks.push_back((frame + 0.25f) * ticksPerFrame);
+            checkTicks.push_back((frame + 0.75f) * ticksPerFrame);
+        }
+        if (compiled.GetMaxError(clip, checkTicks) <= CompileTolerance)
+        {
+            return compiled;
+        }
+        if (samplesPerSecond >= MaxSamplesPerSecond)
+        {
+            break;
+        }
+        samplesPerSecond = Math::Min(samplesPerSecond * 2.0f, MaxSamplesPerSecond);
+    }
+
+    LOG_WARNING(Graphics, "AnimationBuilder: %s doesn't resample within tolerance, it plays from its authored tracks", clip.name.c_str());
+    return CompiledAnimationClip();
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include "Precompiled.h"
+#include "AnimationClip.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+void AnimationClip::SampleBoneTransforms(float tick, AnimationCursors& cursors, std::vector<Transform>& transforms) const
+{
+	const size_t boneCount = boneAnimations.size();
+	cursors.resize(boneCount);
+	transforms.resize(boneCount);
+	for (size_t i = 0; i < boneCount; ++i)
+	{
+		const Animation* animation = boneAnimations[i].get();
+		if (animation != nullptr)
+		{
+			transforms[i] = animation->GetTransform(tick, cursors[i]);
+		}
+	}
+}
\ No newline at end of file
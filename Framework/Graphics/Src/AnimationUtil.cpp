@@ -7,32 +7,29 @@
 using namespace IExeEngine;
 using namespace IExeEngine::Graphics;
 
-// Empty namespace for global helper functions isolated to the cpp file
 namespace
 {
-    void ComputeBoneTransformsRecursive(const Bone* bone, AnimationUtil::BoneTransforms& boneTransforms, const Animator* animator)
+    // Same walk as ComputeBoneTransforms, the offset is applied as soon as a bone is final
+    void ComputeSkinning(const Skeleton& skeleton, Math::Matrix4* boneTransforms, Math::Matrix4* skinningTransforms, size_t boneCount, const Animator* animator)
     {
-        if (bone != nullptr)
+        for (size_t i = 0; i < skeleton.sortedBoneIndices.size(); ++i)
         {
-            // Set the bone transform to the array of the matrices
-
-            // If no animator or the bone doesn't have an animated transform, use the regular toParentTransform, otherwise use the animaton
-            if (animator == nullptr || !animator->GetToParentTransform(bone, boneTransforms[bone->index]))
+            const int boneIndex = skeleton.sortedBoneIndices[i];
+            const int parentIndex = skeleton.sortedParentIndices[i];
+            if (static_cast<size_t>(boneIndex) >= boneCount)
             {
-                boneTransforms[bone->index] = bone->toParentTransform;
+                continue;
             }
-
-            // If there is a parent, apply the parent's transform too
-            if (bone->parent != nullptr)
+            Math::Matrix4& transform = boneTransforms[boneIndex];
+            if (animator == nullptr || !animator->GetToParentTransform(boneIndex, transform))
             {
-                boneTransforms[bone->index] = boneTransforms[bone->index] * boneTransforms[bone->parentIndex];
+                transform = skeleton.sortedToParentTransforms[i];
             }
-
-            // Go through the children and apply thier transforms 
-            for (const Bone* child : bone->children)
+            if (parentIndex >= 0 && static_cast<size_t>(parentIndex) < boneCount)
             {
-                ComputeBoneTransformsRecursive(child, boneTransforms, animator);
+                transform = Math::MultiplyAffine(transform, boneTransforms[parentIndex]);
             }
+            skinningTransforms[boneIndex] = Math::MultiplyAffine(skeleton.sortedOffsetTransforms[i], transform);
         }
     }
 }
@@ -42,11 +39,51 @@ void AnimationUtil::ComputeBoneTransforms(ModelId modelId, BoneTransforms& boneT
     const Model* model = ModelManager::Get()->GetModel(modelId);
     if (model != nullptr && model->skeleton != nullptr)
     {
+        const Skeleton& skeleton = *model->skeleton;
+
         // Resize to sync the number of bones with the matrices
-        boneTransforms.resize(model->skeleton->bones.size());
+        boneTransforms.resize(skeleton.bones.size());
+
+        // Bones are sorted parents first, so every parent is final by the time its children read it
+        for (size_t i = 0; i < skeleton.sortedBoneIndices.size(); ++i)
+        {
+            const int boneIndex = skeleton.sortedBoneIndices[i];
+            const int parentIndex = skeleton.sortedParentIndices[i];
+            Math::Matrix4& transform = boneTransforms[boneIndex];
+
+            // If no animator or the bone doesn't have an animated transform, use the regular toParentTransform, otherwise use the animaton
+            if (animator == nullptr || !animator->GetToParentTransform(boneIndex, transform))
+            {
+                transform = skeleton.sortedToParentTransforms[i];
+            }
+
+            // If there is a parent, apply the parent's transform too, bone transforms are always affine
+            if (parentIndex >= 0)
+            {
+                transform = Math::MultiplyAffine(transform, boneTransforms[parentIndex]);
+            }
+        }
+    }
+}
 
-        // Generate the matrices recursively starting from the root bone
-        ComputeBoneTransformsRecursive(model->skeleton->root, boneTransforms, animator);
+void AnimationUtil::ComputeSkinningTransforms(ModelId modelId, BoneTransforms& boneTransforms, BoneTransforms& skinningTransforms, const Animator* animator)
+{
+    const Model* model = ModelManager::Get()->GetModel(modelId);
+    if (model != nullptr && model->skeleton != nullptr)
+    {
+        const Skeleton& skeleton = *model->skeleton;
+        boneTransforms.resize(skeleton.bones.size());
+        skinningTransforms.resize(skeleton.bones.size());
+        ComputeSkinning(skeleton, boneTransforms.data(), skinningTransforms.data(), skeleton.bones.size(), animator);
+    }
+}
+
+void AnimationUtil::ComputeSkinningTransforms(ModelId modelId, Math::Matrix4* boneTransforms, Math::Matrix4* skinningTransforms, size_t boneCount, const Animator* animator)
+{
+    const Model* model = ModelManager::Get()->GetModel(modelId);
+    if (model != nullptr && model->skeleton != nullptr)
+    {
+        ComputeSkinning(*model->skeleton, boneTransforms, skinningTransforms, boneCount, animator);
     }
 }
 
@@ -77,11 +114,12 @@ void AnimationUtil::ApplyBoneOffsets(ModelId modelId, BoneTransforms& boneTransf
     const Model* model = ModelManager::Get()->GetModel(modelId);
     if (model != nullptr && model->skeleton != nullptr)
     {
-        // Iterate through the unique bone pointers to the bones in the skeleton
-        for (auto& bone : model->skeleton->bones)
+        const Skeleton& skeleton = *model->skeleton;
+        for (size_t i = 0; i < skeleton.sortedBoneIndices.size(); ++i)
         {
             // Apply the offset matrix to the computed bone transform
-            boneTransforms[bone->index] = bone->offsetTransform * boneTransforms[bone->index];
+            Math::Matrix4& transform = boneTransforms[skeleton.sortedBoneIndices[i]];
+            transform = Math::MultiplyAffine(skeleton.sortedOffsetTransforms[i], transform);
         }
     }
 }
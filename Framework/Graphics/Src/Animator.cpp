@@ -5,59 +5,238 @@
 using namespace IExeEngine;
 using namespace IExeEngine::Graphics;
 
+namespace
+{
+	// Normalized lerp along the shortest arc, close enough to slerp for per-frame blend weights
+	Math::Quaternion NLerp(const Math::Quaternion& q0, const Math::Quaternion& q1, float t)
+	{
+		const Math::Quaternion target = (q0.Dot(q1) < 0.0f) ? q1 * -1.0f : q1;
+		return Math::Quaternion::Normalize(Math::Quaternion::Lerp(q0, target, t));
+	}
+
+	void BlendTransform(Transform& result, const Transform& target, float weight)
+	{
+		result.position = Math::Lerp(result.position, target.position, weight);
+		result.rotation = NLerp(result.rotation, target.rotation, weight);
+		result.scale = Math::Lerp(result.scale, target.scale, weight);
+	}
+
+	// Applies the motion of pose relative to referencePose on top of result
+	void AddTransform(Transform& result, const Transform& pose, const Transform& referencePose, float weight)
+	{
+		result.position += (pose.position - referencePose.position) * weight;
+
+		const Math::Quaternion delta = pose.rotation * Math::Quaternion::Conjugate(referencePose.rotation);
+		result.rotation = Math::Quaternion::Normalize(NLerp(Math::Quaternion::Identity, delta, weight) * result.rotation);
+
+		result.scale.x *= Math::Lerp(1.0f, pose.scale.x / referencePose.scale.x, weight);
+		result.scale.y *= Math::Lerp(1.0f, pose.scale.y / referencePose.scale.y, weight);
+		result.scale.z *= Math::Lerp(1.0f, pose.scale.z / referencePose.scale.z, weight);
+	}
+
+	// Splits a S * R * T bone matrix back into its components
+	Transform Decompose(const Math::Matrix4& m)
+	{
+		Transform transform;
+		transform.position = { m._41, m._42, m._43 };
+		transform.scale = {
+			Math::Magnitude({ m._11, m._12, m._13 }),
+			Math::Magnitude({ m._21, m._22, m._23 }),
+			Math::Magnitude({ m._31, m._32, m._33 })
+		};
+
+		const float r11 = m._11 / transform.scale.x, r12 = m._12 / transform.scale.x, r13 = m._13 / transform.scale.x;
+		const float r21 = m._21 / transform.scale.y, r22 = m._22 / transform.scale.y, r23 = m._23 / transform.scale.y;
+		const float r31 = m._31 / transform.scale.z, r32 = m._32 / transform.scale.z, r33 = m._33 / transform.scale.z;
+
+		// Build from the largest component to stay stable near 180 degree rotations
+		Math::Quaternion& q = transform.rotation;
+		const float trace = r11 + r22 + r33;
+		if (trace > 0.0f)
+		{
+			const float s = sqrtf(trace + 1.0f) * 2.0f;
+			q = { (r23 - r32) / s, (r31 - r13) / s, (r12 - r21) / s, 0.25f * s };
+		}
+		else if (r11 > r22 && r11 > r33)
+		{
+			const float s = sqrtf(1.0f + r11 - r22 - r33) * 2.0f;
+			q = { 0.25f * s, (r12 + r21) / s, (r31 + r13) / s, (r23 - r32) / s };
+		}
+		else if (r22 > r33)
+		{
+			const float s = sqrtf(1.0f + r22 - r11 - r33) * 2.0f;
+			q = { (r12 + r21) / s, 0.25f * s, (r23 + r32) / s, (r31 - r13) / s };
+		}
+		else
+		{
+			const float s = sqrtf(1.0f + r33 - r11 - r22) * 2.0f;
+			q = { (r31 + r13) / s, (r23 + r32) / s, 0.25f * s, (r12 - r21) / s };
+		}
+		q = Math::Quaternion::Normalize(q);
+		return transform;
+	}
+}
+
 void Animator::Initialize(ModelId id)
 {
 	// Store model id
 	mModelId = id;
-	mIsLooping = false;
-	mAnimationTick = 0.0f;
-	// -1 means not animating
-	mClipIndex = -1;
+	for (Layer& layer : mLayers)
+	{
+		layer = Layer();
+	}
+	mFadeLayer = Layer();
+	mFadeTime = 0.0f;
+	mFadeDuration = 0.0f;
+	mFadePose.clear();
+	mIsFadePoseFrozen = false;
+	for (CachedPose& cachedPose : mPoseCache)
+	{
+		cachedPose.clipIndex = -1;
+		cachedPose.frame = 0;
+		cachedPose.hasReferencePose = false;
+	}
+	mFrame = 0;
+	mIsPoseBlended = false;
+	mCursors.clear();
+	mPose.clear();
+	mToParentTransforms.clear();
+	mIsBoneAnimated.clear();
+
+	// Blending needs a full local pose, bones without a track hold their bind transform
+	mBindPose.clear();
+	const Model* model = ModelManager::Get()->GetModel(mModelId);
+	if (model != nullptr && model->skeleton != nullptr)
+	{
+		mBindPose.reserve(model->skeleton->bones.size());
+		for (const auto& bone : model->skeleton->bones)
+		{
+			mBindPose.push_back(Decompose(bone->toParentTransform));
+		}
+	}
+	mBlendedPose = mBindPose;
 }
 
 // Reset animation, play new one
 void Animator::PlayAnimation(int clipIndex, bool looping)
 {
-	mClipIndex = clipIndex;
-	mIsLooping = looping;
-	mAnimationTick = 0.0f;
+	Layer& baseLayer = mLayers[0];
+	baseLayer.clipIndex = clipIndex;
+	baseLayer.isLooping = looping;
+	baseLayer.tick = 0.0f;
+	mFadeLayer.clipIndex = -1;
+	mIsFadePoseFrozen = false;
+
+	// Cursors belong to the previous clip's tracks, so start the new clip cold
+	mCursors.clear();
+	mIsBoneAnimated.clear();
+	if (baseLayer.clipIndex >= 0)
+	{
+		const Model* model = ModelManager::Get()->GetModel(mModelId);
+		ResetBoneAnimatedFlags(model->animationClips[baseLayer.clipIndex]);
+		EvaluatePose(*model);
+	}
+}
+
+void Animator::CrossFade(int clipIndex, bool looping, float fadeDuration)
+{
+	// Nothing to fade from, or nothing to fade to
+	if (fadeDuration <= 0.0f || clipIndex < 0 || mLayers[0].clipIndex < 0 || mBindPose.empty())
+	{
+		PlayAnimation(clipIndex, looping);
+		return;
+	}
+
+	const Model* model = ModelManager::Get()->GetModel(mModelId);
+	if (mFadeLayer.clipIndex >= 0)
+	{
+		// Interrupting a fade, the new one starts from the mix rather than popping back to the old base clip
+		FreezeFadePose(*model);
+		mFadeLayer.clipIndex = mLayers[0].clipIndex;
+	}
+	else
+	{
+		mFadeLayer = mLayers[0];
+		mIsFadePoseFrozen = false;
+	}
+	mFadeTime = 0.0f;
+	mFadeDuration = fadeDuration;
+
+	Layer& baseLayer = mLayers[0];
+	baseLayer.clipIndex = clipIndex;
+	baseLayer.isLooping = looping;
+	baseLayer.tick = 0.0f;
+
+	EvaluatePose(*model);
 }
 
 void Animator::Update(float deltaTime)
 {
+	PROFILE_SCOPE("Animator::Update");
 	// Not paying animation, so don't update
-	if (mClipIndex < 0)
+	if (mLayers[0].clipIndex < 0 && !IsBlending())
 	{
 		return;
 	}
 
+	++mFrame;
 	const Model* model = ModelManager::Get()->GetModel(mModelId);
-	const AnimationClip& animClip = model->animationClips[mClipIndex];
-	mAnimationTick += animClip.ticksPerSecond * deltaTime;
-	if (mIsLooping)
+	for (Layer& layer : mLayers)
 	{
-		while (mAnimationTick > animClip.tickDuration)
-		{
-			mAnimationTick -= animClip.tickDuration;
-		}
+		AdvanceLayer(*model, layer, deltaTime);
 	}
-	else
+	if (mFadeLayer.clipIndex >= 0)
 	{
-		// If not looping clamp to end of duration
-		mAnimationTick = Math::Min(mAnimationTick, animClip.tickDuration);
+		if (!mIsFadePoseFrozen)
+		{
+			AdvanceLayer(*model, mFadeLayer, deltaTime);
+		}
+		mFadeTime += deltaTime;
+		if (mFadeTime >= mFadeDuration)
+		{
+			mFadeLayer.clipIndex = -1;
+			mIsFadePoseFrozen = false;
+		}
 	}
+
+	EvaluatePose(*model);
+}
+
+void Animator::SetLayer(uint32_t layerIndex, int clipIndex, bool looping, float weight, AnimationBlendMode blendMode, const BoneMask* boneMask)
+{
+	ASSERT(layerIndex > 0 && layerIndex < MaxLayers, "Animator: Invalid layer %u, layer 0 is driven by PlayAnimation", layerIndex);
+	Layer& layer = mLayers[layerIndex];
+	layer.clipIndex = clipIndex;
+	layer.isLooping = looping;
+	layer.tick = 0.0f;
+	layer.weight = weight;
+	layer.blendMode = blendMode;
+	layer.boneMask = boneMask;
+}
+
+void Animator::SetLayerWeight(uint32_t layerIndex, float weight)
+{
+	ASSERT(layerIndex < MaxLayers, "Animator: Invalid layer %u", layerIndex);
+	mLayers[layerIndex].weight = weight;
+}
+
+void Animator::ClearLayer(uint32_t layerIndex)
+{
+	ASSERT(layerIndex > 0 && layerIndex < MaxLayers, "Animator: Invalid layer %u, layer 0 is driven by PlayAnimation", layerIndex);
+	mLayers[layerIndex] = Layer();
 }
 
 bool Animator::IsFinished() const
 {
-	if (mClipIndex < 0 || mIsLooping)
+	const Layer& baseLayer = mLayers[0];
+	if (baseLayer.clipIndex < 0 || baseLayer.isLooping)
 	{
 		return false;
 	}
 
 	const Model* model = ModelManager::Get()->GetModel(mModelId);
-	const AnimationClip& animClip = model->animationClips[mClipIndex];
-	return mAnimationTick >= animClip.tickDuration;
+	const AnimationClip& animClip = model->animationClips[baseLayer.clipIndex];
+	return baseLayer.tick >= animClip.tickDuration;
 }
 
 size_t Animator::GetAnimationCount() const
@@ -68,19 +247,271 @@ size_t Animator::GetAnimationCount() const
 
 bool Animator::GetToParentTransform(const Bone* bone, Math::Matrix4& transform) const
 {
-	if (mClipIndex < 0)
+	return GetToParentTransform(bone->index, transform);
+}
+
+bool Animator::GetToParentTransform(int boneIndex, Math::Matrix4& transform) const
+{
+	// The pose is sampled once per update, so this is just a lookup
+	if ((mLayers[0].clipIndex < 0 && !mIsPoseBlended) || static_cast<size_t>(boneIndex) >= mIsBoneAnimated.size() || !mIsBoneAnimated[boneIndex])
 	{
 		return false;
 	}
+	transform = mToParentTransforms[boneIndex];
+	return true;
+}
 
-	const Model* model = ModelManager::Get()->GetModel(mModelId);
-	const AnimationClip& animClip = model->animationClips[mClipIndex];
-	const Animation* animation = animClip.boneAnimations[bone->index].get();
-	if (animation == nullptr)
+void Animator::SamplePose(const AnimationClip& animClip)
+{
+	mToParentTransforms.resize(animClip.boneAnimations.size());
+
+	// Use the compiled clip when it has been built, otherwise sample the authored tracks
+	const float tick = mLayers[0].tick;
+	if (animClip.compiled.GetFrameCount() > 0)
+	{
+		animClip.compiled.Evaluate(tick, mToParentTransforms);
+		return;
+	}
+
+	animClip.SampleBoneTransforms(tick, mCursors, mPose);
+	for (size_t i = 0; i < mPose.size(); ++i)
+	{
+		if (mIsBoneAnimated[i])
+		{
+			mToParentTransforms[i] = mPose[i].GetMatrix4();
+		}
+	}
+}
+
+void Animator::EvaluatePose(const Model& model)
+{
+	if (IsBlending())
+	{
+		BlendLayers(model);
+		return;
+	}
+
+	if (mLayers[0].clipIndex < 0)
+	{
+		return;
+	}
+
+	// A single clip goes straight to matrices, the flags were widened to every bone while blending
+	const AnimationClip& animClip = model.animationClips[mLayers[0].clipIndex];
+	if (mIsPoseBlended)
+	{
+		mIsPoseBlended = false;
+		mCursors.clear();
+		ResetBoneAnimatedFlags(animClip);
+	}
+	SamplePose(animClip);
+}
+
+void Animator::BlendLayers(const Model& model)
+{
+	const size_t boneCount = mBindPose.size();
+
+	const Layer& baseLayer = mLayers[0];
+	if (baseLayer.clipIndex >= 0)
+	{
+		const CachedPose& basePose = GetCachedPose(model, baseLayer.clipIndex, baseLayer.tick, false);
+		std::copy_n(basePose.pose.begin(), Math::Min(boneCount, basePose.pose.size()), mBlendedPose.begin());
+	}
+	else
+	{
+		std::copy(mBindPose.begin(), mBindPose.end(), mBlendedPose.begin());
+	}
+
+	if (mFadeLayer.clipIndex >= 0)
+	{
+		// Weight of the incoming clip, the outgoing pose is blended towards it
+		const float t = Math::Min(mFadeTime / mFadeDuration, 1.0f);
+		const std::vector<Transform>& fadePose = mIsFadePoseFrozen ? mFadePose : GetCachedPose(model, mFadeLayer.clipIndex, mFadeLayer.tick, false).pose;
+		const size_t count = Math::Min(boneCount, fadePose.size());
+		for (size_t i = 0; i < count; ++i)
+		{
+			Transform transform = fadePose[i];
+			BlendTransform(transform, mBlendedPose[i], t);
+			mBlendedPose[i] = transform;
+		}
+	}
+
+	for (uint32_t l = 1; l < MaxLayers; ++l)
+	{
+		const Layer& layer = mLayers[l];
+		if (layer.clipIndex < 0 || layer.weight <= 0.0f)
+		{
+			continue;
+		}
+
+		const bool isAdditive = layer.blendMode == AnimationBlendMode::Additive;
+		const CachedPose& layerPose = GetCachedPose(model, layer.clipIndex, layer.tick, isAdditive);
+		const size_t count = Math::Min(boneCount, layerPose.pose.size());
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float weight = (layer.boneMask != nullptr) ? layer.weight * layer.boneMask->GetWeight(i) : layer.weight;
+			if (weight <= 0.0f)
+			{
+				continue;
+			}
+
+			if (isAdditive)
+			{
+				AddTransform(mBlendedPose[i], layerPose.pose[i], layerPose.referencePose[i], weight);
+			}
+			else
+			{
+				BlendTransform(mBlendedPose[i], layerPose.pose[i], weight);
+			}
+		}
+	}
+
+	mToParentTransforms.resize(boneCount);
+	for (size_t i = 0; i < boneCount; ++i)
+	{
+		mToParentTransforms[i] = mBlendedPose[i].GetMatrix4();
+	}
+	mIsBoneAnimated.assign(boneCount, true);
+	mIsPoseBlended = true;
+}
+
+const Animator::CachedPose& Animator::GetCachedPose(const Model& model, int clipIndex, float tick, bool needsReferencePose)
+{
+	// Layers sharing a clip at the same tick (or a clip parked on its last frame) reuse the sampled pose
+	CachedPose* cachedPose = nullptr;
+	for (CachedPose& entry : mPoseCache)
+	{
+		if (entry.clipIndex == clipIndex && entry.tick == tick)
+		{
+			cachedPose = &entry;
+			break;
+		}
+	}
+
+	if (cachedPose == nullptr)
+	{
+		// Prefer the entry already following this clip so its cursors stay warm, otherwise evict the stalest one
+		for (CachedPose& entry : mPoseCache)
+		{
+			if (entry.clipIndex == clipIndex && entry.frame != mFrame)
+			{
+				cachedPose = &entry;
+				break;
+			}
+		}
+		if (cachedPose == nullptr)
+		{
+			cachedPose = &mPoseCache[0];
+			for (CachedPose& entry : mPoseCache)
+			{
+				if (entry.clipIndex < 0)
+				{
+					cachedPose = &entry;
+					break;
+				}
+				if (entry.frame < cachedPose->frame)
+				{
+					cachedPose = &entry;
+				}
+			}
+			cachedPose->clipIndex = clipIndex;
+			cachedPose->hasReferencePose = false;
+			cachedPose->pose = mBindPose;
+			for (AnimationCursor& cursor : cachedPose->cursors)
+			{
+				cursor = AnimationCursor();
+			}
+		}
+
+		model.animationClips[clipIndex].SampleBoneTransforms(tick, cachedPose->cursors, cachedPose->pose);
+		cachedPose->tick = tick;
+	}
+
+	if (needsReferencePose && !cachedPose->hasReferencePose)
+	{
+		// Sampled once per clip, the reset cursors only cost a binary search
+		cachedPose->referencePose = mBindPose;
+		for (AnimationCursor& cursor : mReferenceCursors)
+		{
+			cursor = AnimationCursor();
+		}
+		model.animationClips[clipIndex].SampleBoneTransforms(0.0f, mReferenceCursors, cachedPose->referencePose);
+		cachedPose->hasReferencePose = true;
+	}
+
+	cachedPose->frame = mFrame;
+	return *cachedPose;
+}
+
+void Animator::FreezeFadePose(const Model& model)
+{
+	// Same mix as BlendLayers before the upper layers, those keep playing on top of the new fade
+	const size_t boneCount = mBindPose.size();
+	const float t = Math::Min(mFadeTime / mFadeDuration, 1.0f);
+	if (!mIsFadePoseFrozen)
+	{
+		const CachedPose& fadePose = GetCachedPose(model, mFadeLayer.clipIndex, mFadeLayer.tick, false);
+		mFadePose = mBindPose;
+		std::copy_n(fadePose.pose.begin(), Math::Min(boneCount, fadePose.pose.size()), mFadePose.begin());
+	}
+
+	const CachedPose& basePose = GetCachedPose(model, mLayers[0].clipIndex, mLayers[0].tick, false);
+	const size_t count = Math::Min(boneCount, basePose.pose.size());
+	for (size_t i = 0; i < count; ++i)
+	{
+		BlendTransform(mFadePose[i], basePose.pose[i], t);
+	}
+	mIsFadePoseFrozen = true;
+}
+
+void Animator::AdvanceLayer(const Model& model, Layer& layer, float deltaTime) const
+{
+	if (layer.clipIndex < 0)
+	{
+		return;
+	}
+
+	const AnimationClip& animClip = model.animationClips[layer.clipIndex];
+	layer.tick += animClip.ticksPerSecond * deltaTime;
+	if (layer.isLooping)
+	{
+		while (layer.tick > animClip.tickDuration)
+		{
+			layer.tick -= animClip.tickDuration;
+		}
+	}
+	else
+	{
+		// If not looping clamp to end of duration
+		layer.tick = Math::Min(layer.tick, animClip.tickDuration);
+	}
+}
+
+void Animator::ResetBoneAnimatedFlags(const AnimationClip& animClip)
+{
+	mIsBoneAnimated.resize(animClip.boneAnimations.size());
+	for (size_t i = 0; i < animClip.boneAnimations.size(); ++i)
+	{
+		mIsBoneAnimated[i] = animClip.boneAnimations[i] != nullptr;
+	}
+}
+
+bool Animator::IsBlending() const
+{
+	if (mBindPose.empty())
 	{
 		return false;
 	}
-	Transform animTransform = animation->GetTransform(mAnimationTick);
-	transform = animTransform.GetMatrix4();
-	return true;
+	if (mFadeLayer.clipIndex >= 0)
+	{
+		return true;
+	}
+	for (uint32_t l = 1; l < MaxLayers; ++l)
+	{
+		if (mLayers[l].clipIndex >= 0 && mLayers[l].weight > 0.0f)
+		{
+			return true;
+		}
+	}
+	return false;
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "Precompiled.h"
+#include "BoneMask.h"
+#include "Skeleton.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+void BoneMask::Initialize(const Skeleton& skeleton, float weight)
+{
+    mWeights.assign(skeleton.bones.size(), weight);
+}
+
+bool BoneMask::SetBoneWeight(const Skeleton& skeleton, const std::string& boneName, float weight, bool includeChildren)
+{
+    const Bone* root = nullptr;
+    for (const auto& bone : skeleton.bones)
+    {
+        if (bone->name == boneName)
+        {
+            root = bone.get();
+            break;
+        }
+    }
+    if (root == nullptr)
+    {
+        LOG("BoneMask: Bone %s not found", boneName.c_str());
+        return false;
+    }
+
+    SetBoneWeight(skeleton, root->index, weight, includeChildren);
+    return true;
+}
+
+void BoneMask::SetBoneWeight(const Skeleton& skeleton, int boneIndex, float weight, bool includeChildren)
+{
+    ASSERT(boneIndex >= 0 && static_cast<size_t>(boneIndex) < skeleton.bones.size(), "BoneMask: Invalid bone index %d", boneIndex);
+    mWeights.resize(skeleton.bones.size(), 0.0f);
+    mWeights[boneIndex] = weight;
+    if (includeChildren)
+    {
+        // Parents always come before their children in the sorted order, so one pass marks the whole subtree
+        std::vector<bool> isInSubtree(skeleton.bones.size(), false);
+        isInSubtree[boneIndex] = true;
+        for (size_t i = 0; i < skeleton.sortedBoneIndices.size(); ++i)
+        {
+            const int childIndex = skeleton.sortedBoneIndices[i];
+            const int parentIndex = skeleton.sortedParentIndices[i];
+            if (parentIndex >= 0 && isInSubtree[parentIndex])
+            {
+                isInSubtree[childIndex] = true;
+                mWeights[childIndex] = weight;
+            }
+        }
+    }
+}
+
+float BoneMask::GetWeight(size_t boneIndex) const
+{
+    return (boneIndex < mWeights.size()) ? mWeights[boneIndex] : 0.0f;
+}
+
+size_t BoneMask::GetBoneCount() const
+{
+    return mWeights.size();
+}
\ No newline at end of file
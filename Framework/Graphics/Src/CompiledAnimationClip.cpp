@@ -0,0 +1,227 @@
+#include "Precompiled.h"
+#include "CompiledAnimationClip.h"
+
+#include "AnimationClip.h"
+
+#include <immintrin.h>
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+namespace
+{
+    // Thin wrappers so the pose kernel is written once for both instruction sets
+#if defined(__AVX__)
+    using Lanes = __m256;
+    constexpr uint32_t LaneWidth = 8;
+
+    inline Lanes Load(const float* data) { return _mm256_loadu_ps(data); }
+    inline void Store(float* data, Lanes v) { _mm256_storeu_ps(data, v); }
+    inline Lanes Splat(float value) { return _mm256_set1_ps(value); }
+    inline Lanes Add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+    inline Lanes Sub(Lanes a, Lanes b) { return _mm256_sub_ps(a, b); }
+    inline Lanes Mul(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+    inline Lanes Div(Lanes a, Lanes b) { return _mm256_div_ps(a, b); }
+    inline Lanes Sqrt(Lanes a) { return _mm256_sqrt_ps(a); }
+    inline Lanes And(Lanes a, Lanes b) { return _mm256_and_ps(a, b); }
+    inline Lanes Xor(Lanes a, Lanes b) { return _mm256_xor_ps(a, b); }
+#else
+    using Lanes = __m128;
+    constexpr uint32_t LaneWidth = 4;
+
+    inline Lanes Load(const float* data) { return _mm_loadu_ps(data); }
+    inline void Store(float* data, Lanes v) { _mm_storeu_ps(data, v); }
+    inline Lanes Splat(float value) { return _mm_set1_ps(value); }
+    inline Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+    inline Lanes Sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+    inline Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+    inline Lanes Div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+    inline Lanes Sqrt(Lanes a) { return _mm_sqrt_ps(a); }
+    inline Lanes And(Lanes a, Lanes b) { return _mm_and_ps(a, b); }
+    inline Lanes Xor(Lanes a, Lanes b) { return _mm_xor_ps(a, b); }
+#endif
+
+    inline Lanes Lerp(Lanes a, Lanes b, Lanes t)
+    {
+        return Add(a, Mul(Sub(b, a), t));
+    }
+
+    enum Component : uint32_t
+    {
+        PositionX, PositionY, PositionZ,
+        RotationX, RotationY, RotationZ, RotationW,
+        ScaleX, ScaleY, ScaleZ
+    };
+}
+
+void CompiledAnimationClip::Compile(const AnimationClip& clip, float samplesPerSecond)
+{
+    ASSERT(samplesPerSecond > 0.0f, "CompiledAnimationClip: Sample rate must be positive.");
+
+    mBoneCount = static_cast<uint32_t>(clip.boneAnimations.size());
+    mLaneBoneCount = (mBoneCount + LaneWidth - 1) / LaneWidth * LaneWidth;
+
+    // Spread the frames evenly so the last one lands exactly on the end of the clip. A rate that fits the clip a
+    // whole number of times mustn't gain a frame to rounding, that would move every frame off its key
+    const float ticksPerSecond = (clip.ticksPerSecond > 0.0f) ? clip.ticksPerSecond : 1.0f;
+    mFrameCount = static_cast<uint32_t>(ceilf(clip.tickDuration / ticksPerSecond * samplesPerSecond - 0.001f)) + 1;
+    mFramesPerTick = (clip.tickDuration > 0.0f) ? (mFrameCount - 1) / clip.tickDuration : 0.0f;
+
+    mIsBoneAnimated.assign(mBoneCount, 0);
+    for (uint32_t i = 0; i < mBoneCount; ++i)
+    {
+        mIsBoneAnimated[i] = clip.boneAnimations[i] != nullptr;
+    }
+
+    mSamples.assign(static_cast<size_t>(mFrameCount) * ComponentCount * mLaneBoneCount, 0.0f);
+    AnimationCursors cursors(mBoneCount);
+    for (uint32_t frame = 0; frame < mFrameCount; ++frame)
+    {
+        const float tick = (mFramesPerTick > 0.0f) ? Math::Min(frame / mFramesPerTick, clip.tickDuration) : 0.0f;
+        float* samples = &mSamples[static_cast<size_t>(frame) * ComponentCount * mLaneBoneCount];
+        for (uint32_t bone = 0; bone < mLaneBoneCount; ++bone)
+        {
+            // Padding lanes and bones without tracks hold the identity transform
+            Transform transform;
+            if (bone < mBoneCount && mIsBoneAnimated[bone])
+            {
+                transform = clip.boneAnimations[bone]->GetTransform(tick, cursors[bone]);
+            }
+
+            samples[PositionX * mLaneBoneCount + bone] = transform.position.x;
+            samples[PositionY * mLaneBoneCount + bone] = transform.position.y;
+            samples[PositionZ * mLaneBoneCount + bone] = transform.position.z;
+            samples[RotationX * mLaneBoneCount + bone] = transform.rotation.x;
+            samples[RotationY * mLaneBoneCount + bone] = transform.rotation.y;
+            samples[RotationZ * mLaneBoneCount + bone] = transform.rotation.z;
+            samples[RotationW * mLaneBoneCount + bone] = transform.rotation.w;
+            samples[ScaleX * mLaneBoneCount + bone] = transform.scale.x;
+            samples[ScaleY * mLaneBoneCount + bone] = transform.scale.y;
+            samples[ScaleZ * mLaneBoneCount + bone] = transform.scale.z;
+        }
+    }
+}
+
+void CompiledAnimationClip::Evaluate(float tick, std::vector<Math::Matrix4>& toParentTransforms) const
+{
+    if (mFrameCount == 0)
+    {
+        return;
+    }
+    ASSERT(toParentTransforms.size() >= mBoneCount, "CompiledAnimationClip: Not enough bone transforms.");
+
+    const float frame = Math::Clamp(tick * mFramesPerTick, 0.0f, static_cast<float>(mFrameCount - 1));
+    const uint32_t frame0 = static_cast<uint32_t>(frame);
+    const uint32_t frame1 = Math::Min(frame0 + 1, mFrameCount - 1);
+    const float* samples0 = &mSamples[static_cast<size_t>(frame0) * ComponentCount * mLaneBoneCount];
+    const float* samples1 = &mSamples[static_cast<size_t>(frame1) * ComponentCount * mLaneBoneCount];
+
+    const Lanes t = Splat(frame - static_cast<float>(frame0));
+    const Lanes one = Splat(1.0f);
+    const Lanes two = Splat(2.0f);
+    const Lanes signBit = Splat(-0.0f);
+
+    alignas(32) float matrix[12][LaneWidth];
+    for (uint32_t first = 0; first < mBoneCount; first += LaneWidth)
+    {
+        auto load0 = [&](Component c) { return Load(samples0 + c * mLaneBoneCount + first); };
+        auto load1 = [&](Component c) { return Load(samples1 + c * mLaneBoneCount + first); };
+
+        const Lanes px = Lerp(load0(PositionX), load1(PositionX), t);
+        const Lanes py = Lerp(load0(PositionY), load1(PositionY), t);
+        const Lanes pz = Lerp(load0(PositionZ), load1(PositionZ), t);
+        const Lanes sx = Lerp(load0(ScaleX), load1(ScaleX), t);
+        const Lanes sy = Lerp(load0(ScaleY), load1(ScaleY), t);
+        const Lanes sz = Lerp(load0(ScaleZ), load1(ScaleZ), t);
+
+        // Normalized lerp along the shortest arc, AnimationBuilder::Build checks the frames are dense enough for it
+        // to match slerp
+        const Lanes ax = load0(RotationX), ay = load0(RotationY), az = load0(RotationZ), aw = load0(RotationW);
+        Lanes bx = load1(RotationX), by = load1(RotationY), bz = load1(RotationZ), bw = load1(RotationW);
+        const Lanes dot = Add(Add(Mul(ax, bx), Mul(ay, by)), Add(Mul(az, bz), Mul(aw, bw)));
+        const Lanes flip = And(dot, signBit);
+        bx = Xor(bx, flip);
+        by = Xor(by, flip);
+        bz = Xor(bz, flip);
+        bw = Xor(bw, flip);
+
+        Lanes qx = Lerp(ax, bx, t), qy = Lerp(ay, by, t), qz = Lerp(az, bz, t), qw = Lerp(aw, bw, t);
+        const Lanes lengthSqr = Add(Add(Mul(qx, qx), Mul(qy, qy)), Add(Mul(qz, qz), Mul(qw, qw)));
+        const Lanes invLength = Div(one, Sqrt(lengthSqr));
+        qx = Mul(qx, invLength);
+        qy = Mul(qy, invLength);
+        qz = Mul(qz, invLength);
+        qw = Mul(qw, invLength);
+
+        // Scaling * Rotation * Translation, same as Transform::GetMatrix4
+        const Lanes xx = Mul(two, Mul(qx, qx)), yy = Mul(two, Mul(qy, qy)), zz = Mul(two, Mul(qz, qz));
+        const Lanes xy = Mul(two, Mul(qx, qy)), xz = Mul(two, Mul(qx, qz)), yz = Mul(two, Mul(qy, qz));
+        const Lanes xw = Mul(two, Mul(qx, qw)), yw = Mul(two, Mul(qy, qw)), zw = Mul(two, Mul(qz, qw));
+
+        Store(matrix[0], Mul(sx, Sub(Sub(one, yy), zz)));
+        Store(matrix[1], Mul(sx, Add(xy, zw)));
+        Store(matrix[2], Mul(sx, Sub(xz, yw)));
+        Store(matrix[3], Mul(sy, Sub(xy, zw)));
+        Store(matrix[4], Mul(sy, Sub(Sub(one, xx), zz)));
+        Store(matrix[5], Mul(sy, Add(yz, xw)));
+        Store(matrix[6], Mul(sz, Add(xz, yw)));
+        Store(matrix[7], Mul(sz, Sub(yz, xw)));
+        Store(matrix[8], Mul(sz, Sub(Sub(one, xx), yy)));
+        Store(matrix[9], px);
+        Store(matrix[10], py);
+        Store(matrix[11], pz);
+
+        const uint32_t laneCount = Math::Min(LaneWidth, mBoneCount - first);
+        for (uint32_t lane = 0; lane < laneCount; ++lane)
+        {
+            if (mIsBoneAnimated[first + lane])
+            {
+                toParentTransforms[first + lane] = Math::Matrix4(
+                    matrix[0][lane], matrix[1][lane], matrix[2][lane], 0.0f,
+                    matrix[3][lane], matrix[4][lane], matrix[5][lane], 0.0f,
+                    matrix[6][lane], matrix[7][lane], matrix[8][lane], 0.0f,
+                    matrix[9][lane], matrix[10][lane], matrix[11][lane], 1.0f);
+            }
+        }
+    }
+}
+
+float CompiledAnimationClip::GetMaxError(const AnimationClip& clip, const std::vector<float>& ticks) const
+{
+    float maxError = 0.0f;
+    std::vector<Math::Matrix4> toParentTransforms(mBoneCount);
+    for (const float tick : ticks)
+    {
+        Evaluate(tick, toParentTransforms);
+        for (uint32_t bone = 0; bone < mBoneCount; ++bone)
+        {
+            if (!mIsBoneAnimated[bone])
+            {
+                continue;
+            }
+
+            const Math::Matrix4 authored = clip.boneAnimations[bone]->GetTransform(tick).GetMatrix4();
+            for (size_t i = 0; i < authored.v.size(); ++i)
+            {
+                const float error = fabsf(toParentTransforms[bone].v[i] - authored.v[i]) / Math::Max(1.0f, fabsf(authored.v[i]));
+                maxError = Math::Max(maxError, error);
+            }
+        }
+    }
+    return maxError;
+}
+
+bool CompiledAnimationClip::IsBoneAnimated(uint32_t boneIndex) const
+{
+    return boneIndex < mBoneCount && mIsBoneAnimated[boneIndex] != 0;
+}
+
+uint32_t CompiledAnimationClip::GetBoneCount() const
+{
+    return mBoneCount;
+}
+
+uint32_t CompiledAnimationClip::GetFrameCount() const
+{
+    return mFrameCount;
+}
@@ -57,6 +57,193 @@ namespace
 		return false;
 	}
 
+	struct ScopeTotal
+	{
+		std::string_view name;
+		uint64_t duration = 0;
+		uint32_t calls = 0;
+	};
+
+	// Profiler panel state, kept between frames so the panel doesn't allocate every frame
+	std::vector<Profiler::Frame> sProfilerFrames;
+	std::vector<Profiler::ThreadEvents> sProfilerThreads;
+	std::vector<ScopeTotal> sProfilerTotals;
+	int sProfilerSelectedFrame = 0;
+	std::string sProfilerExportResult;
+
+	// Memory panel state
+	std::vector<AllocatorStats> sMemoryStats;
+	std::vector<MemoryTracker::Callstack> sMemoryCallstacks;
+	int sMemorySampleInterval = 0;
+
+	ImU32 GetScopeColor(const char* name)
+	{
+		const size_t hash = std::hash<std::string_view>()(name);
+		return ImColor::HSV(static_cast<float>(hash % 360) / 360.0f, 0.45f, 0.85f);
+	}
+
+	void ShowMemoryTags()
+	{
+		if (!ImGui::CollapsingHeader("Tags", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			return;
+		}
+		if (!MemoryTracker::IsEnabled())
+		{
+			ImGui::TextUnformatted("Built with IEXE_DISABLE_MEMORY_TRACKING");
+			return;
+		}
+
+		// Anything but 0 in a loop that should be steady state is worth a look
+		ImGui::Text("Allocations last frame: %llu (%.1f KB)", static_cast<unsigned long long>(MemoryTracker::GetLastFrameAllocationCount()),
+			MemoryTracker::GetLastFrameAllocatedBytes() / 1024.0);
+		if (ImGui::Button("Copy Report"))
+		{
+			ImGui::SetClipboardText(MemoryTracker::Report().c_str());
+		}
+		if (ImGui::BeginTable("MemoryTags", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+		{
+			ImGui::TableSetupColumn("Tag");
+			ImGui::TableSetupColumn("Live (KB)");
+			ImGui::TableSetupColumn("Peak (KB)");
+			ImGui::TableSetupColumn("Live Allocs");
+			ImGui::TableSetupColumn("Total Allocs");
+			ImGui::TableHeadersRow();
+			for (uint32_t i = 0; i < static_cast<uint32_t>(MemoryTag::Count); ++i)
+			{
+				const MemoryTag tag = static_cast<MemoryTag>(i);
+				const MemoryTracker::TagStats stats = MemoryTracker::GetTagStats(tag);
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(GetMemoryTagName(tag));
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stats.bytesLive / 1024.0);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stats.bytesPeak / 1024.0);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", stats.allocationsLive);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", stats.allocationsTotal);
+			}
+			ImGui::EndTable();
+		}
+	}
+
+	void ShowAllocators()
+	{
+		if (!ImGui::CollapsingHeader("Allocators", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			return;
+		}
+		if (ImGui::Button("Copy as Text"))
+		{
+			ImGui::SetClipboardText(AllocatorRegistry::Dump().c_str());
+		}
+
+		AllocatorRegistry::GetStats(sMemoryStats);
+		if (ImGui::BeginTable("Allocators", 7, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Sortable))
+		{
+			ImGui::TableSetupColumn("Allocator");
+			ImGui::TableSetupColumn("Block");
+			ImGui::TableSetupColumn("Live (KB)", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+			ImGui::TableSetupColumn("Peak (KB)", ImGuiTableColumnFlags_PreferSortDescending);
+			ImGui::TableSetupColumn("Reserved (KB)", ImGuiTableColumnFlags_PreferSortDescending);
+			ImGui::TableSetupColumn("Pages");
+			ImGui::TableSetupColumn("Fragmentation", ImGuiTableColumnFlags_PreferSortDescending);
+			ImGui::TableHeadersRow();
+
+			// Sorted by whichever column was clicked last, the rest have no order worth keeping
+			const ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+			if (sortSpecs != nullptr && sortSpecs->SpecsCount > 0)
+			{
+				const ImGuiTableColumnSortSpecs& spec = sortSpecs->Specs[0];
+				auto key = [column = spec.ColumnIndex](const AllocatorStats& stats)
+				{
+					switch (column)
+					{
+					case 1: return static_cast<double>(stats.blockSize);
+					case 2: return static_cast<double>(stats.blocksLive * stats.blockSize);
+					case 3: return static_cast<double>(stats.blocksPeak * stats.blockSize);
+					case 4: return static_cast<double>(stats.blocksReserved * stats.blockSize);
+					case 5: return static_cast<double>(stats.pageCount);
+					case 6: return static_cast<double>(stats.fragmentation);
+					default: return 0.0;
+					}
+				};
+				std::stable_sort(sMemoryStats.begin(), sMemoryStats.end(), [&](const AllocatorStats& a, const AllocatorStats& b)
+				{
+					if (spec.ColumnIndex == 0)
+					{
+						return (spec.SortDirection == ImGuiSortDirection_Ascending) ? a.name < b.name : a.name > b.name;
+					}
+					return (spec.SortDirection == ImGuiSortDirection_Ascending) ? key(a) < key(b) : key(a) > key(b);
+				});
+			}
+
+			for (const AllocatorStats& stats : sMemoryStats)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(stats.name.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", stats.blockSize);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stats.blocksLive * stats.blockSize / 1024.0);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stats.blocksPeak * stats.blockSize / 1024.0);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stats.blocksReserved * stats.blockSize / 1024.0);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu/%zu", stats.pageCount - stats.emptyPageCount, stats.pageCount);
+				ImGui::TableNextColumn();
+				char overlay[16];
+				snprintf(overlay, std::size(overlay), "%.1f%%", stats.fragmentation * 100.0f);
+				ImGui::ProgressBar(stats.fragmentation, ImVec2(-1.0f, 0.0f), overlay);
+			}
+			ImGui::EndTable();
+		}
+	}
+
+	void ShowMemoryCallstacks()
+	{
+		if (!MemoryTracker::IsEnabled() || !ImGui::CollapsingHeader("Callstacks"))
+		{
+			return;
+		}
+
+		sMemorySampleInterval = static_cast<int>(MemoryTracker::GetCallstackSampleInterval());
+		if (ImGui::InputInt("Sample every N allocations", &sMemorySampleInterval))
+		{
+			MemoryTracker::SetCallstackSampleInterval(static_cast<uint32_t>(std::max(sMemorySampleInterval, 0)));
+		}
+		// Resolving symbols is slow, so the list only updates on request
+		if (ImGui::Button("Refresh"))
+		{
+			MemoryTracker::GetTopCallstacks(sMemoryCallstacks, 20);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Clear"))
+		{
+			MemoryTracker::ClearCallstacks();
+			sMemoryCallstacks.clear();
+		}
+
+		for (std::size_t i = 0; i < sMemoryCallstacks.size(); ++i)
+		{
+			const MemoryTracker::Callstack& callstack = sMemoryCallstacks[i];
+			const char* topFrame = callstack.frames.empty() ? "?" : callstack.frames[0].c_str();
+			if (ImGui::TreeNode(reinterpret_cast<void*>(i), "%.1f KB in %llu samples [%s] %s", callstack.bytes / 1024.0,
+				static_cast<unsigned long long>(callstack.samples), GetMemoryTagName(callstack.tag), topFrame))
+			{
+				for (const std::string& frame : callstack.frames)
+				{
+					ImGui::TextUnformatted(frame.c_str());
+				}
+				ImGui::TreePop();
+			}
+		}
+	}
+
 	LRESULT CALLBACK DebugUIMessageHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 	{
 		ImGuiIO& io = ImGui::GetIO();
@@ -156,4 +343,154 @@ void DebugUI::EndRender()
 		ImGui::UpdatePlatformWindows();
 		ImGui::RenderPlatformWindowsDefault();
 	}
+}
+
+void DebugUI::ShowProfiler()
+{
+	Profiler* profiler = Profiler::Get();
+	ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowSize(ImVec2(800.0f, 450.0f), ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin("Profiler"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	bool paused = profiler->IsPaused();
+	if (ImGui::Checkbox("Pause", &paused))
+	{
+		profiler->SetPaused(paused);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Export Chrome Trace"))
+	{
+		const std::filesystem::path exportPath = "profile_trace.json";
+		sProfilerExportResult = profiler->ExportChromeTrace(exportPath) ? "Saved " + exportPath.u8string() : "Export failed";
+	}
+	if (!sProfilerExportResult.empty())
+	{
+		ImGui::SameLine();
+		ImGui::TextUnformatted(sProfilerExportResult.c_str());
+	}
+
+	profiler->GetFrames(sProfilerFrames);
+	if (sProfilerFrames.empty())
+	{
+		ImGui::End();
+		return;
+	}
+
+	// Frame time history, newest on the right
+	const int frameCount = static_cast<int>(sProfilerFrames.size());
+	ImGui::PlotHistogram("##FrameTimes",
+		[](void* data, int index)
+		{
+			const Profiler::Frame& frame = static_cast<const Profiler::Frame*>(data)[index];
+			return static_cast<float>(frame.end - frame.start) / 1.0e6f;
+		},
+		sProfilerFrames.data(), frameCount, 0, "Frame (ms)", 0.0f, FLT_MAX, ImVec2(-1.0f, 60.0f));
+	sProfilerSelectedFrame = std::clamp(sProfilerSelectedFrame, 0, frameCount - 1);
+	ImGui::SliderInt("Frames back", &sProfilerSelectedFrame, 0, frameCount - 1);
+
+	const Profiler::Frame& frame = sProfilerFrames[frameCount - 1 - sProfilerSelectedFrame];
+	const double frameDuration = static_cast<double>(frame.end - frame.start);
+	ImGui::Text("Frame: %.3f ms", frameDuration / 1.0e6);
+	profiler->GetEvents(frame.start, frame.end, sProfilerThreads);
+
+	// One row per scope depth and thread, scopes are drawn where they sit in the frame
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+	const float labelWidth = 100.0f;
+	const float timelineWidth = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 50.0f);
+	for (const Profiler::ThreadEvents& thread : sProfilerThreads)
+	{
+		if (thread.events.empty())
+		{
+			continue;
+		}
+
+		uint32_t maxDepth = 0;
+		for (const Profiler::Event& event : thread.events)
+		{
+			maxDepth = std::max(maxDepth, event.depth);
+		}
+
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		drawList->AddText(origin, ImGui::GetColorU32(ImGuiCol_Text), thread.name.c_str());
+		for (const Profiler::Event& event : thread.events)
+		{
+			const uint64_t start = std::max(event.start, frame.start);
+			const uint64_t end = std::min(event.end, frame.end);
+			const float x0 = origin.x + labelWidth + static_cast<float>((start - frame.start) / frameDuration) * timelineWidth;
+			const float x1 = std::max(origin.x + labelWidth + static_cast<float>((end - frame.start) / frameDuration) * timelineWidth, x0 + 1.0f);
+			const float y0 = origin.y + event.depth * rowHeight;
+			const ImVec2 min(x0, y0);
+			const ImVec2 max(x1, y0 + rowHeight - 1.0f);
+			drawList->AddRectFilled(min, max, GetScopeColor(event.name));
+			if (x1 - x0 > 20.0f)
+			{
+				const ImVec4 clipRect(min.x, min.y, max.x, max.y);
+				drawList->AddText(nullptr, 0.0f, ImVec2(x0 + 2.0f, y0), IM_COL32_BLACK, event.name, nullptr, 0.0f, &clipRect);
+			}
+			if (ImGui::IsMouseHoveringRect(min, max))
+			{
+				ImGui::SetTooltip("%s\n%.3f ms", event.name, static_cast<double>(event.end - event.start) / 1.0e6);
+			}
+		}
+		ImGui::Dummy(ImVec2(labelWidth + timelineWidth, (maxDepth + 1) * rowHeight));
+		ImGui::Separator();
+	}
+
+	// Inclusive totals over every thread, the same name in several places adds up
+	std::vector<ScopeTotal>& totals = sProfilerTotals;
+	totals.clear();
+	for (const Profiler::ThreadEvents& thread : sProfilerThreads)
+	{
+		for (const Profiler::Event& event : thread.events)
+		{
+			auto iter = std::find_if(totals.begin(), totals.end(), [&](const ScopeTotal& total) { return total.name == event.name; });
+			if (iter == totals.end())
+			{
+				iter = totals.insert(totals.end(), ScopeTotal{ event.name });
+			}
+			iter->duration += event.end - event.start;
+			++iter->calls;
+		}
+	}
+	std::sort(totals.begin(), totals.end(), [](const ScopeTotal& a, const ScopeTotal& b) { return a.duration > b.duration; });
+	if (ImGui::BeginTable("ScopeTotals", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+	{
+		ImGui::TableSetupColumn("Scope");
+		ImGui::TableSetupColumn("Total (ms)");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableHeadersRow();
+		for (const ScopeTotal& total : totals)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(total.name.data(), total.name.data() + total.name.size());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", static_cast<double>(total.duration) / 1.0e6);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", total.calls);
+		}
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
+
+void DebugUI::ShowMemory()
+{
+	ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowSize(ImVec2(700.0f, 300.0f), ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin("Memory"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	ShowMemoryTags();
+	ShowAllocators();
+	ShowMemoryCallstacks();
+	ImGui::End();
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "Precompiled.h"
+#include "KeyframeCompression.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+namespace
+{
+    // The three smallest components of a unit quaternion are within +-1/sqrt(2)
+    constexpr float SmallestRange = 0.70710678f;
+    constexpr uint32_t ComponentBits = 15;
+    constexpr uint32_t ComponentMax = (1u << ComponentBits) - 1;
+
+    uint16_t Quantize(float value, float min, float extent)
+    {
+        if (extent <= 0.0f)
+        {
+            return 0;
+        }
+        const float t = Math::Clamp((value - min) / extent, 0.0f, 1.0f);
+        return static_cast<uint16_t>(t * 65535.0f + 0.5f);
+    }
+
+    float Dequantize(uint16_t value, float min, float extent)
+    {
+        return min + (static_cast<float>(value) / 65535.0f) * extent;
+    }
+}
+
+PackedQuaternion KeyframeCompression::PackQuaternion(const Math::Quaternion& q)
+{
+    const Math::Quaternion n = Math::Quaternion::Normalize(q);
+    const float components[4] = { n.x, n.y, n.z, n.w };
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        if (fabsf(components[i]) > fabsf(components[largest]))
+        {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, flip so the dropped component is always positive
+    const float sign = (components[largest] < 0.0f) ? -1.0f : 1.0f;
+    uint64_t bits = largest;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i != largest)
+        {
+            const float t = Math::Clamp((components[i] * sign + SmallestRange) / (2.0f * SmallestRange), 0.0f, 1.0f);
+            bits = (bits << ComponentBits) | static_cast<uint64_t>(t * ComponentMax + 0.5f);
+        }
+    }
+
+    PackedQuaternion packed;
+    packed.data[0] = static_cast<uint16_t>(bits >> 32);
+    packed.data[1] = static_cast<uint16_t>(bits >> 16);
+    packed.data[2] = static_cast<uint16_t>(bits);
+    return packed;
+}
+
+Math::Quaternion KeyframeCompression::UnpackQuaternion(const PackedQuaternion& packed)
+{
+    const uint64_t bits = (static_cast<uint64_t>(packed.data[0]) << 32)
+        | (static_cast<uint64_t>(packed.data[1]) << 16)
+        | static_cast<uint64_t>(packed.data[2]);
+    const uint32_t largest = static_cast<uint32_t>(bits >> (ComponentBits * 3)) & 3;
+
+    float components[4] = {};
+    float sumSqr = 0.0f;
+    uint32_t shift = ComponentBits * 2;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i != largest)
+        {
+            const float t = static_cast<float>((bits >> shift) & ComponentMax) / ComponentMax;
+            components[i] = t * (2.0f * SmallestRange) - SmallestRange;
+            sumSqr += components[i] * components[i];
+            shift -= ComponentBits;
+        }
+    }
+    components[largest] = sqrtf(Math::Max(0.0f, 1.0f - sumSqr));
+
+    return { components[0], components[1], components[2], components[3] };
+}
+
+PackedVector3 KeyframeCompression::PackVector3(const Math::Vector3& v, const Math::Vector3& min, const Math::Vector3& extent)
+{
+    PackedVector3 packed;
+    packed.data[0] = Quantize(v.x, min.x, extent.x);
+    packed.data[1] = Quantize(v.y, min.y, extent.y);
+    packed.data[2] = Quantize(v.z, min.z, extent.z);
+    return packed;
+}
+
+Math::Vector3 KeyframeCompression::UnpackVector3(const PackedVector3& packed, const Math::Vector3& min, const Math::Vector3& extent)
+{
+    return
+    {
+        Dequantize(packed.data[0], min.x, extent.x),
+        Dequantize(packed.data[1], min.y, extent.y),
+        Dequantize(packed.data[2], min.z, extent.z)
+    };
+}
@@ -6,17 +6,162 @@
 using namespace IExeEngine;
 using namespace IExeEngine::Graphics;
 
+namespace
+{
+    enum class BinaryAsset : uint16_t
+    {
+        Model = 1,
+        Skeleton,
+        AnimSet
+    };
+
+    // Every binary container starts with this header, elementSize guards against layout changes of the raw blocks
+    struct BinaryHeader
+    {
+        uint32_t magic = ModelIO::BinaryMagic;
+        uint16_t version = ModelIO::BinaryVersion;
+        uint16_t assetType = 0;
+        uint32_t elementSize = 0;
+        uint32_t count = 0;
+    };
+    static_assert(sizeof(BinaryHeader) == 16, "ModelIO: BinaryHeader must stay tightly packed!");
+    static_assert(std::is_trivially_copyable_v<Vertex>, "ModelIO: Vertex must be trivially copyable for binary IO!");
+    static_assert(std::is_trivially_copyable_v<Keyframe<Math::Vector3>>, "ModelIO: Keyframes must be trivially copyable for binary IO!");
+    static_assert(std::is_trivially_copyable_v<Keyframe<Math::Quaternion>>, "ModelIO: Keyframes must be trivially copyable for binary IO!");
+    static_assert(std::is_trivially_copyable_v<Keyframe<PackedVector3>>, "ModelIO: Keyframes must be trivially copyable for binary IO!");
+    static_assert(std::is_trivially_copyable_v<Keyframe<PackedQuaternion>>, "ModelIO: Keyframes must be trivially copyable for binary IO!");
+
+    template<class T>
+    void WriteValue(FILE* file, const T& value)
+    {
+        fwrite(&value, sizeof(T), 1, file);
+    }
+
+    template<class T>
+    void WriteArray(FILE* file, const T* values, uint32_t count)
+    {
+        WriteValue(file, count);
+        if (count > 0)
+        {
+            fwrite(values, sizeof(T), count, file);
+        }
+    }
+
+    void WriteString(FILE* file, const std::string& str)
+    {
+        WriteArray(file, str.data(), static_cast<uint32_t>(str.size()));
+    }
+
+    // Cursor over a block of mapped memory, every read is bounds checked and copies with memcpy
+    // so the raw blocks don't need to be aligned in the file
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const uint8_t* data, const uint8_t* end)
+            : mCurrent(data)
+            , mEnd(end)
+        {
+        }
+
+        template<class T>
+        bool Read(T& value)
+        {
+            return ReadBytes(&value, sizeof(T));
+        }
+
+        template<class T>
+        bool ReadArray(std::vector<T>& values)
+        {
+            uint32_t count = 0;
+            if (!Read(count) || static_cast<std::size_t>(mEnd - mCurrent) < count * sizeof(T))
+            {
+                return false;
+            }
+            values.resize(count);
+            return ReadBytes(values.data(), count * sizeof(T));
+        }
+
+        bool ReadString(std::string& str)
+        {
+            uint32_t length = 0;
+            if (!Read(length) || static_cast<std::size_t>(mEnd - mCurrent) < length)
+            {
+                return false;
+            }
+            str.assign(reinterpret_cast<const char*>(mCurrent), length);
+            mCurrent += length;
+            return true;
+        }
+
+        bool ReadHeader(BinaryAsset assetType, uint32_t elementSize, uint32_t& count)
+        {
+            BinaryHeader header;
+            if (!Read(header)
+                || header.magic != ModelIO::BinaryMagic
+                || header.version != ModelIO::BinaryVersion
+                || header.assetType != static_cast<uint16_t>(assetType)
+                || header.elementSize != elementSize)
+            {
+                return false;
+            }
+            count = header.count;
+            return true;
+        }
+
+        const uint8_t* GetCurrent() const { return mCurrent; }
+
+    private:
+        bool ReadBytes(void* dest, std::size_t size)
+        {
+            if (static_cast<std::size_t>(mEnd - mCurrent) < size)
+            {
+                return false;
+            }
+            if (size > 0)
+            {
+                memcpy(dest, mCurrent, size);
+                mCurrent += size;
+            }
+            return true;
+        }
+
+        const uint8_t* mCurrent = nullptr;
+        const uint8_t* mEnd = nullptr;
+    };
+
+    FILE* OpenBinaryForWrite(std::filesystem::path& filePath, const char* extension, BinaryAsset assetType, uint32_t elementSize, uint32_t count)
+    {
+        filePath.replace_extension(extension);
+
+        FILE* file = nullptr;
+        fopen_s(&file, filePath.u8string().c_str(), "wb");
+        if (file != nullptr)
+        {
+            BinaryHeader header;
+            header.assetType = static_cast<uint16_t>(assetType);
+            header.elementSize = elementSize;
+            header.count = count;
+            WriteValue(file, header);
+        }
+        return file;
+    }
+}
+
 void AnimationIO::Write(FILE* file, const Animation& animation)
 {
-    uint32_t keyCount = animation.mPositionKeys.size();
+    // The text format always stores full floats, quantized keys are written decoded
+    const PositionKeys positionKeys = animation.GetDecodedPositionKeys();
+    const RotationKeys rotationKeys = animation.GetDecodedRotationKeys();
+
+    uint32_t keyCount = positionKeys.size();
     fprintf_s(file, "PositionKeys: %d\n", keyCount);
-    for (auto& key : animation.mPositionKeys)
+    for (auto& key : positionKeys)
     {
         fprintf_s(file, "%f %f %f %f\n", key.time, key.key.x, key.key.y, key.key.z);
     }
-    keyCount = animation.mRotationKeys.size();
+    keyCount = rotationKeys.size();
     fprintf_s(file, "RotationKeys: %d\n", keyCount);
-    for (auto& key : animation.mRotationKeys)
+    for (auto& key : rotationKeys)
     {
         fprintf_s(file, "%f %f %f %f %f\n", key.time, key.key.x, key.key.y, key.key.z, key.key.w);
     }
@@ -57,6 +202,50 @@ void AnimationIO::Read(FILE* file, Animation& animation)
     animation = builder.Build();
 }
 
+void AnimationIO::WriteBinary(FILE* file, const Animation& animation)
+{
+    WriteValue(file, animation.mDuration);
+    const uint8_t isQuantized = animation.IsQuantized() ? 1 : 0;
+    WriteValue(file, isQuantized);
+    if (isQuantized)
+    {
+        WriteValue(file, animation.mPositionMin);
+        WriteValue(file, animation.mPositionExtent);
+        WriteArray(file, animation.mPackedPositionKeys.data(), static_cast<uint32_t>(animation.mPackedPositionKeys.size()));
+        WriteArray(file, animation.mPackedRotationKeys.data(), static_cast<uint32_t>(animation.mPackedRotationKeys.size()));
+    }
+    else
+    {
+        WriteArray(file, animation.mPositionKeys.data(), static_cast<uint32_t>(animation.mPositionKeys.size()));
+        WriteArray(file, animation.mRotationKeys.data(), static_cast<uint32_t>(animation.mRotationKeys.size()));
+    }
+    WriteArray(file, animation.mScaleKeys.data(), static_cast<uint32_t>(animation.mScaleKeys.size()));
+}
+
+const uint8_t* AnimationIO::ReadBinary(const uint8_t* data, const uint8_t* end, Animation& animation)
+{
+    // Keys were validated by the AnimationBuilder when the file was written, so the blocks are copied as is
+    BinaryReader reader(data, end);
+    uint8_t isQuantized = 0;
+    if (!reader.Read(animation.mDuration) || !reader.Read(isQuantized))
+    {
+        return nullptr;
+    }
+
+    const bool keysRead = isQuantized
+        ? reader.Read(animation.mPositionMin)
+            && reader.Read(animation.mPositionExtent)
+            && reader.ReadArray(animation.mPackedPositionKeys)
+            && reader.ReadArray(animation.mPackedRotationKeys)
+        : reader.ReadArray(animation.mPositionKeys)
+            && reader.ReadArray(animation.mRotationKeys);
+    if (!keysRead || !reader.ReadArray(animation.mScaleKeys))
+    {
+        return nullptr;
+    }
+    return reader.GetCurrent();
+}
+
 void ModelIO::SaveModel(std::filesystem::path filePath, const Model& model)
 {
     if (model.meshData.empty())
@@ -344,6 +533,12 @@ void ModelIO::LoadSkeleton(std::filesystem::path filePath, Model& model)
         ReadMatrix(boneData->offsetTransform);
     }
     fclose(file);
+
+    if (!model.skeleton->BuildFlatHierarchy())
+    {
+        LOG("ModelIO: %s has an inconsistent bone hierarchy!", filePath.u8string().c_str());
+        model.skeleton.reset();
+    }
 }
 
 void ModelIO::SaveAnimation(std::filesystem::path filePath, Model& model)
@@ -425,4 +620,277 @@ void ModelIO::LoadAnimation(std::filesystem::path filePath, Model& model)
         }
     }
     fclose(file);
-}
\ No newline at end of file
+}
+
+void ModelIO::SaveModelBinary(std::filesystem::path filePath, const Model& model)
+{
+    if (model.meshData.empty())
+    {
+        return;
+    }
+
+    const uint32_t meshCount = static_cast<uint32_t>(model.meshData.size());
+    FILE* file = OpenBinaryForWrite(filePath, "bmodel", BinaryAsset::Model, sizeof(Vertex), meshCount);
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    for (const Model::MeshData& meshData : model.meshData)
+    {
+        WriteValue(file, meshData.materialIndex);
+        WriteArray(file, meshData.mesh.vertices.data(), static_cast<uint32_t>(meshData.mesh.vertices.size()));
+        WriteArray(file, meshData.mesh.indices.data(), static_cast<uint32_t>(meshData.mesh.indices.size()));
+    }
+    fclose(file);
+}
+
+bool ModelIO::LoadModelBinary(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("bmodel");
+
+    Core::MappedFile mappedFile;
+    if (!mappedFile.Open(filePath))
+    {
+        return false;
+    }
+
+    BinaryReader reader(mappedFile.GetData(), mappedFile.GetData() + mappedFile.GetSize());
+    uint32_t meshCount = 0;
+    if (!reader.ReadHeader(BinaryAsset::Model, sizeof(Vertex), meshCount))
+    {
+        LOG("ModelIO: %s is not a valid binary model!", filePath.u8string().c_str());
+        return false;
+    }
+
+    std::vector<Model::MeshData> meshData(meshCount);
+    for (Model::MeshData& data : meshData)
+    {
+        if (!reader.Read(data.materialIndex)
+            || !reader.ReadArray(data.mesh.vertices)
+            || !reader.ReadArray(data.mesh.indices))
+        {
+            LOG("ModelIO: %s is truncated!", filePath.u8string().c_str());
+            return false;
+        }
+    }
+    model.meshData = std::move(meshData);
+    return true;
+}
+
+void ModelIO::SaveSkeletonBinary(std::filesystem::path filePath, const Model& model)
+{
+    if (model.skeleton == nullptr || model.skeleton->bones.empty())
+    {
+        return;
+    }
+
+    const uint32_t boneCount = static_cast<uint32_t>(model.skeleton->bones.size());
+    FILE* file = OpenBinaryForWrite(filePath, "bskeleton", BinaryAsset::Skeleton, sizeof(Math::Matrix4), boneCount);
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    WriteValue(file, model.skeleton->root->index);
+    for (const auto& bone : model.skeleton->bones)
+    {
+        WriteString(file, bone->name);
+        WriteValue(file, bone->index);
+        WriteValue(file, bone->parentIndex);
+        WriteArray(file, bone->childrenIndices.data(), static_cast<uint32_t>(bone->childrenIndices.size()));
+        WriteValue(file, bone->toParentTransform);
+        WriteValue(file, bone->offsetTransform);
+    }
+    fclose(file);
+}
+
+bool ModelIO::LoadSkeletonBinary(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("bskeleton");
+
+    Core::MappedFile mappedFile;
+    if (!mappedFile.Open(filePath))
+    {
+        return false;
+    }
+
+    BinaryReader reader(mappedFile.GetData(), mappedFile.GetData() + mappedFile.GetSize());
+    uint32_t boneCount = 0;
+    int rootIndex = 0;
+    if (!reader.ReadHeader(BinaryAsset::Skeleton, sizeof(Math::Matrix4), boneCount)
+        || !reader.Read(rootIndex)
+        || rootIndex < 0 || static_cast<uint32_t>(rootIndex) >= boneCount)
+    {
+        LOG("ModelIO: %s is not a valid binary skeleton!", filePath.u8string().c_str());
+        return false;
+    }
+
+    auto skeleton = std::make_unique<Skeleton>();
+    skeleton->bones.resize(boneCount);
+    for (uint32_t i = 0; i < boneCount; ++i)
+    {
+        skeleton->bones[i] = std::make_unique<Bone>();
+    }
+    skeleton->root = skeleton->bones[rootIndex].get();
+
+    for (uint32_t i = 0; i < boneCount; ++i)
+    {
+        Bone* bone = skeleton->bones[i].get();
+        if (!reader.ReadString(bone->name)
+            || !reader.Read(bone->index)
+            || !reader.Read(bone->parentIndex)
+            || !reader.ReadArray(bone->childrenIndices)
+            || !reader.Read(bone->toParentTransform)
+            || !reader.Read(bone->offsetTransform))
+        {
+            LOG("ModelIO: %s is truncated!", filePath.u8string().c_str());
+            return false;
+        }
+
+        // Indices from a stale or corrupt file must not reach past the bones
+        const auto isBoneIndex = [boneCount](int index) { return index >= 0 && static_cast<uint32_t>(index) < boneCount; };
+        bool validIndices = bone->index == static_cast<int>(i) && (bone->parentIndex == -1 || isBoneIndex(bone->parentIndex));
+        for (int childIndex : bone->childrenIndices)
+        {
+            validIndices &= isBoneIndex(childIndex);
+        }
+        if (!validIndices)
+        {
+            LOG("ModelIO: %s has bone indices out of range!", filePath.u8string().c_str());
+            return false;
+        }
+
+        bone->parent = (bone->parentIndex >= 0) ? skeleton->bones[bone->parentIndex].get() : nullptr;
+        bone->children.resize(bone->childrenIndices.size());
+        for (std::size_t c = 0; c < bone->childrenIndices.size(); ++c)
+        {
+            bone->children[c] = skeleton->bones[bone->childrenIndices[c]].get();
+        }
+    }
+
+    // Every child has to point back at its parent and be listed exactly once, under that parent only, and the root
+    // can't have a parent. Bones in a parent cycle that no root reaches are caught by BuildFlatHierarchy
+    std::vector<uint32_t> childListings(boneCount, 0);
+    bool validHierarchy = skeleton->root->parentIndex == -1;
+    for (const auto& bone : skeleton->bones)
+    {
+        for (const Bone* child : bone->children)
+        {
+            validHierarchy &= child->parent == bone.get();
+            ++childListings[child->index];
+        }
+    }
+    for (uint32_t i = 0; i < boneCount; ++i)
+    {
+        validHierarchy &= childListings[i] == ((skeleton->bones[i]->parentIndex == -1) ? 0u : 1u);
+    }
+    if (!validHierarchy || !skeleton->BuildFlatHierarchy())
+    {
+        LOG("ModelIO: %s has an inconsistent bone hierarchy!", filePath.u8string().c_str());
+        return false;
+    }
+    model.skeleton = std::move(skeleton);
+    return true;
+}
+
+void ModelIO::SaveAnimationBinary(std::filesystem::path filePath, const Model& model)
+{
+    if (model.skeleton == nullptr || model.skeleton->bones.empty() || model.animationClips.empty())
+    {
+        return;
+    }
+
+    const uint32_t animClipCount = static_cast<uint32_t>(model.animationClips.size());
+    FILE* file = OpenBinaryForWrite(filePath, "banimset", BinaryAsset::AnimSet, sizeof(Keyframe<Math::Quaternion>), animClipCount);
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    for (const AnimationClip& animClip : model.animationClips)
+    {
+        WriteString(file, animClip.name);
+        WriteValue(file, animClip.tickDuration);
+        WriteValue(file, animClip.ticksPerSecond);
+
+        const uint32_t boneAnimCount = static_cast<uint32_t>(animClip.boneAnimations.size());
+        WriteValue(file, boneAnimCount);
+        for (const auto& boneAnim : animClip.boneAnimations)
+        {
+            // One byte tag replaces the <NONE>/<ANIMATION> text tags
+            const uint8_t hasAnimation = (boneAnim != nullptr) ? 1 : 0;
+            WriteValue(file, hasAnimation);
+            if (boneAnim != nullptr)
+            {
+                AnimationIO::WriteBinary(file, *boneAnim);
+            }
+        }
+    }
+    fclose(file);
+}
+
+bool ModelIO::LoadAnimationBinary(std::filesystem::path filePath, Model& model)
+{
+    filePath.replace_extension("banimset");
+
+    Core::MappedFile mappedFile;
+    if (!mappedFile.Open(filePath))
+    {
+        return false;
+    }
+
+    const uint8_t* end = mappedFile.GetData() + mappedFile.GetSize();
+    BinaryReader reader(mappedFile.GetData(), end);
+    uint32_t animClipCount = 0;
+    if (!reader.ReadHeader(BinaryAsset::AnimSet, sizeof(Keyframe<Math::Quaternion>), animClipCount))
+    {
+        LOG("ModelIO: %s is not a valid binary animset!", filePath.u8string().c_str());
+        return false;
+    }
+
+    // Clips are only added to the model once the whole file has been read successfully
+    std::vector<AnimationClip> animClips(animClipCount);
+    for (AnimationClip& animClip : animClips)
+    {
+        uint32_t boneAnimCount = 0;
+        if (!reader.ReadString(animClip.name)
+            || !reader.Read(animClip.tickDuration)
+            || !reader.Read(animClip.ticksPerSecond)
+            || !reader.Read(boneAnimCount))
+        {
+            LOG("ModelIO: %s is truncated!", filePath.u8string().c_str());
+            return false;
+        }
+
+        animClip.boneAnimations.resize(boneAnimCount);
+        for (auto& boneAnim : animClip.boneAnimations)
+        {
+            uint8_t hasAnimation = 0;
+            if (!reader.Read(hasAnimation))
+            {
+                LOG("ModelIO: %s is truncated!", filePath.u8string().c_str());
+                return false;
+            }
+            if (hasAnimation == 0)
+            {
+                continue;
+            }
+
+            boneAnim = std::make_unique<Animation>();
+            const uint8_t* next = AnimationIO::ReadBinary(reader.GetCurrent(), end, *boneAnim);
+            if (next == nullptr)
+            {
+                LOG("ModelIO: %s is truncated!", filePath.u8string().c_str());
+                return false;
+            }
+            reader = BinaryReader(next, end);
+        }
+    }
+
+    for (AnimationClip& animClip : animClips)
+    {
+        model.animationClips.push_back(std::move(animClip));
+    }
+    return true;
+}
@@ -1,6 +1,7 @@
 #include "Precompiled.h"
 #include "ModelManager.h"
 #include "ModelIO.h"
+#include "AnimationBuilder.h"
 
 using namespace IExeEngine;
 using namespace IExeEngine::Graphics;
@@ -33,6 +34,11 @@ void ModelManager::SetRootDirectory(const std::filesystem::path& rootPath)
     mRootDirectory = rootPath;
 }
 
+void ModelManager::SetUseBinary(bool useBinary)
+{
+    mUseBinary = useBinary;
+}
+
 ModelId ModelManager::GetModelId(const std::filesystem::path& filePath)
 {
     return std::filesystem::hash_value(mRootDirectory / filePath);
@@ -40,6 +46,8 @@ ModelId ModelManager::GetModelId(const std::filesystem::path& filePath)
 
 ModelId ModelManager::LoadModel(const std::filesystem::path& filePath)
 {
+    PROFILE_SCOPE("ModelManager::LoadModel");
+    MEMORY_TAG(Models);
     const ModelId modelId = GetModelId(filePath);
     auto [iter, success] = mInventory.insert({ modelId, nullptr });
     if (success)
@@ -47,18 +55,38 @@ ModelId ModelManager::LoadModel(const std::filesystem::path& filePath)
         std::filesystem::path fullPath = mRootDirectory / filePath;
         auto& modelPtr = iter->second;
         modelPtr = std::make_unique<Model>();
-        ModelIO::LoadModel(fullPath, *modelPtr);
+        // Prefer the binary containers, the text files are kept as a fallback for debugging
+        if (!mUseBinary || !ModelIO::LoadModelBinary(fullPath, *modelPtr))
+        {
+            ModelIO::LoadModel(fullPath, *modelPtr);
+        }
         ModelIO::LoadMaterial(fullPath, *modelPtr);
-        ModelIO::LoadSkeleton(fullPath, *modelPtr);
+        if (!mUseBinary || !ModelIO::LoadSkeletonBinary(fullPath, *modelPtr))
+        {
+            ModelIO::LoadSkeleton(fullPath, *modelPtr);
+        }
     }
     return modelId;
 }
 
 void ModelManager::AddAnimation(ModelId id, const std::filesystem::path& filePath)
 {
+    PROFILE_SCOPE("ModelManager::AddAnimation");
+    MEMORY_TAG(Animation);
     auto model = mInventory.find(id);
     ASSERT(model != mInventory.end(), "ModelManager: Model not found for animation!");
-    ModelIO::LoadAnimation(filePath, *model->second);
+    std::vector<AnimationClip>& animClips = model->second->animationClips;
+    const size_t firstNewClip = animClips.size();
+    if (!mUseBinary || !ModelIO::LoadAnimationBinary(filePath, *model->second))
+    {
+        ModelIO::LoadAnimation(filePath, *model->second);
+    }
+
+    // Build the runtime form of the newly added clips, one that stays empty isn't retried on the next file
+    for (size_t i = firstNewClip; i < animClips.size(); ++i)
+    {
+        animClips[i].compiled = AnimationBuilder::Build(animClips[i]);
+    }
 }
 
 const Model* ModelManager::GetModel(ModelId id)
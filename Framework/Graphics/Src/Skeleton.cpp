@@ -0,0 +1,63 @@
+#include "Precompiled.h"
+#include "Skeleton.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+bool Skeleton::BuildFlatHierarchy()
+{
+    const size_t boneCount = bones.size();
+    sortedBoneIndices.clear();
+    sortedBoneIndices.reserve(boneCount);
+
+    // Breadth first from every root, the queue itself becomes the sorted order. Each bone is queued at most once so
+    // a bad hierarchy can't make the queue grow past the bone count
+    std::vector<bool> isQueued(boneCount, false);
+    const auto queueBone = [&](int boneIndex)
+    {
+        if (boneIndex < 0 || static_cast<size_t>(boneIndex) >= boneCount || isQueued[boneIndex])
+        {
+            return false;
+        }
+        isQueued[boneIndex] = true;
+        sortedBoneIndices.push_back(boneIndex);
+        return true;
+    };
+    for (const auto& bone : bones)
+    {
+        if (bone->parentIndex < 0 && !queueBone(bone->index))
+        {
+            sortedBoneIndices.clear();
+            return false;
+        }
+    }
+    for (size_t i = 0; i < sortedBoneIndices.size(); ++i)
+    {
+        const Bone* bone = bones[sortedBoneIndices[i]].get();
+        for (int childIndex : bone->childrenIndices)
+        {
+            if (!queueBone(childIndex))
+            {
+                sortedBoneIndices.clear();
+                return false;
+            }
+        }
+    }
+    if (sortedBoneIndices.size() != boneCount)
+    {
+        sortedBoneIndices.clear();
+        return false;
+    }
+
+    sortedParentIndices.resize(sortedBoneIndices.size());
+    sortedToParentTransforms.resize(sortedBoneIndices.size());
+    sortedOffsetTransforms.resize(sortedBoneIndices.size());
+    for (size_t i = 0; i < sortedBoneIndices.size(); ++i)
+    {
+        const Bone* bone = bones[sortedBoneIndices[i]].get();
+        sortedParentIndices[i] = bone->parentIndex;
+        sortedToParentTransforms[i] = bone->toParentTransform;
+        sortedOffsetTransforms[i] = bone->offsetTransform;
+    }
+    return true;
+}
\ No newline at end of file
@@ -143,15 +143,31 @@ void StandardEffect::Render(const RenderGroup& renderGroup)
 
     if (settings.useSkinning > 0)
     {
-        AnimationUtil::BoneTransforms boneTransforms;
-        AnimationUtil::ComputeBoneTransforms(renderGroup.modelId, boneTransforms, renderGroup.animator);
-        AnimationUtil::ApplyBoneOffsets(renderGroup.modelId, boneTransforms);
+        // Only needed until the constant buffer is updated, the scope hands the frame memory back for the next group.
+        // Unused bones stay identity
+        Core::FrameAllocator::Scope frameScope;
+        Core::FrameVector<Math::Matrix4> boneTransforms(MaxBoneCount);
+        size_t boneCount = 0;
+        if (renderGroup.skinningTransforms != nullptr && !renderGroup.skinningTransforms->empty())
+        {
+            boneCount = renderGroup.skinningTransforms->size();
+            ASSERT(boneCount <= MaxBoneCount, "StandardEffect: too many bones for the skinning buffer!");
+            boneCount = std::min(boneCount, MaxBoneCount);
+            std::copy_n(renderGroup.skinningTransforms->begin(), boneCount, boneTransforms.begin());
+        }
+        else
+        {
+            boneCount = renderGroup.skeleton->bones.size();
+            ASSERT(boneCount <= MaxBoneCount, "StandardEffect: too many bones for the skinning buffer!");
+            boneCount = std::min(boneCount, MaxBoneCount);
+            Core::FrameVector<Math::Matrix4> modelTransforms(boneCount);
+            AnimationUtil::ComputeSkinningTransforms(renderGroup.modelId, modelTransforms.data(), boneTransforms.data(), boneCount, renderGroup.animator);
+        }
 
-        for (Math::Matrix4& transform : boneTransforms)
+        for (size_t i = 0; i < boneCount; ++i)
         {
-            transform = Math::Transpose(transform);
+            boneTransforms[i] = Math::Transpose(boneTransforms[i]);
         }
-        boneTransforms.resize(MaxBoneCount);
         mBoneTransformBuffer.Update(boneTransforms.data());
     }
 
@@ -42,6 +42,8 @@ void TextureManager::SetRootDirectory(const std::filesystem::path& root)
 
 TextureId TextureManager::LoadTexture(const std::filesystem::path& filename, bool useRootDir)
 {
+	// CPU side only, the texture memory itself belongs to the D3D driver
+	MEMORY_TAG(Textures);
 	const size_t textureId = std::filesystem::hash_value(filename);
 	auto [iter, success] = mInventory.insert({ textureId, Entry() });
 	if (success)
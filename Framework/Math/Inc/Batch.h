@@ -0,0 +1,17 @@
+#pragma once
+
+namespace IExeEngine::Math
+{
+    struct Vector3;
+    struct Matrix4;
+
+    // Array versions of TransformCoord/TransformNormal and Matrix4 multiply, the matrix rows are loaded once
+    // for the whole batch. results may be the same array as the input
+    void TransformCoords(const Vector3* points, size_t count, const Matrix4& m, Vector3* results);
+    void TransformNormals(const Vector3* normals, size_t count, const Matrix4& m, Vector3* results);
+
+    // results[i] = a[i] * b[i]
+    void MultiplyMatrices(const Matrix4* a, const Matrix4* b, size_t count, Matrix4* results);
+    // results[i] = a[i] * b
+    void MultiplyMatrices(const Matrix4* a, const Matrix4& b, size_t count, Matrix4* results);
+}
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "Quaternion.h"
 #include "Matrix4.h"
 #include "Range.h"
+#include "Batch.h"
 
 namespace IExeEngine::Math
 {
@@ -90,20 +91,24 @@ namespace IExeEngine::Math
 
     inline Vector3 TransformCoord(const Vector3& v, const Matrix4& m)
     {
-        float x = v.x * m._11 + v.y * m._21 + v.z * m._31 + m._41;
-        float y = v.x * m._12 + v.y * m._22 + v.z * m._32 + m._42;
-        float z = v.x * m._13 + v.y * m._23 + v.z * m._33 + m._43;
-
-        return { x, y, z };
+        Vector3 result;
+        Kernels::TransformCoord(v.v.data(), m.v.data(), result.v.data());
+        return result;
     }
 
     inline Vector3 TransformNormal(const Vector3& v, const Matrix4& m)
     {
-        float x = v.x * m._11 + v.y * m._21 + v.z * m._31;
-        float y = v.x * m._12 + v.y * m._22 + v.z * m._32;
-        float z = v.x * m._13 + v.y * m._23 + v.z * m._33;
+        Vector3 result;
+        Kernels::TransformNormal(v.v.data(), m.v.data(), result.v.data());
+        return result;
+    }
 
-        return { x, y, z };
+    // Same result as TransformNormal(v, Matrix4::MatrixRotationQuaternion(q)) for a unit q, without building the matrix
+    inline Vector3 Rotate(const Vector3& v, const Quaternion& q)
+    {
+        const Vector3 u = { q.x, q.y, q.z };
+        const Vector3 t = Cross(u, v) * 2.0f;
+        return v + (t * q.w) + Cross(u, t);
     }
 
     inline Matrix4 Transpose(const Matrix4& m)
@@ -181,9 +186,42 @@ namespace IExeEngine::Math
     }
     inline Matrix4 Inverse(const Matrix4& m)
     {
+#if defined(IEXE_MATH_SSE)
+        Matrix4 result;
+        Kernels::InverseMatrix(m.v.data(), result.v.data());
+        return result;
+#else
         const float determinant = Determinant(m);
         const float invDet = 1.0f / determinant;
         return Adjoint(m) * invDet;
+#endif
+    }
+
+    // Fast paths for matrices whose last column is (0, 0, 0, 1), which covers Transform::GetMatrix4,
+    // bone and offset transforms and camera views. Passing a projection matrix gives wrong results.
+
+    // a * b for affine a and b, 36 multiplies instead of 64
+    inline Matrix4 MultiplyAffine(const Matrix4& a, const Matrix4& b)
+    {
+        Matrix4 result;
+        Kernels::MultiplyAffine(a.v.data(), b.v.data(), result.v.data());
+        return result;
+    }
+
+    // Inverts the 3x3 part by cofactors and moves the translation through it, about a third of the work of Inverse
+    inline Matrix4 InverseAffine(const Matrix4& m)
+    {
+        Matrix4 result;
+        Kernels::InverseAffine(m.v.data(), result.v.data());
+        return result;
+    }
+
+    // Rotation and translation only (no scale), the inverse rotation is the transpose
+    inline Matrix4 InverseRigid(const Matrix4& m)
+    {
+        Matrix4 result;
+        Kernels::InverseRigid(m.v.data(), result.v.data());
+        return result;
     }
 
     inline Vector3 GetTranslation(const Matrix4& m)
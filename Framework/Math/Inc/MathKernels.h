@@ -0,0 +1,371 @@
+#pragma once
+
+// Instruction set used by the Math kernels, picked at compile time:
+//   IEXE_MATH_AVX2   - 256 bit paths for the batch entry points (/arch:AVX2 or -mavx2)
+//   IEXE_MATH_SSE    - 128 bit paths, always available on x86/x64 with MSVC (-msse3 elsewhere)
+//   neither          - the original scalar code
+// Define IEXE_MATH_FORCE_SCALAR to build the scalar fallback on any target.
+// The SIMD kernels keep the scalar summation order and never fuse multiply-adds, so multiplies and
+// transforms are bit identical to the scalar code, only the inverse takes a different (cofactor) route
+#if !defined(IEXE_MATH_FORCE_SCALAR)
+    #if defined(__AVX2__)
+        #define IEXE_MATH_AVX2 1
+        #define IEXE_MATH_SSE 1
+    #elif defined(_M_X64) || defined(_M_IX86) || defined(__SSE3__)
+        #define IEXE_MATH_SSE 1
+    #endif
+#endif
+
+#if defined(IEXE_MATH_SSE)
+#include <immintrin.h>
+#endif
+
+namespace IExeEngine::Math::Kernels
+{
+    // Matrices are 16 row-major floats (row vectors, v * M), points and normals are 3 floats
+
+    namespace Scalar
+    {
+        inline void MultiplyMatrix(const float* a, const float* b, float* result)
+        {
+            float r[16];
+            for (int row = 0; row < 4; ++row)
+            {
+                const float* ar = a + row * 4;
+                for (int col = 0; col < 4; ++col)
+                {
+                    r[row * 4 + col] = (ar[0] * b[col]) + (ar[1] * b[4 + col]) + (ar[2] * b[8 + col]) + (ar[3] * b[12 + col]);
+                }
+            }
+            for (int i = 0; i < 16; ++i)
+            {
+                result[i] = r[i];
+            }
+        }
+
+        // a and b are affine (last column 0, 0, 0, 1), the zero terms are skipped
+        inline void MultiplyAffine(const float* a, const float* b, float* result)
+        {
+            const float r11 = (a[0] * b[0]) + (a[1] * b[4]) + (a[2] * b[8]);
+            const float r12 = (a[0] * b[1]) + (a[1] * b[5]) + (a[2] * b[9]);
+            const float r13 = (a[0] * b[2]) + (a[1] * b[6]) + (a[2] * b[10]);
+            const float r21 = (a[4] * b[0]) + (a[5] * b[4]) + (a[6] * b[8]);
+            const float r22 = (a[4] * b[1]) + (a[5] * b[5]) + (a[6] * b[9]);
+            const float r23 = (a[4] * b[2]) + (a[5] * b[6]) + (a[6] * b[10]);
+            const float r31 = (a[8] * b[0]) + (a[9] * b[4]) + (a[10] * b[8]);
+            const float r32 = (a[8] * b[1]) + (a[9] * b[5]) + (a[10] * b[9]);
+            const float r33 = (a[8] * b[2]) + (a[9] * b[6]) + (a[10] * b[10]);
+            const float r41 = (a[12] * b[0]) + (a[13] * b[4]) + (a[14] * b[8]) + b[12];
+            const float r42 = (a[12] * b[1]) + (a[13] * b[5]) + (a[14] * b[9]) + b[13];
+            const float r43 = (a[12] * b[2]) + (a[13] * b[6]) + (a[14] * b[10]) + b[14];
+            result[0] = r11; result[1] = r12; result[2] = r13; result[3] = 0.0f;
+            result[4] = r21; result[5] = r22; result[6] = r23; result[7] = 0.0f;
+            result[8] = r31; result[9] = r32; result[10] = r33; result[11] = 0.0f;
+            result[12] = r41; result[13] = r42; result[14] = r43; result[15] = 1.0f;
+        }
+
+        inline void TransformCoord(const float* v, const float* m, float* result)
+        {
+            const float x = v[0] * m[0] + v[1] * m[4] + v[2] * m[8] + m[12];
+            const float y = v[0] * m[1] + v[1] * m[5] + v[2] * m[9] + m[13];
+            const float z = v[0] * m[2] + v[1] * m[6] + v[2] * m[10] + m[14];
+            result[0] = x;
+            result[1] = y;
+            result[2] = z;
+        }
+
+        inline void TransformNormal(const float* v, const float* m, float* result)
+        {
+            const float x = v[0] * m[0] + v[1] * m[4] + v[2] * m[8];
+            const float y = v[0] * m[1] + v[1] * m[5] + v[2] * m[9];
+            const float z = v[0] * m[2] + v[1] * m[6] + v[2] * m[10];
+            result[0] = x;
+            result[1] = y;
+            result[2] = z;
+        }
+
+        inline void InverseAffine(const float* m, float* result)
+        {
+            // Cofactors of the 3x3 part, the columns of the inverse before the divide
+            const float c11 = (m[5] * m[10]) - (m[6] * m[9]);
+            const float c12 = (m[6] * m[8]) - (m[4] * m[10]);
+            const float c13 = (m[4] * m[9]) - (m[5] * m[8]);
+            const float c21 = (m[9] * m[2]) - (m[10] * m[1]);
+            const float c22 = (m[10] * m[0]) - (m[8] * m[2]);
+            const float c23 = (m[8] * m[1]) - (m[9] * m[0]);
+            const float c31 = (m[1] * m[6]) - (m[2] * m[5]);
+            const float c32 = (m[2] * m[4]) - (m[0] * m[6]);
+            const float c33 = (m[0] * m[5]) - (m[1] * m[4]);
+            const float invDet = 1.0f / ((m[0] * c11) + (m[1] * c12) + (m[2] * c13));
+
+            float r[16] = {
+                c11 * invDet, c21 * invDet, c31 * invDet, 0.0f,
+                c12 * invDet, c22 * invDet, c32 * invDet, 0.0f,
+                c13 * invDet, c23 * invDet, c33 * invDet, 0.0f,
+                0.0f, 0.0f, 0.0f, 1.0f
+            };
+            for (int col = 0; col < 3; ++col)
+            {
+                r[12 + col] = 0.0f - ((m[12] * r[col]) + (m[13] * r[4 + col]) + (m[14] * r[8 + col]));
+            }
+            for (int i = 0; i < 16; ++i)
+            {
+                result[i] = r[i];
+            }
+        }
+
+        inline void InverseRigid(const float* m, float* result)
+        {
+            float r[16] = {
+                m[0], m[4], m[8], 0.0f,
+                m[1], m[5], m[9], 0.0f,
+                m[2], m[6], m[10], 0.0f,
+                0.0f, 0.0f, 0.0f, 1.0f
+            };
+            for (int col = 0; col < 3; ++col)
+            {
+                r[12 + col] = 0.0f - ((m[12] * r[col]) + (m[13] * r[4 + col]) + (m[14] * r[8 + col]));
+            }
+            for (int i = 0; i < 16; ++i)
+            {
+                result[i] = r[i];
+            }
+        }
+
+        inline void BlendQuaternion(const float* q0, float scale0, const float* q1, float scale1, float* result)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                result[i] = (q0[i] * scale0) + (q1[i] * scale1);
+            }
+        }
+    }
+
+#if defined(IEXE_MATH_SSE)
+    namespace SSE
+    {
+        template<int X, int Y, int Z, int W>
+        inline __m128 Swizzle(__m128 v)
+        {
+            return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+        }
+
+        template<int X, int Y, int Z, int W>
+        inline __m128 Shuffle(__m128 a, __m128 b)
+        {
+            return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+        }
+
+        // row * M, summed in the same order as the scalar code
+        inline __m128 MultiplyRow(__m128 row, __m128 m0, __m128 m1, __m128 m2, __m128 m3)
+        {
+            __m128 r = _mm_mul_ps(Swizzle<0, 0, 0, 0>(row), m0);
+            r = _mm_add_ps(r, _mm_mul_ps(Swizzle<1, 1, 1, 1>(row), m1));
+            r = _mm_add_ps(r, _mm_mul_ps(Swizzle<2, 2, 2, 2>(row), m2));
+            return _mm_add_ps(r, _mm_mul_ps(Swizzle<3, 3, 3, 3>(row), m3));
+        }
+
+        inline __m128 Cross(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b)), _mm_mul_ps(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b)));
+        }
+
+        // Rows 0-2 hold the inverse 3x3 part (w = 0), writes them and -t * inverse with w = 1
+        inline void StoreAffineInverse(__m128 i0, __m128 i1, __m128 i2, __m128 t, float* result)
+        {
+            __m128 it = _mm_mul_ps(Swizzle<0, 0, 0, 0>(t), i0);
+            it = _mm_add_ps(it, _mm_mul_ps(Swizzle<1, 1, 1, 1>(t), i1));
+            it = _mm_add_ps(it, _mm_mul_ps(Swizzle<2, 2, 2, 2>(t), i2));
+            _mm_storeu_ps(result, i0);
+            _mm_storeu_ps(result + 4, i1);
+            _mm_storeu_ps(result + 8, i2);
+            _mm_storeu_ps(result + 12, _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), it));
+        }
+
+        // 2x2 helpers for the block inverse, each register holds a row-major 2x2 matrix (m00, m01, m10, m11)
+        inline __m128 Mat2Mul(__m128 a, __m128 b)
+        {
+            return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+        }
+
+        // adj(a) * b
+        inline __m128 Mat2AdjMul(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+        }
+
+        // a * adj(b)
+        inline __m128 Mat2MulAdj(__m128 a, __m128 b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+        }
+    }
+#endif
+
+    inline void MultiplyMatrix(const float* a, const float* b, float* result)
+    {
+#if defined(IEXE_MATH_AVX2)
+        // Two rows of a per register, b's rows repeated in both halves
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+        const __m256 a01 = _mm256_loadu_ps(a);
+        const __m256 a23 = _mm256_loadu_ps(a + 8);
+
+        __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0);
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3));
+
+        __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0);
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3));
+
+        _mm256_storeu_ps(result, r01);
+        _mm256_storeu_ps(result + 8, r23);
+#elif defined(IEXE_MATH_SSE)
+        const __m128 b0 = _mm_loadu_ps(b);
+        const __m128 b1 = _mm_loadu_ps(b + 4);
+        const __m128 b2 = _mm_loadu_ps(b + 8);
+        const __m128 b3 = _mm_loadu_ps(b + 12);
+        const __m128 r0 = SSE::MultiplyRow(_mm_loadu_ps(a), b0, b1, b2, b3);
+        const __m128 r1 = SSE::MultiplyRow(_mm_loadu_ps(a + 4), b0, b1, b2, b3);
+        const __m128 r2 = SSE::MultiplyRow(_mm_loadu_ps(a + 8), b0, b1, b2, b3);
+        const __m128 r3 = SSE::MultiplyRow(_mm_loadu_ps(a + 12), b0, b1, b2, b3);
+        _mm_storeu_ps(result, r0);
+        _mm_storeu_ps(result + 4, r1);
+        _mm_storeu_ps(result + 8, r2);
+        _mm_storeu_ps(result + 12, r3);
+#else
+        Scalar::MultiplyMatrix(a, b, result);
+#endif
+    }
+
+    inline void MultiplyAffine(const float* a, const float* b, float* result)
+    {
+#if defined(IEXE_MATH_SSE)
+        // A register holds the w column anyway, dropping it saves no instructions and the full product is identical for affine inputs
+        MultiplyMatrix(a, b, result);
+#else
+        Scalar::MultiplyAffine(a, b, result);
+#endif
+    }
+
+    // A lone Vector3 costs more to pack into a register than the nine multiplies save,
+    // single transforms stay scalar and TransformCoords/TransformNormals do the SIMD work
+    inline void TransformCoord(const float* v, const float* m, float* result)
+    {
+        Scalar::TransformCoord(v, m, result);
+    }
+
+    inline void TransformNormal(const float* v, const float* m, float* result)
+    {
+        Scalar::TransformNormal(v, m, result);
+    }
+
+#if defined(IEXE_MATH_SSE)
+    // General 4x4 inverse through 2x2 blocks, m = | A B |
+    //                                            | C D |
+    inline void InverseMatrix(const float* m, float* result)
+    {
+        const __m128 row0 = _mm_loadu_ps(m);
+        const __m128 row1 = _mm_loadu_ps(m + 4);
+        const __m128 row2 = _mm_loadu_ps(m + 8);
+        const __m128 row3 = _mm_loadu_ps(m + 12);
+
+        const __m128 A = _mm_movelh_ps(row0, row1);
+        const __m128 B = _mm_movehl_ps(row1, row0);
+        const __m128 C = _mm_movelh_ps(row2, row3);
+        const __m128 D = _mm_movehl_ps(row3, row2);
+
+        // (|A|, |B|, |C|, |D|)
+        const __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(SSE::Shuffle<0, 2, 0, 2>(row0, row2), SSE::Shuffle<1, 3, 1, 3>(row1, row3)),
+            _mm_mul_ps(SSE::Shuffle<1, 3, 1, 3>(row0, row2), SSE::Shuffle<0, 2, 0, 2>(row1, row3)));
+        const __m128 detA = SSE::Swizzle<0, 0, 0, 0>(detSub);
+        const __m128 detB = SSE::Swizzle<1, 1, 1, 1>(detSub);
+        const __m128 detC = SSE::Swizzle<2, 2, 2, 2>(detSub);
+        const __m128 detD = SSE::Swizzle<3, 3, 3, 3>(detSub);
+
+        const __m128 DC = SSE::Mat2AdjMul(D, C);
+        const __m128 AB = SSE::Mat2AdjMul(A, B);
+        __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), SSE::Mat2Mul(B, DC));
+        __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), SSE::Mat2Mul(C, AB));
+        __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), SSE::Mat2MulAdj(D, AB));
+        __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), SSE::Mat2MulAdj(A, DC));
+
+        // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+        __m128 trace = _mm_mul_ps(AB, SSE::Swizzle<0, 2, 1, 3>(DC));
+        trace = _mm_hadd_ps(trace, trace);
+        trace = _mm_hadd_ps(trace, trace);
+        const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+        const __m128 invDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+        X = _mm_mul_ps(X, invDetM);
+        Y = _mm_mul_ps(Y, invDetM);
+        Z = _mm_mul_ps(Z, invDetM);
+        W = _mm_mul_ps(W, invDetM);
+
+        // Adjugate the blocks while interleaving them back into rows
+        _mm_storeu_ps(result, SSE::Shuffle<3, 1, 3, 1>(X, Y));
+        _mm_storeu_ps(result + 4, SSE::Shuffle<2, 0, 2, 0>(X, Y));
+        _mm_storeu_ps(result + 8, SSE::Shuffle<3, 1, 3, 1>(Z, W));
+        _mm_storeu_ps(result + 12, SSE::Shuffle<2, 0, 2, 0>(Z, W));
+    }
+#endif
+
+    // Affine and rigid inverses, m's last column must be (0, 0, 0, 1)
+    inline void InverseAffine(const float* m, float* result)
+    {
+#if defined(IEXE_MATH_SSE)
+        // Masked so a garbage w can't leak into the cross products
+        const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        const __m128 r0 = _mm_and_ps(_mm_loadu_ps(m), xyzMask);
+        const __m128 r1 = _mm_and_ps(_mm_loadu_ps(m + 4), xyzMask);
+        const __m128 r2 = _mm_and_ps(_mm_loadu_ps(m + 8), xyzMask);
+
+        // The cross products are the columns of the adjugate
+        __m128 c0 = SSE::Cross(r1, r2);
+        __m128 c1 = SSE::Cross(r2, r0);
+        __m128 c2 = SSE::Cross(r0, r1);
+        __m128 det = _mm_mul_ps(r0, c0);
+        det = _mm_hadd_ps(det, det);
+        det = _mm_hadd_ps(det, det);
+        const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+        c0 = _mm_mul_ps(c0, invDet);
+        c1 = _mm_mul_ps(c1, invDet);
+        c2 = _mm_mul_ps(c2, invDet);
+        __m128 c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        SSE::StoreAffineInverse(c0, c1, c2, _mm_loadu_ps(m + 12), result);
+#else
+        Scalar::InverseAffine(m, result);
+#endif
+    }
+
+    inline void InverseRigid(const float* m, float* result)
+    {
+#if defined(IEXE_MATH_SSE)
+        __m128 r0 = _mm_loadu_ps(m);
+        __m128 r1 = _mm_loadu_ps(m + 4);
+        __m128 r2 = _mm_loadu_ps(m + 8);
+        __m128 r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        SSE::StoreAffineInverse(r0, r1, r2, _mm_loadu_ps(m + 12), result);
+#else
+        Scalar::InverseRigid(m, result);
+#endif
+    }
+
+    inline void BlendQuaternion(const float* q0, float scale0, const float* q1, float scale1, float* result)
+    {
+#if defined(IEXE_MATH_SSE)
+        const __m128 r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(q0), _mm_set1_ps(scale0)), _mm_mul_ps(_mm_loadu_ps(q1), _mm_set1_ps(scale1)));
+        _mm_storeu_ps(result, r);
+#else
+        Scalar::BlendQuaternion(q0, scale0, q1, scale1, result);
+#endif
+    }
+}
\ No newline at end of file
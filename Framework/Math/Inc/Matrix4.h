@@ -1,5 +1,7 @@
 #pragma once
 
+#include "MathKernels.h"
+
 namespace IExeEngine::Math
 {
     struct Matrix4
@@ -181,28 +183,11 @@ namespace IExeEngine::Math
                 _31 - rhs._31, _32 - rhs._32, _33 - rhs._33, _34 - rhs._34,
                 _41 - rhs._41, _42 - rhs._42, _43 - rhs._43, _44 - rhs._44);
         }
-        constexpr Matrix4 operator*(const Matrix4& rhs) const
+        Matrix4 operator*(const Matrix4& rhs) const
         {
-            return Matrix4(
-                (_11 * rhs._11) + (_12 * rhs._21) + (_13 * rhs._31) + (_14 * rhs._41),
-                (_11 * rhs._12) + (_12 * rhs._22) + (_13 * rhs._32) + (_14 * rhs._42),
-                (_11 * rhs._13) + (_12 * rhs._23) + (_13 * rhs._33) + (_14 * rhs._43),
-                (_11 * rhs._14) + (_12 * rhs._24) + (_13 * rhs._34) + (_14 * rhs._44),
-
-                (_21 * rhs._11) + (_22 * rhs._21) + (_23 * rhs._31) + (_24 * rhs._41),
-                (_21 * rhs._12) + (_22 * rhs._22) + (_23 * rhs._32) + (_24 * rhs._42),
-                (_21 * rhs._13) + (_22 * rhs._23) + (_23 * rhs._33) + (_24 * rhs._43),
-                (_21 * rhs._14) + (_22 * rhs._24) + (_23 * rhs._34) + (_24 * rhs._44),
-
-                (_31 * rhs._11) + (_32 * rhs._21) + (_33 * rhs._31) + (_34 * rhs._41),
-                (_31 * rhs._12) + (_32 * rhs._22) + (_33 * rhs._32) + (_34 * rhs._42),
-                (_31 * rhs._13) + (_32 * rhs._23) + (_33 * rhs._33) + (_34 * rhs._43),
-                (_31 * rhs._14) + (_32 * rhs._24) + (_33 * rhs._34) + (_34 * rhs._44),
-
-                (_41 * rhs._11) + (_42 * rhs._21) + (_43 * rhs._31) + (_44 * rhs._41),
-                (_41 * rhs._12) + (_42 * rhs._22) + (_43 * rhs._32) + (_44 * rhs._42),
-                (_41 * rhs._13) + (_42 * rhs._23) + (_43 * rhs._33) + (_44 * rhs._43),
-                (_41 * rhs._14) + (_42 * rhs._24) + (_43 * rhs._34) + (_44 * rhs._44));
+            Matrix4 result;
+            Kernels::MultiplyMatrix(v.data(), rhs.v.data(), result.v.data());
+            return result;
         }
         constexpr Matrix4 operator*(float s) const
         {
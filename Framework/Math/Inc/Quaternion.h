@@ -27,6 +27,9 @@ namespace IExeEngine::Math
         Quaternion operator*(float s) const { return Quaternion(x * s, y * s, z * s, w * s); }
         Quaternion operator/(float s) const { return Quaternion(x / s, y / s, z / s, w / s); }
 
+        // Hamilton product, a * b rotates by b first and then by a (Matrix4 order is the reverse)
+        Quaternion operator*(const Quaternion& rhs) const;
+
         // Constants
         static const Quaternion Identity;
         static const Quaternion Zero;
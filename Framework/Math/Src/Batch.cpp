@@ -0,0 +1,189 @@
+#include "Precompiled.h"
+#include "DWMath.h"
+
+using namespace IExeEngine::Math;
+
+namespace
+{
+#if defined(IEXE_MATH_SSE)
+    // Thin wrappers so the transform kernel is written once for both register widths,
+    // each 128 bit half of an AVX register works on its own group of four points
+#if defined(IEXE_MATH_AVX2)
+    using Lanes = __m256;
+    constexpr size_t PointsPerStep = 8;
+
+    inline void Load(const float* data, Lanes& a, Lanes& b, Lanes& c)
+    {
+        a = _mm256_set_m128(_mm_loadu_ps(data + 12), _mm_loadu_ps(data));
+        b = _mm256_set_m128(_mm_loadu_ps(data + 16), _mm_loadu_ps(data + 4));
+        c = _mm256_set_m128(_mm_loadu_ps(data + 20), _mm_loadu_ps(data + 8));
+    }
+    inline void Store(float* data, Lanes a, Lanes b, Lanes c)
+    {
+        _mm_storeu_ps(data, _mm256_castps256_ps128(a));
+        _mm_storeu_ps(data + 4, _mm256_castps256_ps128(b));
+        _mm_storeu_ps(data + 8, _mm256_castps256_ps128(c));
+        _mm_storeu_ps(data + 12, _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(data + 16, _mm256_extractf128_ps(b, 1));
+        _mm_storeu_ps(data + 20, _mm256_extractf128_ps(c, 1));
+    }
+    template<int X, int Y, int Z, int W>
+    inline Lanes Shuffle(Lanes a, Lanes b) { return _mm256_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+    inline Lanes Splat(float value) { return _mm256_set1_ps(value); }
+    inline Lanes Add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+    inline Lanes Mul(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+#else
+    using Lanes = __m128;
+    constexpr size_t PointsPerStep = 4;
+
+    inline void Load(const float* data, Lanes& a, Lanes& b, Lanes& c)
+    {
+        a = _mm_loadu_ps(data);
+        b = _mm_loadu_ps(data + 4);
+        c = _mm_loadu_ps(data + 8);
+    }
+    inline void Store(float* data, Lanes a, Lanes b, Lanes c)
+    {
+        _mm_storeu_ps(data, a);
+        _mm_storeu_ps(data + 4, b);
+        _mm_storeu_ps(data + 8, c);
+    }
+    template<int X, int Y, int Z, int W>
+    inline Lanes Shuffle(Lanes a, Lanes b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+    inline Lanes Splat(float value) { return _mm_set1_ps(value); }
+    inline Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+    inline Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+#endif
+
+    // Splits four packed points (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) into x, y and z registers
+    inline void Deinterleave(Lanes a, Lanes b, Lanes c, Lanes& x, Lanes& y, Lanes& z)
+    {
+        const Lanes a1a2b0b1 = Shuffle<1, 2, 0, 1>(a, b);
+        x = Shuffle<0, 3, 0, 3>(a, Shuffle<2, 3, 0, 1>(b, c));
+        y = Shuffle<0, 2, 0, 2>(a1a2b0b1, Shuffle<3, 3, 2, 2>(b, c));
+        z = Shuffle<1, 3, 0, 3>(a1a2b0b1, c);
+    }
+
+    inline void Interleave(Lanes x, Lanes y, Lanes z, Lanes& a, Lanes& b, Lanes& c)
+    {
+        a = Shuffle<0, 2, 0, 2>(Shuffle<0, 1, 0, 1>(x, y), Shuffle<0, 0, 1, 1>(z, x));
+        b = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 1, 1>(y, z), Shuffle<2, 2, 2, 2>(x, y));
+        c = Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 3, 3>(z, x), Shuffle<3, 3, 3, 3>(y, z));
+    }
+#endif
+
+    // Structure-of-arrays over groups of points, summed in the same order as the scalar TransformCoord
+    template<bool IsCoord>
+    void TransformPoints(const Vector3* points, size_t count, const Matrix4& m, Vector3* results)
+    {
+        size_t i = 0;
+#if defined(IEXE_MATH_SSE)
+        const Lanes m11 = Splat(m._11), m12 = Splat(m._12), m13 = Splat(m._13);
+        const Lanes m21 = Splat(m._21), m22 = Splat(m._22), m23 = Splat(m._23);
+        const Lanes m31 = Splat(m._31), m32 = Splat(m._32), m33 = Splat(m._33);
+        const Lanes m41 = Splat(m._41), m42 = Splat(m._42), m43 = Splat(m._43);
+        for (; i + PointsPerStep <= count; i += PointsPerStep)
+        {
+            Lanes a, b, c, x, y, z;
+            Load(&points[i].x, a, b, c);
+            Deinterleave(a, b, c, x, y, z);
+
+            Lanes rx = Add(Add(Mul(x, m11), Mul(y, m21)), Mul(z, m31));
+            Lanes ry = Add(Add(Mul(x, m12), Mul(y, m22)), Mul(z, m32));
+            Lanes rz = Add(Add(Mul(x, m13), Mul(y, m23)), Mul(z, m33));
+            if constexpr (IsCoord)
+            {
+                rx = Add(rx, m41);
+                ry = Add(ry, m42);
+                rz = Add(rz, m43);
+            }
+
+            Interleave(rx, ry, rz, a, b, c);
+            Store(&results[i].x, a, b, c);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            if constexpr (IsCoord)
+            {
+                Kernels::Scalar::TransformCoord(&points[i].x, m.v.data(), &results[i].x);
+            }
+            else
+            {
+                Kernels::Scalar::TransformNormal(&points[i].x, m.v.data(), &results[i].x);
+            }
+        }
+    }
+}
+
+void IExeEngine::Math::TransformCoords(const Vector3* points, size_t count, const Matrix4& m, Vector3* results)
+{
+    TransformPoints<true>(points, count, m, results);
+}
+
+void IExeEngine::Math::TransformNormals(const Vector3* normals, size_t count, const Matrix4& m, Vector3* results)
+{
+    TransformPoints<false>(normals, count, m, results);
+}
+
+void IExeEngine::Math::MultiplyMatrices(const Matrix4* a, const Matrix4* b, size_t count, Matrix4* results)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        Kernels::MultiplyMatrix(a[i].v.data(), b[i].v.data(), results[i].v.data());
+    }
+}
+
+void IExeEngine::Math::MultiplyMatrices(const Matrix4* a, const Matrix4& b, size_t count, Matrix4* results)
+{
+#if defined(IEXE_MATH_AVX2)
+    const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b._11));
+    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b._21));
+    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b._31));
+    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b._41));
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float* ai = a[i].v.data();
+        const __m256 a01 = _mm256_loadu_ps(ai);
+        const __m256 a23 = _mm256_loadu_ps(ai + 8);
+
+        __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0);
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3));
+
+        __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0);
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3));
+
+        float* ri = results[i].v.data();
+        _mm256_storeu_ps(ri, r01);
+        _mm256_storeu_ps(ri + 8, r23);
+    }
+#elif defined(IEXE_MATH_SSE)
+    const __m128 b0 = _mm_loadu_ps(&b._11);
+    const __m128 b1 = _mm_loadu_ps(&b._21);
+    const __m128 b2 = _mm_loadu_ps(&b._31);
+    const __m128 b3 = _mm_loadu_ps(&b._41);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float* ai = a[i].v.data();
+        const __m128 r0 = Kernels::SSE::MultiplyRow(_mm_loadu_ps(ai), b0, b1, b2, b3);
+        const __m128 r1 = Kernels::SSE::MultiplyRow(_mm_loadu_ps(ai + 4), b0, b1, b2, b3);
+        const __m128 r2 = Kernels::SSE::MultiplyRow(_mm_loadu_ps(ai + 8), b0, b1, b2, b3);
+        const __m128 r3 = Kernels::SSE::MultiplyRow(_mm_loadu_ps(ai + 12), b0, b1, b2, b3);
+
+        float* ri = results[i].v.data();
+        _mm_storeu_ps(ri, r0);
+        _mm_storeu_ps(ri + 4, r1);
+        _mm_storeu_ps(ri + 8, r2);
+        _mm_storeu_ps(ri + 12, r3);
+    }
+#else
+    for (size_t i = 0; i < count; ++i)
+    {
+        Kernels::Scalar::MultiplyMatrix(a[i].v.data(), b.v.data(), results[i].v.data());
+    }
+#endif
+}
\ No newline at end of file
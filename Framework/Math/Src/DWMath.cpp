@@ -27,6 +27,16 @@ const Matrix4 Matrix4::Identity({ 1, 0, 0, 0,
 // Quaternion
 const Quaternion Quaternion::Identity = { 0.0f, 0.0f, 0.0f, 1.0f };
 const Quaternion Quaternion::Zero = { 0.0f, 0.0f, 0.0f, 0.0f };
+Quaternion Quaternion::operator*(const Quaternion& rhs) const
+{
+    return {
+        w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+        w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+        w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
+        w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z
+    };
+}
+
 void Quaternion::Conjugate() noexcept
 {
     x = -x;
@@ -161,13 +171,8 @@ Quaternion Quaternion::Slerp(const Quaternion& q0, const Quaternion& q1, float t
     float scale0 = sinf(theta * (1.0f - t)) / sinTheta;
     float scale1 = q1Scale * sinf(theta * t) / sinTheta;
 
-    Quaternion q =
-    {
-        (q0.x * scale0) + (q1.x * scale1),
-        (q0.y * scale0) + (q1.y * scale1),
-        (q0.z * scale0) + (q1.z * scale1),
-        (q0.w * scale0) + (q1.w * scale1)
-    };
+    Quaternion q;
+    Kernels::BlendQuaternion(&q0.x, scale0, &q1.x, scale1, &q.x);
 
     return Normalize(q);
 }
\ No newline at end of file
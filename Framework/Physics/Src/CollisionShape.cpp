@@ -12,30 +12,35 @@ CollisionShape::~CollisionShape()
 void CollisionShape::InitializeEmpty()
 {
     ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    MEMORY_TAG(Physics);
     mCollisionShape = new btEmptyShape();
 }
 
 void CollisionShape::InitializeSphere(float radius)
 {
     ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    MEMORY_TAG(Physics);
     mCollisionShape = new btSphereShape(radius);
 }
 
 void CollisionShape::InitializeCapsule(float radius, float height)
 {
     ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    MEMORY_TAG(Physics);
     mCollisionShape = new btCapsuleShape(radius, height);
 }
 
 void CollisionShape::InitializeBox(const Math::Vector3& halfExtents)
 {
     ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    MEMORY_TAG(Physics);
     mCollisionShape = new btBoxShape(ToBtVector3(halfExtents));
 }
 
 void CollisionShape::InitializeHull(const Math::Vector3& halfExtents, const Math::Vector3& origin)
 {
     ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    MEMORY_TAG(Physics);
     btConvexHullShape* hullShape = new btConvexHullShape();
     std::vector<Math::Vector3> points =
     {
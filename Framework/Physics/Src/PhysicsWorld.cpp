@@ -8,11 +8,30 @@ using namespace IExeEngine::Physics;
 namespace
 {
     std::unique_ptr<PhysicsWorld> sPhysicsWorld;
+
+    void* AllocateBullet(size_t size)
+    {
+        return Core::MemoryTracker::Allocate(size, alignof(std::max_align_t));
+    }
+
+    void* AllocateBulletAligned(size_t size, int alignment)
+    {
+        return Core::MemoryTracker::Allocate(size, static_cast<size_t>(alignment));
+    }
+
+    void FreeBullet(void* ptr)
+    {
+        Core::MemoryTracker::Free(ptr);
+    }
 }
 
 void PhysicsWorld::StaticInitialize(const Settings& settings)
 {
     ASSERT(sPhysicsWorld == nullptr, "PhysicsWorld: Already Initialized!");
+    // Bullet allocates with malloc behind its own operator new, send it through the tracker instead. Has to
+    // happen before Bullet allocates anything, memory can't be freed by the other allocator
+    btAlignedAllocSetCustom(&AllocateBullet, &FreeBullet);
+    btAlignedAllocSetCustomAligned(&AllocateBulletAligned, &FreeBullet);
     sPhysicsWorld = std::make_unique<PhysicsWorld>();
     sPhysicsWorld->Initialize(settings);
 }
@@ -39,6 +58,7 @@ PhysicsWorld::~PhysicsWorld()
 
 void PhysicsWorld::Initialize(const Settings& settings)
 {
+    MEMORY_TAG(Physics);
     mSettings = settings;
     mInterface = new btDbvtBroadphase();
     mSolver = new btSequentialImpulseConstraintSolver();
@@ -82,6 +102,8 @@ void PhysicsWorld::Terminate()
 
 void PhysicsWorld::Update(float deltaTime)
 {
+    PROFILE_SCOPE("PhysicsWorld::Update");
+    MEMORY_TAG(Physics);
     mDynamicsWorld->stepSimulation(deltaTime, mSettings.simulationSteps, mSettings.fixedTimeStep);
     for (PhysicsObject* obj : mPhysicsObjects)
     {
@@ -13,6 +13,7 @@ RigidBody::~RigidBody()
 
 void RigidBody::Initialize(Graphics::Transform& graphicsTransform, const CollisionShape& shape, float mass, bool addToWorld)
 {
+	MEMORY_TAG(Physics);
 	mGraphicsTransform = &graphicsTransform;
 	mMass = mass;
 
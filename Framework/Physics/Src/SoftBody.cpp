@@ -13,6 +13,7 @@ SoftBody::~SoftBody()
 
 void SoftBody::Initialize(Graphics::Mesh& mesh, float mass, const std::vector<uint32_t>& fixedNodeIndices, bool linkEdges)
 {
+    MEMORY_TAG(Physics);
 #ifdef USE_SOFT_BODY
     btSoftRigidDynamicsWorld* world = PhysicsWorld::Get()->GetSoftBodyWorld();
     ASSERT(world != nullptr, "SoftBody: Soft body world does not exist!");
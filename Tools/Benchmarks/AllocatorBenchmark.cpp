@@ -0,0 +1,307 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    constexpr std::size_t BlockSize = 64;
+    constexpr uint32_t LiveBlocksPerThread = 64;
+    constexpr uint32_t BatchSize = 16;
+
+    uint32_t GetMaxThreads()
+    {
+        return std::max(2u, std::min(16u, std::thread::hardware_concurrency()));
+    }
+
+    // Enough blocks for every thread's live set plus what its magazine may be holding on to
+    std::size_t GetCapacity(uint32_t threadCount)
+    {
+        return threadCount * (LiveBlocksPerThread + ConcurrentBlockAllocator::MagazineSize + BatchSize);
+    }
+
+    // Stamps the whole block so a block handed to two threads at once is caught when either checks it
+    void Stamp(void* block, uint32_t value)
+    {
+        uint32_t* words = static_cast<uint32_t*>(block);
+        for (std::size_t i = 0; i < BlockSize / sizeof(uint32_t); ++i)
+        {
+            words[i] = value;
+        }
+    }
+
+    bool CheckStamp(const void* block, uint32_t value)
+    {
+        const uint32_t* words = static_cast<const uint32_t*>(block);
+        for (std::size_t i = 0; i < BlockSize / sizeof(uint32_t); ++i)
+        {
+            if (words[i] != value)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct LiveBlock
+    {
+        void* block = nullptr;
+        uint32_t stamp = 0;
+    };
+
+    // Random allocate/free on every thread, then each thread frees the blocks another thread allocated
+    bool RunStress(uint32_t threadCount, uint32_t operations)
+    {
+        ConcurrentBlockAllocator allocator("StressPool", BlockSize, GetCapacity(threadCount));
+        std::vector<std::vector<LiveBlock>> liveBlocks(threadCount);
+        std::atomic<uint32_t> failedAllocations{ 0 };
+        std::atomic<uint32_t> corruptBlocks{ 0 };
+
+        auto checkAndFree = [&](const LiveBlock& live)
+        {
+            if (!CheckStamp(live.block, live.stamp))
+            {
+                corruptBlocks.fetch_add(1, std::memory_order_relaxed);
+            }
+            allocator.Free(live.block);
+        };
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                std::mt19937 random(t + 1);
+                std::vector<LiveBlock>& live = liveBlocks[t];
+                for (uint32_t i = 0; i < operations; ++i)
+                {
+                    const bool allocate = live.empty() || (live.size() < LiveBlocksPerThread && (random() & 1) != 0);
+                    if (allocate)
+                    {
+                        LiveBlock& newBlock = live.emplace_back();
+                        newBlock.block = allocator.Allocate();
+                        newBlock.stamp = (t << 24) | (i & 0xffffff);
+                        if (newBlock.block == nullptr)
+                        {
+                            failedAllocations.fetch_add(1, std::memory_order_relaxed);
+                            live.pop_back();
+                            continue;
+                        }
+                        Stamp(newBlock.block, newBlock.stamp);
+                    }
+                    else
+                    {
+                        const size_t index = random() % live.size();
+                        checkAndFree(live[index]);
+                        live[index] = live.back();
+                        live.pop_back();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        threads.clear();
+
+        // Cross thread frees, the way a job frees a component another job created
+        for (uint32_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (const LiveBlock& live : liveBlocks[(t + 1) % threadCount])
+                {
+                    checkAndFree(live);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        const std::size_t leaked = allocator.GetBlocksAllocated();
+        const bool passed = failedAllocations == 0 && corruptBlocks == 0 && leaked == 0;
+        printf("%-28s threads %2u, failed allocations %u, corrupt blocks %u, leaked %zu %s\n", "Stress", threadCount,
+            failedAllocations.load(), corruptBlocks.load(), leaked, passed ? "" : "FAILED");
+        return passed;
+    }
+
+    // A paged pool grows past its first page without moving anything, Trim hands back exactly the empty pages
+    // and the registry sees the pool from construction to destruction
+    bool CheckPaged()
+    {
+        constexpr std::size_t blockCount = 10000;
+        bool passed = true;
+        std::vector<AllocatorStats> stats;
+        {
+            BlockAllocator allocator("PagedPool", BlockSize, BlockAllocator::Unbounded, 256);
+            std::vector<uint32_t*> blocks;
+            for (std::size_t i = 0; i < blockCount; ++i)
+            {
+                uint32_t* block = static_cast<uint32_t*>(allocator.Allocate());
+                passed &= block != nullptr;
+                *block = static_cast<uint32_t>(i);
+                blocks.push_back(block);
+            }
+            for (std::size_t i = 0; i < blockCount; ++i)
+            {
+                passed &= *blocks[i] == i;
+            }
+
+            // Free all but every 1000th block, pages still holding one of those stay
+            AllocatorStats before;
+            allocator.GetStats(before);
+            for (std::size_t i = 0; i < blockCount; ++i)
+            {
+                if (i % 1000 != 0)
+                {
+                    allocator.Free(blocks[i]);
+                }
+            }
+            AllocatorStats fragmented;
+            allocator.GetStats(fragmented);
+            const std::size_t released = allocator.Trim();
+            AllocatorStats trimmed;
+            allocator.GetStats(trimmed);
+            passed &= before.blocksLive == blockCount && before.blocksReserved >= blockCount;
+            passed &= fragmented.blocksLive == blockCount / 1000 && fragmented.fragmentation > 0.0f;
+            passed &= released > 0 && released == (fragmented.blocksReserved - trimmed.blocksReserved) * BlockSize;
+            passed &= trimmed.pageCount < fragmented.pageCount && trimmed.emptyPageCount == 0;
+            passed &= trimmed.blocksPeak == blockCount;
+
+            AllocatorRegistry::GetStats(stats);
+            passed &= std::count_if(stats.begin(), stats.end(), [](const AllocatorStats& s) { return s.name == "PagedPool"; }) == 1;
+
+            // Trimmed pages come back on demand
+            for (std::size_t i = 0; i < blockCount; ++i)
+            {
+                if (i % 1000 != 0)
+                {
+                    blocks[i] = static_cast<uint32_t*>(allocator.Allocate());
+                    passed &= blocks[i] != nullptr;
+                }
+            }
+            for (uint32_t* block : blocks)
+            {
+                allocator.Free(block);
+            }
+            printf("%s", AllocatorRegistry::Dump().c_str());
+        }
+        AllocatorRegistry::GetStats(stats);
+        passed &= std::none_of(stats.begin(), stats.end(), [](const AllocatorStats& s) { return s.name == "PagedPool"; });
+
+        // A bounded paged pool stops at its capacity like a fixed one
+        BlockAllocator bounded("BoundedPool", BlockSize, 100, 16);
+        std::vector<void*> boundedBlocks;
+        while (void* block = bounded.Allocate())
+        {
+            boundedBlocks.push_back(block);
+        }
+        passed &= boundedBlocks.size() == 100;
+        for (void* block : boundedBlocks)
+        {
+            bounded.Free(block);
+        }
+
+        printf("%-28s %s\n", "Paged growth and trim", passed ? "ok" : "FAILED");
+        return passed;
+    }
+
+    // Allocates and frees batches of blocks on threadCount threads, returns millions of Allocate/Free pairs per second
+    template<class AllocateFunc, class FreeFunc>
+    double MeasureThroughput(uint32_t threadCount, uint32_t batches, AllocateFunc&& allocate, FreeFunc&& free)
+    {
+        const double ms = Measure(1, [&]()
+        {
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&]()
+                {
+                    void* blocks[BatchSize];
+                    for (uint32_t b = 0; b < batches; ++b)
+                    {
+                        for (void*& block : blocks)
+                        {
+                            block = allocate();
+                            static_cast<uint8_t*>(block)[0] = static_cast<uint8_t>(b);
+                        }
+                        for (void* block : blocks)
+                        {
+                            free(block);
+                        }
+                    }
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+        const double pairs = static_cast<double>(threadCount) * batches * BatchSize;
+        return (ms > 0.0) ? pairs / (ms * 1000.0) : 0.0;
+    }
+}
+
+// Args: [stress operations per thread] [batches per thread]
+int Benchmarks::RunAllocator(int argc, char* argv[])
+{
+    const uint32_t operations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 200000;
+    const uint32_t batches = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 50000;
+    const uint32_t maxThreads = GetMaxThreads();
+
+    // Oversubscribing the cores is fine for the stress test, it only makes the interleavings more varied
+    bool passed = true;
+    for (uint32_t threadCount = 1; threadCount <= std::max(8u, maxThreads); threadCount *= 2)
+    {
+        passed &= RunStress(threadCount, operations);
+    }
+
+    passed &= CheckPaged();
+
+    // Single thread, the paged pool pays for its page lookup on Free
+    {
+        BlockAllocator fixedAllocator("FixedPool", BlockSize, BatchSize);
+        BlockAllocator pagedAllocator("PagedPool", BlockSize, BlockAllocator::Unbounded, BatchSize);
+        const double fixedRate = MeasureThroughput(1, batches,
+            [&]() { return fixedAllocator.Allocate(); },
+            [&](void* block) { fixedAllocator.Free(block); });
+        const double pagedRate = MeasureThroughput(1, batches,
+            [&]() { return pagedAllocator.Allocate(); },
+            [&](void* block) { pagedAllocator.Free(block); });
+        printf("%-28s %14s %14s\n", "Mops/s (alloc + free)", "Block fixed", "Block paged");
+        printf("%-28s %14.1f %14.1f\n", "1 thread", fixedRate, pagedRate);
+    }
+
+    // BlockAllocator isn't thread safe, it is measured behind the mutex a shared pool would need today.
+    // Debug builds LOG every BlockAllocator call, compare Release numbers
+    printf("%-28s %14s %14s %14s\n", "Mops/s (alloc + free)", "malloc", "Block + mutex", "Concurrent");
+    for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+    {
+        const std::size_t capacity = GetCapacity(threadCount);
+
+        const double mallocRate = MeasureThroughput(threadCount, batches,
+            []() { return std::malloc(BlockSize); },
+            [](void* block) { std::free(block); });
+
+        BlockAllocator blockAllocator("LockedPool", BlockSize, capacity);
+        std::mutex mutex;
+        const double lockedRate = MeasureThroughput(threadCount, batches,
+            [&]() { std::lock_guard<std::mutex> lock(mutex); return blockAllocator.Allocate(); },
+            [&](void* block) { std::lock_guard<std::mutex> lock(mutex); blockAllocator.Free(block); });
+
+        ConcurrentBlockAllocator concurrentAllocator("ConcurrentPool", BlockSize, capacity);
+        const double concurrentRate = MeasureThroughput(threadCount, batches,
+            [&]() { return concurrentAllocator.Allocate(); },
+            [&](void* block) { concurrentAllocator.Free(block); });
+
+        char label[32];
+        snprintf(label, sizeof(label), "%u thread%s", threadCount, (threadCount > 1) ? "s" : "");
+        printf("%-28s %14.1f %14.1f %14.1f\n", label, mallocRate, lockedRate, concurrentRate);
+    }
+    return passed ? 0 : -1;
+}
\ No newline at end of file
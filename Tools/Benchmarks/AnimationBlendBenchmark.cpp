@@ -0,0 +1,104 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+namespace
+{
+    enum Clip { Idle, Walk, Attack };
+
+    // The parasite bones are unnamed, so mask the subtree closest to half the skeleton, which is the upper body
+    int FindUpperBodyBone(const Skeleton& skeleton)
+    {
+        std::vector<int> subtreeSizes(skeleton.bones.size(), 1);
+        for (size_t i = skeleton.sortedBoneIndices.size(); i-- > 0;)
+        {
+            const int parentIndex = skeleton.sortedParentIndices[i];
+            if (parentIndex >= 0)
+            {
+                subtreeSizes[parentIndex] += subtreeSizes[skeleton.sortedBoneIndices[i]];
+            }
+        }
+
+        const int half = static_cast<int>(skeleton.bones.size()) / 2;
+        int bestBone = 0;
+        for (size_t i = 0; i < subtreeSizes.size(); ++i)
+        {
+            if (abs(subtreeSizes[i] - half) < abs(subtreeSizes[bestBone] - half))
+            {
+                bestBone = static_cast<int>(i);
+            }
+        }
+        return bestBone;
+    }
+
+    void SetupLayers(Animator& animator, uint32_t layerCount, const BoneMask& upperBodyMask)
+    {
+        animator.PlayAnimation(Walk, true);
+        if (layerCount >= 2)
+        {
+            animator.SetLayer(1, Attack, true, 1.0f, AnimationBlendMode::Override, &upperBodyMask);
+        }
+        if (layerCount >= 4)
+        {
+            // A fade that never finishes keeps the outgoing idle pose in the blend
+            animator.PlayAnimation(Idle, true);
+            animator.CrossFade(Walk, true, 1.0e6f);
+            animator.SetLayer(2, Idle, true, 0.5f, AnimationBlendMode::Additive);
+            // Same clip and playhead as the base layer, served from the pose cache
+            animator.SetLayer(3, Walk, true, 0.5f, AnimationBlendMode::Override, &upperBodyMask);
+        }
+    }
+}
+
+// Args: [iterations]
+int Benchmarks::RunAnimationBlend(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 10000;
+
+    ModelManager::StaticInitialize(L"../../Assets/Models");
+    ModelManager* modelManager = ModelManager::Get();
+
+    const ModelId modelId = modelManager->LoadModel("parasite/parasite.model");
+    modelManager->AddAnimation(modelId, "../../Assets/Models/parasite/ZIdle.animset");
+    modelManager->AddAnimation(modelId, "../../Assets/Models/parasite/ZWalk.animset");
+    modelManager->AddAnimation(modelId, "../../Assets/Models/parasite/ZAttack.animset");
+    const Model* model = modelManager->GetModel(modelId);
+    if (model->skeleton == nullptr || model->animationClips.size() <= Attack)
+    {
+        printf("parasite is missing its skeleton or ZIdle/ZWalk/ZAttack clips, re-run the ModelImporter\n");
+        ModelManager::StaticTerminate();
+        return -1;
+    }
+
+    BoneMask upperBodyMask;
+    upperBodyMask.Initialize(*model->skeleton);
+    upperBodyMask.SetBoneWeight(*model->skeleton, FindUpperBodyBone(*model->skeleton), 1.0f);
+
+    printf("%-8s %16s %18s\n", "Layers", "Update (us)", "Skinning (us)");
+    const uint32_t layerCounts[] = { 1, 2, 4 };
+    for (uint32_t layerCount : layerCounts)
+    {
+        Animator animator;
+        animator.Initialize(modelId);
+        SetupLayers(animator, layerCount, upperBodyMask);
+
+        AnimationUtil::BoneTransforms modelTransforms;
+        AnimationUtil::BoneTransforms skinningTransforms;
+        const double updateMs = Measure(iterations, [&]()
+        {
+            animator.Update(1.0f / 60.0f);
+        });
+        const double skinningMs = Measure(iterations, [&]()
+        {
+            animator.Update(1.0f / 60.0f);
+            AnimationUtil::ComputeSkinningTransforms(modelId, modelTransforms, skinningTransforms, &animator);
+        });
+
+        const double toUs = 1000.0;
+        printf("%-8u %16.3f %18.3f\n", layerCount, updateMs * toUs, skinningMs * toUs);
+    }
+
+    ModelManager::StaticTerminate();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+namespace
+{
+    const uint32_t sCrowdSizes[] = { 1, 10, 100, 250, 500, 1000 };
+
+    constexpr const char* sCharacterJson =
+        "{ \"FileName\": \"zombie/zombie.model\", \"Animations\": [ \"../../Assets/Models/zombie/Thriller.animset\" ] }";
+
+    class Crowd
+    {
+    public:
+        void Initialize(uint32_t characterCount, bool deterministic)
+        {
+            AnimationService* animationService = mWorld.AddService<AnimationService>();
+            animationService->SetDeterministic(deterministic);
+            mWorld.Initialize(characterCount);
+
+            rapidjson::Document document;
+            document.Parse(sCharacterJson);
+            for (uint32_t i = 0; i < characterCount; ++i)
+            {
+                GameObject* gameObject = mWorld.CreateGameObject("Character" + std::to_string(i));
+                gameObject->AddComponent<ModelComponent>()->Deserialize(document);
+                AnimatorComponent* animatorComponent = gameObject->AddComponent<AnimatorComponent>();
+                gameObject->Initialize();
+                animatorComponent->Play(0, true);
+                mAnimators.push_back(animatorComponent);
+            }
+        }
+
+        void Terminate()
+        {
+            mWorld.Terminate();
+            mAnimators.clear();
+        }
+
+        void Update(float deltaTime)
+        {
+            mWorld.Update(deltaTime);
+        }
+
+        const std::vector<AnimatorComponent*>& GetAnimators() const
+        {
+            return mAnimators;
+        }
+
+    private:
+        GameWorld mWorld;
+        std::vector<AnimatorComponent*> mAnimators;
+    };
+
+    float GetMaxDifference(const Crowd& a, const Crowd& b)
+    {
+        float difference = 0.0f;
+        for (size_t i = 0; i < a.GetAnimators().size(); ++i)
+        {
+            const AnimationUtil::BoneTransforms& paletteA = a.GetAnimators()[i]->GetSkinningTransforms();
+            const AnimationUtil::BoneTransforms& paletteB = b.GetAnimators()[i]->GetSkinningTransforms();
+            for (size_t m = 0; m < paletteA.size(); ++m)
+            {
+                for (size_t e = 0; e < paletteA[m].v.size(); ++e)
+                {
+                    difference = Math::Max(difference, Math::Abs(paletteA[m].v[e] - paletteB[m].v[e]));
+                }
+            }
+        }
+        return difference;
+    }
+}
+
+// Args: [frames]
+int Benchmarks::RunAnimationCrowd(int argc, char* argv[])
+{
+    const uint32_t frames = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 300;
+    const float deltaTime = 1.0f / 60.0f;
+
+    ModelManager::StaticInitialize(L"../../Assets/Models");
+    Core::JobSystem::StaticInitialize();
+
+    printf("%u worker threads\n", Core::JobSystem::Get()->GetWorkerCount());
+    printf("%10s %16s %16s %10s %14s\n", "Characters", "Serial (ms)", "Parallel (ms)", "Speedup", "Max difference");
+
+    int result = 0;
+    for (uint32_t characterCount : sCrowdSizes)
+    {
+        Crowd serialCrowd;
+        Crowd parallelCrowd;
+        serialCrowd.Initialize(characterCount, true);
+        parallelCrowd.Initialize(characterCount, false);
+
+        const double serialMs = Measure(frames, [&]() { serialCrowd.Update(deltaTime); });
+        const double parallelMs = Measure(frames, [&]() { parallelCrowd.Update(deltaTime); });
+
+        // Both crowds advanced the same number of frames, so the palettes must agree
+        const float difference = GetMaxDifference(serialCrowd, parallelCrowd);
+        if (difference > 0.0f)
+        {
+            result = -1;
+        }
+
+        printf("%10u %16.3f %16.3f %9.1fx %14f\n", characterCount, serialMs, parallelMs,
+            (parallelMs > 0.0) ? serialMs / parallelMs : 0.0, difference);
+
+        parallelCrowd.Terminate();
+        serialCrowd.Terminate();
+    }
+
+    Core::JobSystem::StaticTerminate();
+    ModelManager::StaticTerminate();
+    return result;
+}
\ No newline at end of file
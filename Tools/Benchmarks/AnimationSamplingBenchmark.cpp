@@ -0,0 +1,180 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+namespace
+{
+    const char* sAnimationFiles[] =
+    {
+        "../../Assets/Models/Guard_01/Guard_01.model",
+        "../../Assets/Models/Guard_01/Idle_Guard_01.model",
+        "../../Assets/Models/Guard_01/Kill_Guard_01.model",
+        "../../Assets/Models/Guard_01/LookBack_Guard_01.model",
+        "../../Assets/Models/Guard_01/Looking_Guard_01.model",
+        "../../Assets/Models/Guard_01/Shrugging_Guard_01.model",
+        "../../Assets/Models/Knight/Knight.model",
+        "../../Assets/Models/Knight/DrunkRun_Knight.model",
+        "../../Assets/Models/Knight/GoofyRun_Knight.model",
+        "../../Assets/Models/Knight/GoofySprint_Knight.model",
+        "../../Assets/Models/Knight/Punch_Knight.model",
+        "../../Assets/Models/Knight/SeriousSprint_Knight.model",
+        "../../Assets/Models/Knight/WeirdRun_Knight.model",
+    };
+
+    // The original sampling path, scans every track from the second key on each call
+    template<class T, class Interpolate>
+    T SampleLinear(const Keyframes<T>& keys, float time, const T& fallback, Interpolate interpolate)
+    {
+        if (keys.empty())
+        {
+            return fallback;
+        }
+        for (uint32_t i = 1; i < keys.size(); ++i)
+        {
+            if (time < keys[i].time)
+            {
+                float t = Math::Clamp((time - keys[i - 1].time) / (keys[i].time - keys[i - 1].time), 0.0f, 1.0f);
+                return interpolate(keys[i - 1].key, keys[i].key, t);
+            }
+        }
+        return keys.back().key;
+    }
+
+    Transform GetTransformLinear(const Animation& animation, float time)
+    {
+        auto lerp = [](const Math::Vector3& a, const Math::Vector3& b, float t) { return Math::Lerp(a, b, t); };
+        auto slerp = [](const Math::Quaternion& a, const Math::Quaternion& b, float t) { return Math::Quaternion::Slerp(a, b, t); };
+
+        Transform transform;
+        transform.position = SampleLinear(animation.GetPositionKeys(), time, Math::Vector3::Zero, lerp);
+        transform.rotation = SampleLinear(animation.GetRotationKeys(), time, Math::Quaternion::Identity, slerp);
+        transform.scale = SampleLinear(animation.GetScaleKeys(), time, Math::Vector3::One, lerp);
+        return transform;
+    }
+
+    // Plays the clip forward at a fixed frame rate, looping, and calls sample for every frame
+    template<class Func>
+    void Replay(const AnimationClip& clip, uint32_t frameCount, Func&& sample)
+    {
+        const float tickStep = clip.ticksPerSecond / 60.0f;
+        float tick = 0.0f;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            sample(tick);
+            tick += tickStep;
+            while (tick > clip.tickDuration)
+            {
+                tick -= clip.tickDuration;
+            }
+        }
+    }
+
+    float GetMaxError(const Transform& a, const Transform& b)
+    {
+        float error = Math::Distance(a.position, b.position);
+        error = Math::Max(error, Math::Distance(a.scale, b.scale));
+        error = Math::Max(error, Math::Abs(a.rotation.x - b.rotation.x));
+        error = Math::Max(error, Math::Abs(a.rotation.y - b.rotation.y));
+        error = Math::Max(error, Math::Abs(a.rotation.z - b.rotation.z));
+        error = Math::Max(error, Math::Abs(a.rotation.w - b.rotation.w));
+        return error;
+    }
+}
+
+// Args: [frames per clip]
+int Benchmarks::RunAnimationSampling(int argc, char* argv[])
+{
+    const uint32_t frameCount = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 600;
+
+    printf("%-28s %6s %8s %12s %12s %12s %10s\n", "Clip", "Bones", "Keys", "Linear (us)", "Search (us)", "Cursor (us)", "Max error");
+
+    double totalLinear = 0.0;
+    double totalCursor = 0.0;
+    for (const char* fileName : sAnimationFiles)
+    {
+        // The text animset always holds full float keys, which the linear reference path needs
+        Model model;
+        ModelIO::LoadAnimation(fileName, model);
+        if (model.animationClips.empty())
+        {
+            printf("%-28s no clips, re-run the ModelImporter\n", std::filesystem::path(fileName).filename().u8string().c_str());
+            continue;
+        }
+
+        for (const AnimationClip& clip : model.animationClips)
+        {
+            size_t keyCount = 0;
+            for (const auto& animation : clip.boneAnimations)
+            {
+                if (animation != nullptr)
+                {
+                    keyCount += animation->GetPositionKeys().size() + animation->GetRotationKeys().size() + animation->GetScaleKeys().size();
+                }
+            }
+
+            std::vector<Transform> linearPose(clip.boneAnimations.size());
+            std::vector<Transform> cursorPose;
+            AnimationCursors cursors;
+
+            const double linearMs = Measure(1, [&]()
+            {
+                Replay(clip, frameCount, [&](float tick)
+                {
+                    for (size_t i = 0; i < clip.boneAnimations.size(); ++i)
+                    {
+                        if (clip.boneAnimations[i] != nullptr)
+                        {
+                            linearPose[i] = GetTransformLinear(*clip.boneAnimations[i], tick);
+                        }
+                    }
+                });
+            });
+            const double searchMs = Measure(1, [&]()
+            {
+                Replay(clip, frameCount, [&](float tick)
+                {
+                    for (size_t i = 0; i < clip.boneAnimations.size(); ++i)
+                    {
+                        if (clip.boneAnimations[i] != nullptr)
+                        {
+                            linearPose[i] = clip.boneAnimations[i]->GetTransform(tick);
+                        }
+                    }
+                });
+            });
+            const double cursorMs = Measure(1, [&]()
+            {
+                Replay(clip, frameCount, [&](float tick)
+                {
+                    clip.SampleBoneTransforms(tick, cursors, cursorPose);
+                });
+            });
+
+            // Replay once more comparing every frame against the linear path to make sure the cursors never drift
+            float maxError = 0.0f;
+            cursors.clear();
+            Replay(clip, frameCount, [&](float tick)
+            {
+                clip.SampleBoneTransforms(tick, cursors, cursorPose);
+                for (size_t i = 0; i < clip.boneAnimations.size(); ++i)
+                {
+                    if (clip.boneAnimations[i] != nullptr)
+                    {
+                        maxError = Math::Max(maxError, GetMaxError(GetTransformLinear(*clip.boneAnimations[i], tick), cursorPose[i]));
+                    }
+                }
+            });
+
+            totalLinear += linearMs;
+            totalCursor += cursorMs;
+            const double toFrameUs = 1000.0 / static_cast<double>(frameCount);
+            printf("%-28s %6zu %8zu %12.3f %12.3f %12.3f %10.6f\n", clip.name.c_str(), clip.boneAnimations.size(), keyCount,
+                linearMs * toFrameUs, searchMs * toFrameUs, cursorMs * toFrameUs, maxError);
+        }
+    }
+
+    printf("Linear total %.3f ms, cursor total %.3f ms (%.1fx)\n", totalLinear, totalCursor,
+        (totalCursor > 0.0) ? totalLinear / totalCursor : 0.0);
+    return 0;
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <IExeEngine/Inc/IExeEngine.h>
+
+#include <cstdio>
+
+namespace Benchmarks
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    inline double ToMilliseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    // Runs func iterations times and returns the average time of a single run in milliseconds
+    template<class Func>
+    double Measure(uint32_t iterations, Func&& func)
+    {
+        const auto start = Clock::now();
+        for (uint32_t i = 0; i < iterations; ++i)
+        {
+            func();
+        }
+        return ToMilliseconds(Clock::now() - start) / static_cast<double>(iterations);
+    }
+
+    // Loads the skeleton and animation clips of an imported asset, preferring the binary files
+    inline void LoadAnimatedAsset(const std::filesystem::path& filePath, IExeEngine::Graphics::Model& model)
+    {
+        using namespace IExeEngine::Graphics;
+        if (!ModelIO::LoadSkeletonBinary(filePath, model))
+        {
+            ModelIO::LoadSkeleton(filePath, model);
+        }
+        if (!ModelIO::LoadAnimationBinary(filePath, model))
+        {
+            ModelIO::LoadAnimation(filePath, model);
+        }
+    }
+
+    enum class BenchmarkComponentId
+    {
+        Zombie = static_cast<int>(IExeEngine::ComponentId::Count)
+    };
+
+    // Stands in for the controller, model and sound bank data of zombie_obj.json, which need a device to load.
+    // onInitialize lets a suite look at each zombie once its object is set up
+    class ZombieComponent final : public IExeEngine::Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Zombie);
+
+        void Initialize() override
+        {
+            if (onInitialize)
+            {
+                onInitialize(*this);
+            }
+        }
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            if (value.HasMember("MoveSpeed"))
+            {
+                moveSpeed = value["MoveSpeed"].GetFloat();
+            }
+            if (value.HasMember("AttackRange"))
+            {
+                attackRange = value["AttackRange"].GetFloat();
+            }
+            if (value.HasMember("Animations"))
+            {
+                animations.clear();
+                for (auto& animation : value["Animations"].GetArray())
+                {
+                    animations.push_back(animation.GetString());
+                }
+            }
+            if (value.HasMember("SoundEffects"))
+            {
+                for (auto& sound : value["SoundEffects"].GetObj())
+                {
+                    looping += sound.value["Looping"].GetBool() ? 1 : 0;
+                }
+            }
+        }
+
+        static inline std::function<void(const ZombieComponent&)> onInitialize;
+
+        float moveSpeed = 0.0f;
+        float attackRange = 0.0f;
+        std::vector<std::string> animations;
+        uint32_t looping = 0;
+    };
+
+    // Lets templates name ZombieComponent, it isn't registered with the TypeRegistry
+    inline void SetZombieFactory()
+    {
+        using namespace IExeEngine;
+        GameObjectFactory::SetCustomMake([](const std::string& componentName, GameObject& gameObject) -> Component*
+        {
+            return (componentName == "ZombieComponent") ? gameObject.AddComponent<ZombieComponent>() : nullptr;
+        });
+        GameObjectFactory::SetCustomGet([](const std::string& componentName, GameObject& gameObject) -> Component*
+        {
+            return (componentName == "ZombieComponent") ? gameObject.GetComponent<ZombieComponent>() : nullptr;
+        });
+    }
+
+    inline void ClearZombieFactory()
+    {
+        IExeEngine::GameObjectFactory::SetCustomMake(nullptr);
+        IExeEngine::GameObjectFactory::SetCustomGet(nullptr);
+    }
+
+    // zombie_obj.json with a head child, formatted with the move speed and the head template path
+    inline const char* ZombieTemplate = R"({
+  "Components": {
+    "TransformComponent": {
+      "Position": [ 0.0, 0.0, 0.0 ],
+      "Rotation": [ 0.0, 0.0, 0.0, 1.0 ],
+      "Scale": [ 1.0, 1.0, 1.0 ]
+    },
+    "ZombieComponent": {
+      "MoveSpeed": %.1f,
+      "AttackRange": 2.5,
+      "Animations": [
+        "../../Assets/Models/parasite/ZIdle.animset",
+        "../../Assets/Models/parasite/ZWalk.animset",
+        "../../Assets/Models/parasite/ZAttack.animset"
+      ],
+      "SoundEffects": {
+        "ZombieAttack_1": { "FileName": "ZAttack1.wav", "Looping": false },
+        "ZombieAttack_2": { "FileName": "ZAttack2.wav", "Looping": false },
+        "ZombieScream": { "FileName": "ZScream.wav", "Looping": false },
+        "ZombieIdle": { "FileName": "ZIdle.wav", "Looping": true }
+      }
+    }
+  },
+  "Children": {
+    "Head": {
+      "Template": "%s",
+      "Components": {
+        "TransformComponent": { "Position": [ 0.0, 1.8, 0.0 ] }
+      }
+    }
+  }
+})";
+
+    inline const char* HeadTemplate = R"({
+  "Components": {
+    "TransformComponent": {
+      "Position": [ 0.0, 0.0, 0.0 ],
+      "Rotation": [ 0.0, 0.0, 0.0, 1.0 ],
+      "Scale": [ 0.5, 0.5, 0.5 ]
+    }
+  }
+})";
+
+    inline void WriteTextFile(const std::filesystem::path& filePath, const std::string& text)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, filePath.u8string().c_str(), "wb");
+        if (file != nullptr)
+        {
+            fwrite(text.data(), 1, text.size(), file);
+            fclose(file);
+        }
+    }
+
+    inline void WriteZombieTemplate(const std::filesystem::path& filePath, const std::filesystem::path& headPath, float moveSpeed)
+    {
+        char text[4096];
+        snprintf(text, sizeof(text), ZombieTemplate, moveSpeed, headPath.generic_u8string().c_str());
+        WriteTextFile(filePath, text);
+    }
+
+    // Each suite takes the remaining command line arguments and returns 0 on success
+    int RunModelIO(int argc, char* argv[]);
+    int RunAnimationSampling(int argc, char* argv[]);
+    int RunSkeleton(int argc, char* argv[]);
+    int RunAnimationCrowd(int argc, char* argv[]);
+    int RunAnimationBlend(int argc, char* argv[]);
+    int RunMath(int argc, char* argv[]);
+    int RunAllocator(int argc, char* argv[]);
+    int RunJobSystem(int argc, char* argv[]);
+    int RunFrameAllocator(int argc, char* argv[]);
+    int RunProfiler(int argc, char* argv[]);
+    int RunLogger(int argc, char* argv[]);
+    int RunEvents(int argc, char* argv[]);
+    int RunMemory(int argc, char* argv[]);
+    int RunWorld(int argc, char* argv[]);
+    int RunHierarchy(int argc, char* argv[]);
+    int RunSpawn(int argc, char* argv[]);
+    int RunPrefab(int argc, char* argv[]);
+    int RunRegistry(int argc, char* argv[]);
+    int RunLevel(int argc, char* argv[]);
+}
@@ -0,0 +1,208 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    constexpr uint32_t BroadcastCount = 100000;
+
+    enum class BenchmarkEventType
+    {
+        Ping = 1000,
+        Value
+    };
+
+    class PingEvent : public Event
+    {
+    public:
+        SET_EVENT_TYPE_ID(BenchmarkEventType::Ping)
+    };
+
+    class ValueEvent : public Event
+    {
+    public:
+        SET_EVENT_TYPE_ID(BenchmarkEventType::Value)
+
+        ValueEvent() = default;
+        ValueEvent(uint32_t source, uint32_t value) : source(source), value(value) {}
+
+        uint32_t source = 0;
+        uint32_t value = 0;
+    };
+
+    // The dispatch EventManager had before, two hash lookups and a node based map walk per broadcast
+    class LegacyEventManager
+    {
+    public:
+        EventListenerId AddListener(EventTypeId eventId, const EventCallback& cb)
+        {
+            ++mNextListenerId;
+            mEventListeners[eventId][mNextListenerId] = cb;
+            return mNextListenerId;
+        }
+
+        void Broadcast(const Event& e)
+        {
+            auto eventGroupListeners = mEventListeners.find(e.GetTypeId());
+            if (eventGroupListeners != mEventListeners.end())
+            {
+                for (auto& cb : eventGroupListeners->second)
+                {
+                    cb.second(e);
+                }
+            }
+        }
+
+    private:
+        std::unordered_map<EventTypeId, std::unordered_map<EventListenerId, EventCallback>> mEventListeners;
+        EventListenerId mNextListenerId = 0;
+    };
+
+    uint32_t sCalls = 0;
+
+    // A listener that removes itself and another that removes a later one are both safe, the removed one
+    // is not called, and a listener added mid broadcast first hears the next one
+    bool CheckChangesDuringDispatch()
+    {
+        EventManager* em = EventManager::Get();
+        const EventTypeId eventId = PingEvent::StaticGetTypeId();
+        uint32_t first = 0;
+        uint32_t victim = 0;
+        uint32_t added = 0;
+        EventListenerId firstId = 0;
+        EventListenerId victimId = 0;
+        EventListenerId addedId = 0;
+        firstId = em->AddListener(eventId, [&](const Event&)
+        {
+            ++first;
+            em->RemoveListener(eventId, firstId);
+            em->RemoveListener(eventId, victimId);
+            addedId = em->AddListener(eventId, [&](const Event&) { ++added; });
+        });
+        victimId = em->AddListener(eventId, [&](const Event&) { ++victim; });
+
+        EventManager::Broadcast(PingEvent());
+        const bool firstPassed = first == 1 && victim == 0 && added == 0;
+        EventManager::Broadcast(PingEvent());
+        const bool secondPassed = first == 1 && victim == 0 && added == 1;
+        em->RemoveListener(eventId, addedId);
+        return firstPassed && secondPassed;
+    }
+
+    // Posts from several threads all arrive, in order per thread, and posts made by a callback wait a round
+    bool CheckQueued()
+    {
+        constexpr uint32_t threadCount = 4;
+        constexpr uint32_t postCount = 10000;
+
+        EventManager* em = EventManager::Get();
+        uint32_t next[threadCount] = {};
+        bool ordered = true;
+        uint32_t received = 0;
+        const EventListenerId listenerId = em->AddListener(ValueEvent::StaticGetTypeId(), [&](const Event& e)
+        {
+            const ValueEvent& valueEvent = static_cast<const ValueEvent&>(e);
+            if (valueEvent.source == threadCount)
+            {
+                EventManager::Post(ValueEvent(threadCount + 1, 0));
+            }
+            else if (valueEvent.source < threadCount)
+            {
+                ordered = ordered && valueEvent.value == next[valueEvent.source]++;
+            }
+            ++received;
+        });
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([t]()
+            {
+                for (uint32_t i = 0; i < postCount; ++i)
+                {
+                    EventManager::Post(ValueEvent(t, i));
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        EventManager::Post(ValueEvent(threadCount, 0));
+
+        em->DispatchQueued();
+        const bool firstRound = received == threadCount * postCount + 1;
+        em->DispatchQueued();
+        const bool secondRound = received == threadCount * postCount + 2;
+        em->RemoveListener(ValueEvent::StaticGetTypeId(), listenerId);
+        return ordered && firstRound && secondRound;
+    }
+}
+
+// Args: [iterations]
+int Benchmarks::RunEvents(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 5;
+
+    EventManager::StaticInitialize();
+    const bool changes = CheckChangesDuringDispatch();
+    const bool queued = CheckQueued();
+
+    printf("%-32s %s\n", "Add/remove during dispatch", changes ? "ok" : "FAILED");
+    printf("%-32s %s\n", "Queued posts from 4 threads", queued ? "ok" : "FAILED");
+    printf("%-10s %16s %16s %16s\n", "Listeners", "Legacy (M/s)", "Broadcast (M/s)", "Queued (M/s)");
+
+    EventManager* em = EventManager::Get();
+    for (uint32_t listenerCount : { 1u, 10u, 100u })
+    {
+        // Listeners for other event types too, as a game would have
+        LegacyEventManager legacy;
+        for (uint32_t i = 0; i < listenerCount; ++i)
+        {
+            for (EventTypeId eventId = 0; eventId < 8; ++eventId)
+            {
+                legacy.AddListener(eventId, [](const Event&) { ++sCalls; });
+                em->AddListener(eventId, [](const Event&) { ++sCalls; });
+            }
+            legacy.AddListener(PingEvent::StaticGetTypeId(), [](const Event&) { ++sCalls; });
+            em->AddListener(PingEvent::StaticGetTypeId(), [](const Event&) { ++sCalls; });
+        }
+
+        // Fewer events at higher listener counts keep every run at a similar number of calls. Both broadcasts
+        // go through a std::function so neither can see the event's type and skip the virtual GetTypeId
+        const uint32_t count = BroadcastCount / listenerCount;
+        const PingEvent event;
+        auto measureBroadcast = [&](const std::function<void(const Event&)>& broadcast)
+        {
+            return Measure(iterations, [&]()
+            {
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    broadcast(event);
+                }
+            });
+        };
+        const double legacyMs = measureBroadcast([&legacy](const Event& e) { legacy.Broadcast(e); });
+        const double broadcastMs = measureBroadcast([](const Event& e) { EventManager::Broadcast(e); });
+        const double queuedMs = Measure(iterations, [&]()
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                EventManager::Post(event);
+            }
+            em->DispatchQueued();
+        });
+
+        em->Terminate();
+        em->Initialize();
+
+        printf("%-10u %16.2f %16.2f %16.2f\n", listenerCount,
+            count / (legacyMs * 1.0e3), count / (broadcastMs * 1.0e3), count / (queuedMs * 1.0e3));
+    }
+
+    EventManager::StaticTerminate();
+    return (changes && queued) ? 0 : -1;
+}
\ No newline at end of file
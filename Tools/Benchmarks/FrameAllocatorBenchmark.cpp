@@ -0,0 +1,197 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+using namespace IExeEngine::Math;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    // Same shape as StandardEffect::Render, one padded bone palette per skinned render group
+    constexpr size_t MaxBoneCount = 256;
+    constexpr size_t BoneCount = 67;
+
+    bool CheckAlignment()
+    {
+        FrameAllocator allocator;
+        allocator.Initialize(64 * 1024);
+        bool passed = true;
+        for (std::size_t alignment = 1; alignment <= 256; alignment *= 2)
+        {
+            for (std::size_t size = 1; size < 100; size += 7)
+            {
+                const uintptr_t address = reinterpret_cast<uintptr_t>(allocator.Allocate(size, alignment));
+                passed = passed && (address % alignment) == 0;
+            }
+        }
+        allocator.Terminate();
+        return passed;
+    }
+
+    // Data has to survive the next BeginFrame and be poisoned by the one after
+    bool CheckFrameLifetime()
+    {
+        FrameAllocator allocator;
+        allocator.Initialize(64 * 1024);
+        allocator.SetPoisonOnReset(true);
+        uint32_t* values = allocator.Allocate<uint32_t>(1024);
+        for (uint32_t i = 0; i < 1024; ++i)
+        {
+            values[i] = i;
+        }
+
+        allocator.BeginFrame();
+        allocator.Allocate<uint32_t>(1024);
+        bool passed = true;
+        for (uint32_t i = 0; i < 1024; ++i)
+        {
+            passed = passed && values[i] == i;
+        }
+
+        allocator.BeginFrame();
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+        for (std::size_t i = 0; i < 1024 * sizeof(uint32_t); ++i)
+        {
+            passed = passed && bytes[i] == FrameAllocator::PoisonByte;
+        }
+        allocator.Terminate();
+        return passed;
+    }
+
+    bool CheckOverflow()
+    {
+        FrameAllocator allocator;
+        allocator.Initialize(1024);
+        bool passed = true;
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            uint8_t* block = allocator.Allocate<uint8_t>(512);
+            passed = passed && block != nullptr;
+            std::memset(block, static_cast<int>(i), 512);
+        }
+        passed = passed && allocator.GetOverflowCount() == 6 && allocator.GetBytesUsed() == 8 * 512;
+        allocator.BeginFrame();
+        passed = passed && allocator.GetHighWaterMark() == 8 * 512 && allocator.GetBytesUsed() == 0;
+        allocator.Terminate();
+        return passed;
+    }
+
+    // Threads bump the same buffer, every range has to be handed out once
+    bool CheckThreads()
+    {
+        constexpr uint32_t threadCount = 4;
+        constexpr uint32_t allocationCount = 2000;
+        FrameAllocator allocator;
+        allocator.Initialize(threadCount * allocationCount * 64);
+        std::vector<std::vector<uint32_t*>> blocks(threadCount);
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (uint32_t i = 0; i < allocationCount; ++i)
+                {
+                    uint32_t* block = allocator.Allocate<uint32_t>(1 + (i % 8));
+                    std::fill_n(block, 1 + (i % 8), t);
+                    blocks[t].push_back(block);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        bool passed = allocator.GetOverflowCount() == 0;
+        for (uint32_t t = 0; t < threadCount; ++t)
+        {
+            for (uint32_t i = 0; i < allocationCount; ++i)
+            {
+                passed = passed && std::all_of(blocks[t][i], blocks[t][i] + 1 + (i % 8), [t](uint32_t value) { return value == t; });
+            }
+        }
+        allocator.Terminate();
+        return passed;
+    }
+
+    struct NoScope
+    {
+    };
+
+    template<class Vector, class Scope>
+    void BuildPalettes(const std::vector<Matrix4>& skinningTransforms, uint32_t groupCount, float& checksum)
+    {
+        for (uint32_t g = 0; g < groupCount; ++g)
+        {
+            [[maybe_unused]] Scope scope;
+            Vector boneTransforms(MaxBoneCount);
+            std::copy_n(skinningTransforms.begin(), BoneCount, boneTransforms.begin());
+            for (size_t i = 0; i < BoneCount; ++i)
+            {
+                boneTransforms[i] = Transpose(boneTransforms[i]);
+            }
+            checksum += boneTransforms[g % BoneCount]._14;
+        }
+    }
+}
+
+// Args: [iterations] [render groups]
+int Benchmarks::RunFrameAllocator(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 200;
+    const uint32_t groupCount = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 100;
+
+    const bool alignment = CheckAlignment();
+    const bool lifetime = CheckFrameLifetime();
+    const bool overflow = CheckOverflow();
+    const bool threads = CheckThreads();
+    printf("%-28s %s\n", "Alignment", alignment ? "ok" : "FAILED");
+    printf("%-28s %s\n", "Frame lifetime and poison", lifetime ? "ok" : "FAILED");
+    printf("%-28s %s\n", "Heap overflow", overflow ? "ok" : "FAILED");
+    printf("%-28s %s\n", "Concurrent allocate", threads ? "ok" : "FAILED");
+
+    std::vector<Matrix4> skinningTransforms(BoneCount);
+    for (size_t i = 0; i < BoneCount; ++i)
+    {
+        skinningTransforms[i] = Matrix4::Translation(static_cast<float>(i), 0.0f, 0.0f);
+    }
+
+    FrameAllocator::StaticInitialize();
+    FrameAllocator* frameAllocator = FrameAllocator::Get();
+    float checksum = 0.0f;
+
+    const double heapMs = Measure(iterations, [&]()
+    {
+        BuildPalettes<std::vector<Matrix4>, NoScope>(skinningTransforms, groupCount, checksum);
+    });
+    frameAllocator->SetPoisonOnReset(false);
+    const double frameMs = Measure(iterations, [&]()
+    {
+        frameAllocator->BeginFrame();
+        BuildPalettes<FrameVector<Matrix4>, NoScope>(skinningTransforms, groupCount, checksum);
+    });
+    const double scopeMs = Measure(iterations, [&]()
+    {
+        frameAllocator->BeginFrame();
+        BuildPalettes<FrameVector<Matrix4>, FrameAllocator::Scope>(skinningTransforms, groupCount, checksum);
+    });
+    frameAllocator->SetPoisonOnReset(true);
+    const double poisonMs = Measure(iterations, [&]()
+    {
+        frameAllocator->BeginFrame();
+        BuildPalettes<FrameVector<Matrix4>, FrameAllocator::Scope>(skinningTransforms, groupCount, checksum);
+    });
+
+    printf("%-28s %12s %12s\n", "Bone palettes per frame", "Frame (ms)", "Speedup");
+    printf("%-28s %12.4f %11.1fx\n", "std::vector", heapMs, 1.0);
+    printf("%-28s %12.4f %11.1fx\n", "FrameVector", frameMs, (frameMs > 0.0) ? heapMs / frameMs : 0.0);
+    printf("%-28s %12.4f %11.1fx\n", "FrameVector + Scope", scopeMs, (scopeMs > 0.0) ? heapMs / scopeMs : 0.0);
+    printf("%-28s %12.4f %11.1fx\n", "FrameVector + Scope, poison", poisonMs, (poisonMs > 0.0) ? heapMs / poisonMs : 0.0);
+    printf("Frame bytes %zu of %zu, high water mark %zu, overflows %zu (checksum %.1f)\n",
+        frameAllocator->GetLastFrameBytesUsed(), frameAllocator->GetCapacity(),
+        frameAllocator->GetHighWaterMark(), frameAllocator->GetOverflowCount(), checksum);
+    FrameAllocator::StaticTerminate();
+
+    return (alignment && lifetime && overflow && threads) ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    class Hierarchy
+    {
+    public:
+        // A chain where each object is the parent of the next, or one root with every other object under it
+        void Initialize(uint32_t objectCount, bool deep)
+        {
+            mWorld.SetComponentLayout(ComponentLayout::Pooled);
+            mWorld.Initialize(objectCount);
+
+            const Math::Quaternion turn = Math::Quaternion::CreateFromAxisAngle(Math::Vector3::YAxis, 0.01f);
+            for (uint32_t i = 0; i < objectCount; ++i)
+            {
+                GameObject* gameObject = mWorld.CreateGameObject("Node" + std::to_string(i));
+                TransformComponent* transform = gameObject->AddComponent<TransformComponent>();
+                transform->position = { 1.0f, 0.1f * static_cast<float>(i % 7), 0.0f };
+                transform->rotation = turn;
+                if (i > 0)
+                {
+                    GameObject* parent = deep ? mGameObjects.back() : mGameObjects.front();
+                    parent->AddChild(gameObject);
+                    gameObject->SetParent(parent);
+                }
+                mGameObjects.push_back(gameObject);
+            }
+            // Children are initialized by their parent
+            mGameObjects.front()->Initialize();
+        }
+
+        void Terminate()
+        {
+            mWorld.Terminate();
+            mGameObjects.clear();
+        }
+
+        void Update()
+        {
+            mWorld.Update(0.0f);
+        }
+
+        TransformComponent& GetTransform(std::size_t index)
+        {
+            return *mGameObjects[index]->GetComponent<TransformComponent>();
+        }
+
+        std::size_t GetCount() const
+        {
+            return mGameObjects.size();
+        }
+
+    private:
+        GameWorld mWorld;
+        std::vector<GameObject*> mGameObjects;
+    };
+
+    // The cache agrees with a fresh walk up the chain, up to float rounding from composing in another order
+    float GetMaxError(Hierarchy& hierarchy)
+    {
+        float error = 0.0f;
+        for (std::size_t i = 0; i < hierarchy.GetCount(); ++i)
+        {
+            const TransformComponent& transform = hierarchy.GetTransform(i);
+            const Transform& cached = transform.GetWorldTransform();
+            const Transform walked = transform.ComputeWorldTransform();
+            const float scale = Math::Max(1.0f, Math::Magnitude(walked.position));
+            error = Math::Max(error, Math::Magnitude(cached.position - walked.position) / scale);
+        }
+        return error;
+    }
+}
+
+// Args: [deep objects] [wide objects] [frames]
+int Benchmarks::RunHierarchy(int argc, char* argv[])
+{
+    const uint32_t deepCount = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 1000;
+    const uint32_t wideCount = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 10000;
+    const uint32_t frames = (argc > 2) ? static_cast<uint32_t>(atoi(argv[2])) : 100;
+    const float tolerance = 1.0e-4f;
+
+    printf("%-8s %8s %18s %18s %18s %18s %10s\n", "Shape", "Objects", "Walk each (ms)", "Pass, clean (ms)",
+        "Pass, leaf (ms)", "Pass, root (ms)", "Max error");
+
+    bool passed = true;
+    float checksum = 0.0f;
+    for (const bool deep : { true, false })
+    {
+        const uint32_t objectCount = deep ? deepCount : wideCount;
+        Hierarchy hierarchy;
+        hierarchy.Initialize(objectCount, deep);
+        float error = GetMaxError(hierarchy);
+
+        // What every query cost before the cache, a walk to the root per object
+        const double walkMs = Measure(frames, [&]()
+        {
+            for (std::size_t i = 0; i < hierarchy.GetCount(); ++i)
+            {
+                checksum += hierarchy.GetTransform(i).ComputeWorldTransform().position.x;
+            }
+        });
+
+        const double cleanMs = Measure(frames, [&]() { hierarchy.Update(); });
+
+        TransformComponent& leaf = hierarchy.GetTransform(hierarchy.GetCount() - 1);
+        const double leafMs = Measure(frames, [&]()
+        {
+            leaf.position.y += 0.01f;
+            hierarchy.Update();
+        });
+        error = Math::Max(error, GetMaxError(hierarchy));
+
+        TransformComponent& root = hierarchy.GetTransform(0);
+        const double rootMs = Measure(frames, [&]()
+        {
+            root.position.x += 0.01f;
+            hierarchy.Update();
+        });
+        error = Math::Max(error, GetMaxError(hierarchy));
+        passed &= error <= tolerance;
+
+        printf("%-8s %8u %18.3f %18.3f %18.3f %18.3f %10.2e\n", deep ? "Deep" : "Wide", objectCount, walkMs, cleanMs,
+            leafMs, rootMs, error);
+        hierarchy.Terminate();
+    }
+
+    printf("Checks %s (checksum %.1f)\n", passed ? "ok" : "FAILED", checksum);
+    return passed ? 0 : -1;
+}
\ No newline at end of file
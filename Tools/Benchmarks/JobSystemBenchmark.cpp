@@ -0,0 +1,165 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    constexpr uint32_t WorkCount = 1 << 16;
+    constexpr uint32_t WorkBatchSize = 256;
+    constexpr uint32_t WorkIterations = 256;
+
+    float DoWork(uint32_t index)
+    {
+        float value = static_cast<float>(index);
+        for (uint32_t i = 0; i < WorkIterations; ++i)
+        {
+            value = value * 0.999f + 0.5f;
+        }
+        return value;
+    }
+
+    bool CheckParallelFor(JobSystem& jobSystem)
+    {
+        constexpr uint32_t count = 100000;
+        std::vector<std::atomic<uint32_t>> visits(count);
+        jobSystem.ParallelFor(count, 64, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                visits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        return std::all_of(visits.begin(), visits.end(), [](const std::atomic<uint32_t>& visit) { return visit.load() == 1; });
+    }
+
+    // a -> (b, c) -> d, each stage records the order it ran in
+    bool CheckDependencies(JobSystem& jobSystem)
+    {
+        std::atomic<uint32_t> step{ 0 };
+        uint32_t order[4] = {};
+        JobCounter first;
+        JobCounter second;
+        JobCounter done;
+        jobSystem.Run([&]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); order[0] = step++; }, &first);
+        jobSystem.RunAfter(first, [&]() { order[1] = step++; }, &second);
+        jobSystem.RunAfter(first, [&]() { order[2] = step++; }, &second);
+        jobSystem.RunAfter(second, [&]() { order[3] = step++; }, &done);
+        jobSystem.Wait(done);
+        return order[0] == 0 && order[3] == 3 && (order[1] + order[2]) == 3;
+    }
+
+    // Jobs that start jobs and wait on them, the waiting worker has to keep helping or this deadlocks
+    bool CheckNested(JobSystem& jobSystem)
+    {
+        std::atomic<uint32_t> leaves{ 0 };
+        JobCounter counter;
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            jobSystem.Run([&]()
+            {
+                JobCounter inner;
+                for (uint32_t j = 0; j < 64; ++j)
+                {
+                    jobSystem.Run([&]() { leaves.fetch_add(1, std::memory_order_relaxed); }, &inner);
+                }
+                jobSystem.Wait(inner);
+            }, &counter);
+        }
+        jobSystem.Wait(counter);
+        return leaves == 64 * 64;
+    }
+
+    // Jobs submitted by a thread the JobSystem doesn't know about go through the shared queue
+    bool CheckExternalThread(JobSystem& jobSystem)
+    {
+        std::atomic<uint32_t> ran{ 0 };
+        std::thread thread([&]()
+        {
+            JobCounter counter;
+            for (uint32_t i = 0; i < 1000; ++i)
+            {
+                jobSystem.Run([&]() { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+            jobSystem.Wait(counter);
+        });
+        thread.join();
+        return ran == 1000;
+    }
+
+    bool RunChecks()
+    {
+        JobSystem jobSystem;
+        jobSystem.Initialize(0);
+        const bool parallelFor = CheckParallelFor(jobSystem);
+        const bool dependencies = CheckDependencies(jobSystem);
+        const bool nested = CheckNested(jobSystem);
+        const bool external = CheckExternalThread(jobSystem);
+        jobSystem.Terminate();
+
+        printf("%-28s %s\n", "ParallelFor coverage", parallelFor ? "ok" : "FAILED");
+        printf("%-28s %s\n", "RunAfter order", dependencies ? "ok" : "FAILED");
+        printf("%-28s %s\n", "Nested waits", nested ? "ok" : "FAILED");
+        printf("%-28s %s\n", "External thread submit", external ? "ok" : "FAILED");
+        return parallelFor && dependencies && nested && external;
+    }
+}
+
+// Args: [iterations] [max threads]
+int Benchmarks::RunJobSystem(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 20;
+    const uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    const uint32_t maxThreads = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : hardwareThreads;
+
+    const bool passed = RunChecks();
+
+    // The serial baseline goes through the same function object the batches call
+    std::vector<float> results(WorkCount);
+    const ParallelForFunction work = [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            results[i] = DoWork(i);
+        }
+    };
+    const double serialMs = Measure(iterations, [&]() { work(0, WorkCount); });
+
+    // Threads counts the calling thread, so N threads is N - 1 workers
+    constexpr uint32_t emptyJobCount = 10000;
+    printf("%-10s %16s %16s %14s %10s\n", "Threads", "Run+Wait (ns/job)", "ParallelFor (ns)", "Work (ms)", "Speedup");
+    printf("%-10u %16s %16s %14.3f %9.1fx\n", 1u, "-", "-", serialMs, 1.0);
+    for (uint32_t threadCount = 2; threadCount <= maxThreads; ++threadCount)
+    {
+        JobSystem jobSystem;
+        jobSystem.Initialize(threadCount - 1);
+
+        // Scheduling overhead, empty jobs so only the queueing, stealing and counter traffic is measured
+        const double runMs = Measure(iterations, [&]()
+        {
+            JobCounter counter;
+            for (uint32_t i = 0; i < emptyJobCount; ++i)
+            {
+                jobSystem.Run([]() {}, &counter);
+            }
+            jobSystem.Wait(counter);
+        });
+        const double parallelForMs = Measure(iterations, [&]()
+        {
+            jobSystem.ParallelFor(emptyJobCount, 1, [](uint32_t, uint32_t) {});
+        });
+
+        const double workMs = Measure(iterations, [&]()
+        {
+            jobSystem.ParallelFor(WorkCount, WorkBatchSize, work);
+        });
+        jobSystem.Terminate();
+
+        const double toNs = 1.0e6 / emptyJobCount;
+        printf("%-10u %16.1f %16.1f %14.3f %9.1fx\n", threadCount, runMs * toNs, parallelForMs * toNs, workMs,
+            (workMs > 0.0) ? serialMs / workMs : 0.0);
+    }
+    return passed ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    using Benchmarks::ZombieComponent;
+
+    enum class BenchmarkServiceId
+    {
+        Arena = static_cast<int>(ServiceId::Count)
+    };
+
+    // Every loaded zombie and plant describes itself here on Initialize, so the two load paths can be compared
+    std::vector<std::string> sLoaded;
+
+    void DescribeZombie(const ZombieComponent& zombie)
+    {
+        const GameObject& owner = zombie.GetOwner();
+        const TransformComponent* transform = owner.GetComponent<TransformComponent>();
+        char text[512];
+        int length = snprintf(text, sizeof(text), "%s speed %.9g range %.9g looping %u at %.9g %.9g %.9g scale %.9g",
+            owner.GetName().c_str(), zombie.moveSpeed, zombie.attackRange, zombie.looping, transform->position.x,
+            transform->position.y, transform->position.z, transform->scale.x);
+        for (uint32_t i = 0; i < owner.GetChildCount(); ++i)
+        {
+            const GameObject* child = owner.GetChild(i);
+            const TransformComponent* childTransform = child->GetComponent<TransformComponent>();
+            length += snprintf(text + length, sizeof(text) - length, " child %s at %.9g scale %.9g",
+                child->GetName().c_str(), childTransform->position.y, childTransform->scale.x);
+        }
+        std::string summary = text;
+        for (const std::string& animation : zombie.animations)
+        {
+            summary += " " + animation;
+        }
+        sLoaded.push_back(std::move(summary));
+    }
+
+    class ArenaService final : public Service
+    {
+    public:
+        SET_TYPE_ID(BenchmarkServiceId::Arena);
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            name = value["Name"].GetString();
+            gravity = value["Gravity"][1].GetFloat();
+            waves = value["Waves"].GetUint();
+        }
+
+        std::string name;
+        float gravity = 0.0f;
+        uint32_t waves = 0;
+    };
+
+    const char* PlantTemplate = R"({
+  "Components": {
+    "TransformComponent": {
+      "Position": [ 0.0, 0.0, 0.0 ],
+      "Rotation": [ 0.0, -0.5, 0.0, 1.0 ],
+      "Scale": [ 1.0, 1.0, 1.0 ]
+    },
+    "ZombieComponent": {
+      "MoveSpeed": 0.0,
+      "AttackRange": 6,
+      "Animations": [ "../../Assets/Models/plant/PIdle.animset", "../../Assets/Models/plant/PShoot.animset" ],
+      "SoundEffects": {
+        "PlantShoot": { "FileName": "PShoot.wav", "Looping": false }
+      }
+    }
+  }
+})";
+
+    // Like zombiesVsPlants.json, with count objects alternating between the zombie and plant templates, each moved
+    // by an override. Pooled, and a capacity the objects grow past
+    std::string MakeLevel(uint32_t count, const std::filesystem::path& zombiePath, const std::filesystem::path& plantPath)
+    {
+        std::string level = R"({
+  "Capacity": 100,
+  "ComponentLayout": "Pooled",
+  "Services": {
+    "ArenaService": { "Name": "Backyard", "Gravity": [ 0.0, -9.81, 0.0 ], "Waves": 3 }
+  },
+  "GameObjects": {
+)";
+        char entry[512];
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const bool zombie = (i % 2) == 0;
+            snprintf(entry, sizeof(entry), R"(    "%s_%u": {
+      "Template": "%s",
+      "Components": { "TransformComponent": { "Position": [ %.1f, 0.0, %.1f ] }%s }
+    }%s
+)", zombie ? "Zombie" : "Plant", i, (zombie ? zombiePath : plantPath).generic_u8string().c_str(),
+                static_cast<float>(i % 20) * 2.0f, static_cast<float>(i / 20) * 2.0f,
+                zombie ? R"(, "ZombieComponent": { "MoveSpeed": 2.0 })" : "", (i + 1 < count) ? "," : "");
+            level += entry;
+        }
+        level += "  }\n}";
+        return level;
+    }
+
+    struct LoadResult
+    {
+        double milliseconds = 0.0;
+        uint64_t allocations = 0;
+        std::vector<std::string> loaded;
+        bool passed = true;
+    };
+
+    // Loads the level into a fresh world iterations times, only LoadLevel is timed. Clearing the template cache
+    // before each load makes the json path read every template again, like the first load of a level does
+    LoadResult TimeLoads(const std::filesystem::path& levelFile, uint32_t iterations, bool clearCache)
+    {
+        LoadResult result;
+        for (uint32_t i = 0; i < iterations; ++i)
+        {
+            if (clearCache)
+            {
+                GameObjectFactory::ClearPrefabCache();
+            }
+            sLoaded.clear();
+
+            GameWorld world;
+            const uint64_t allocations = MemoryTracker::GetThreadAllocationCount();
+            const auto start = Benchmarks::Clock::now();
+            world.LoadLevel(levelFile);
+            result.milliseconds += Benchmarks::ToMilliseconds(Benchmarks::Clock::now() - start);
+            result.allocations += MemoryTracker::GetThreadAllocationCount() - allocations;
+
+            const ArenaService* arena = world.GetService<ArenaService>();
+            result.passed &= arena != nullptr && arena->name == "Backyard" && arena->gravity == -9.81f && arena->waves == 3 &&
+                world.GetComponentLayout() == ComponentLayout::Pooled;
+            if (i == 0)
+            {
+                result.loaded = sLoaded;
+            }
+            result.passed &= sLoaded == result.loaded;
+            world.Terminate();
+        }
+        result.milliseconds /= iterations;
+        result.allocations /= iterations;
+        return result;
+    }
+
+    std::uintmax_t GetFileSize(const std::filesystem::path& filePath)
+    {
+        std::error_code error;
+        const std::uintmax_t size = std::filesystem::file_size(filePath, error);
+        return error ? 0 : size;
+    }
+
+    // A cut off or foreign file has to be turned away by the reader instead of read past its end
+    bool CheckRejects(const std::filesystem::path& cookedPath, const std::filesystem::path& badPath)
+    {
+        std::string bytes(GetFileSize(cookedPath), '\0');
+        FILE* file = nullptr;
+        fopen_s(&file, cookedPath.u8string().c_str(), "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        bytes.resize(fread(bytes.data(), 1, bytes.size(), file));
+        fclose(file);
+
+        bool passed = true;
+        Benchmarks::WriteTextFile(badPath, bytes.substr(0, 20));
+        CookedLevel::Reader truncated;
+        passed &= !truncated.Open(badPath);
+
+        bytes[0] = 'X';
+        Benchmarks::WriteTextFile(badPath, bytes);
+        CookedLevel::Reader foreign;
+        passed &= !foreign.Open(badPath);
+        return passed;
+    }
+}
+
+// Args: [objects] [iterations]
+int Benchmarks::RunLevel(int argc, char* argv[])
+{
+    const uint32_t objects = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 500;
+    const uint32_t iterations = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 20;
+    const bool tracking = MemoryTracker::IsEnabled();
+
+    SetZombieFactory();
+    ZombieComponent::onInitialize = DescribeZombie;
+    GameWorld::SetCustomService([](const std::string& serviceName, GameWorld& gameWorld) -> Service*
+    {
+        return (serviceName == "ArenaService") ? gameWorld.AddService<ArenaService>() : nullptr;
+    });
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "IExeLevelBenchmark";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path headPath = directory / "zombie_head.json";
+    const std::filesystem::path zombiePath = directory / "zombie_obj.json";
+    const std::filesystem::path plantPath = directory / "plant_obj.json";
+    const std::filesystem::path levelPath = directory / "zombiesVsPlants.json";
+    std::filesystem::path cookedPath = levelPath;
+    cookedPath.replace_extension(CookedLevel::Extension);
+
+    WriteTextFile(headPath, HeadTemplate);
+    WriteZombieTemplate(zombiePath, headPath, 1.5f);
+    WriteTextFile(plantPath, PlantTemplate);
+    WriteTextFile(levelPath, MakeLevel(objects, zombiePath, plantPath));
+
+    bool passed = CookedLevel::Cook(levelPath, cookedPath);
+    const LoadResult coldResult = TimeLoads(levelPath, iterations, true);
+    const LoadResult warmResult = TimeLoads(levelPath, iterations, false);
+    const LoadResult cookedResult = TimeLoads(cookedPath, iterations, false);
+    passed &= coldResult.passed && warmResult.passed && cookedResult.passed;
+    passed &= coldResult.loaded.size() == objects && cookedResult.loaded == coldResult.loaded && warmResult.loaded == coldResult.loaded;
+    // Overrides from the level and the templates both made it in
+    passed &= !cookedResult.loaded.empty() && cookedResult.loaded[0].find("speed 2 ") != std::string::npos &&
+        cookedResult.loaded[0].find("child Head at 1.79999995 scale 0.5") != std::string::npos;
+    passed &= CheckRejects(cookedPath, directory / "bad.level");
+
+    const std::uintmax_t jsonBytes = GetFileSize(levelPath) + GetFileSize(headPath) + GetFileSize(zombiePath) + GetFileSize(plantPath);
+    printf("Level of %u objects, half with a child, %u iterations\n", objects, iterations);
+    printf("%-24s %12s %16s %12s %14s\n", "", "Load (ms)", "Per object (us)", "File bytes", "Heap allocs");
+    const auto printResult = [&](const char* label, const LoadResult& result, std::uintmax_t bytes)
+    {
+        printf("%-24s %12.3f %16.2f %12ju %14s\n", label, result.milliseconds, result.milliseconds * 1.0e3 / objects, bytes,
+            tracking ? std::to_string(result.allocations).c_str() : "n/a");
+    };
+    printResult("Json, templates parsed", coldResult, jsonBytes);
+    printResult("Json, templates cached", warmResult, jsonBytes);
+    printResult("Cooked", cookedResult, GetFileSize(cookedPath));
+    printf("%-24s %12.1fx\n", "Speedup vs parsed", (cookedResult.milliseconds > 0.0) ? coldResult.milliseconds / cookedResult.milliseconds : 0.0);
+    printf("%-24s %12.1fx\n", "Speedup vs cached", (cookedResult.milliseconds > 0.0) ? warmResult.milliseconds / cookedResult.milliseconds : 0.0);
+    printf("Checks %s\n", passed ? "ok" : "FAILED");
+
+    GameObjectFactory::ClearPrefabCache();
+    ClearZombieFactory();
+    ZombieComponent::onInitialize = nullptr;
+    GameWorld::SetCustomService(nullptr);
+    std::filesystem::remove_all(directory);
+    return passed ? 0 : -1;
+}
\ No newline at end of file
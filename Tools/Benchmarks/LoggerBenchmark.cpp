@@ -0,0 +1,184 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    constexpr uint32_t MessageCount = 20000;
+    constexpr uint32_t ThreadCount = 4;
+
+    std::vector<std::string> ReadLines(const std::filesystem::path& filePath)
+    {
+        std::vector<std::string> lines;
+        FILE* file = nullptr;
+        fopen_s(&file, filePath.u8string().c_str(), "r");
+        if (file == nullptr)
+        {
+            return lines;
+        }
+
+        char line[Logger::MaxLineLength];
+        while (fgets(line, sizeof(line), file) != nullptr)
+        {
+            lines.emplace_back(line);
+        }
+        fclose(file);
+        return lines;
+    }
+
+    // Every thread's messages arrive complete and in order, with their string arguments intact after the
+    // strings themselves are gone. Together the threads log far more than the queue holds
+    void WriteThreaded()
+    {
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < ThreadCount; ++t)
+        {
+            threads.emplace_back([t]()
+            {
+                for (uint32_t i = 0; i < MessageCount / ThreadCount; ++i)
+                {
+                    const std::string tag = "tag" + std::to_string(i);
+                    Logger::Write(LogLevel::Info, LogCategory::General, "thread %u message %u %s", t, i, tag.c_str());
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    bool CheckThreaded(const std::vector<std::string>& lines)
+    {
+        uint32_t next[ThreadCount] = {};
+        uint32_t count = 0;
+        for (const std::string& line : lines)
+        {
+            uint32_t thread = 0;
+            uint32_t message = 0;
+            char tag[32] = {};
+            const size_t start = line.find("}: ");
+            if (start == std::string::npos || sscanf_s(line.c_str() + start + 3, "thread %u message %u %31s", &thread, &message, tag, static_cast<unsigned>(std::size(tag))) != 3)
+            {
+                continue;
+            }
+            if (thread >= ThreadCount || message != next[thread] || ("tag" + std::to_string(message)) != tag)
+            {
+                return false;
+            }
+            ++next[thread];
+            ++count;
+        }
+        return count == MessageCount;
+    }
+
+    // A string too long for the record is cut short and the arguments after it still come through
+    bool CheckTruncation(const std::vector<std::string>& lines)
+    {
+        for (const std::string& line : lines)
+        {
+            if (line.find("long ") != std::string::npos)
+            {
+                return line.size() < LogDetail::PayloadCapacity + 32 && line.find("xxx 12345\n") != std::string::npos;
+            }
+        }
+        return false;
+    }
+
+    bool CheckLevels()
+    {
+        Logger::SetLevel(LogCategory::Core, LogLevel::Warning);
+        const bool passed = !Logger::IsEnabled(LogLevel::Info, LogCategory::Core) && Logger::IsEnabled(LogLevel::Error, LogCategory::Core) &&
+            Logger::IsEnabled(LogLevel::Info, LogCategory::Graphics) && !Logger::IsEnabled(LogLevel::Verbose, LogCategory::Graphics);
+        Logger::SetLevel(LogCategory::Core, LogLevel::Info);
+        return passed;
+    }
+}
+
+// Args: [log file] [iterations]
+int Benchmarks::RunLogger(int argc, char* argv[])
+{
+    const std::filesystem::path logFile = (argc > 0) ? argv[0] : "logger_benchmark.log";
+    const uint32_t iterations = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 5;
+
+    Logger::Settings settings;
+    settings.debuggerOutput = false;
+    settings.filePath = logFile;
+
+    Logger::StaticInitialize(settings);
+    WriteThreaded();
+    const std::string longText(1000, 'x');
+    Logger::Write(LogLevel::Info, LogCategory::General, "long %s %d", longText.c_str(), 12345);
+    const uint64_t stalls = Logger::Get()->GetStallCount();
+    Logger::StaticTerminate();
+
+    const std::vector<std::string> lines = ReadLines(logFile);
+    const bool threaded = CheckThreaded(lines);
+    const bool truncation = CheckTruncation(lines);
+    const bool levels = CheckLevels();
+
+    // What LOG used to do on the calling thread, format and write
+    FILE* file = nullptr;
+    fopen_s(&file, logFile.u8string().c_str(), "w");
+    const std::string name = "BlockAllocator";
+    const double syncMs = Measure(iterations, [&]()
+    {
+        char buffer[256];
+        for (uint32_t i = 0; i < MessageCount; ++i)
+        {
+            snprintf(buffer, std::size(buffer), "{%.3f}: %s allocated blocks at %p, Allocated: %zu\n", TimeUtil::GetTime(), name.c_str(), &buffer, static_cast<size_t>(i));
+            fputs(buffer, file);
+        }
+    });
+    fclose(file);
+
+    Logger::StaticInitialize(settings);
+    const double asyncMs = Measure(iterations, [&]()
+    {
+        for (uint32_t i = 0; i < MessageCount; ++i)
+        {
+            Logger::Write(LogLevel::Info, LogCategory::Core, "%s allocated blocks at %p, Allocated: %zu", name.c_str(), &name, static_cast<size_t>(i));
+        }
+        Logger::Flush();
+    });
+    // The logger thread drains between batches so only the writes are timed
+    double queuedMs = 0.0;
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        queuedMs += Measure(1, [&]()
+        {
+            for (uint32_t j = 0; j < Logger::QueueCapacity / 2; ++j)
+            {
+                Logger::Write(LogLevel::Info, LogCategory::Core, "%s allocated blocks at %p, Allocated: %zu", name.c_str(), &name, static_cast<size_t>(j));
+            }
+        });
+        Logger::Flush();
+    }
+    queuedMs /= iterations;
+    Logger::SetLevel(LogCategory::Core, LogLevel::Warning);
+    const double filteredMs = Measure(iterations, [&]()
+    {
+        for (uint32_t i = 0; i < MessageCount; ++i)
+        {
+            if (Logger::IsEnabled(LogLevel::Info, LogCategory::Core))
+            {
+                Logger::Write(LogLevel::Info, LogCategory::Core, "%s allocated blocks at %p, Allocated: %zu", name.c_str(), &name, static_cast<size_t>(i));
+            }
+        }
+    });
+    Logger::SetLevel(LogCategory::Core, LogLevel::Info);
+    Logger::StaticTerminate();
+
+    printf("%-32s %s (%zu lines, %llu stalls)\n", "Threaded order and strings", threaded ? "ok" : "FAILED", lines.size(), static_cast<unsigned long long>(stalls));
+    printf("%-32s %s\n", "Long string truncation", truncation ? "ok" : "FAILED");
+    printf("%-32s %s\n", "Category levels", levels ? "ok" : "FAILED");
+    printf("%-32s %12.1f ns\n", "Synchronous format + write", syncMs * 1.0e6 / MessageCount);
+    printf("%-32s %12.1f ns\n", "Async, including flush", asyncMs * 1.0e6 / MessageCount);
+    printf("%-32s %12.1f ns\n", "Async, caller only", queuedMs * 1.0e6 / (Logger::QueueCapacity / 2));
+    printf("%-32s %12.1f ns\n", "Filtered out", filteredMs * 1.0e6 / MessageCount);
+
+    return (threaded && truncation && levels) ? 0 : -1;
+}
\ No newline at end of file
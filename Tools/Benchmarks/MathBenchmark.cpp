@@ -0,0 +1,463 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Math;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    constexpr size_t BatchSize = 4096;
+
+    const char* GetInstructionSet()
+    {
+#if defined(IEXE_MATH_AVX2)
+        return "AVX2";
+#elif defined(IEXE_MATH_SSE)
+        return "SSE";
+#else
+        return "scalar";
+#endif
+    }
+
+    // Distance in representable floats, 0 means bit identical
+    uint32_t GetUlpDistance(float a, float b)
+    {
+        int32_t ia = 0;
+        int32_t ib = 0;
+        memcpy(&ia, &a, sizeof(float));
+        memcpy(&ib, &b, sizeof(float));
+        ia = (ia < 0) ? INT32_MIN - ia : ia;
+        ib = (ib < 0) ? INT32_MIN - ib : ib;
+        return static_cast<uint32_t>(std::abs(static_cast<int64_t>(ia) - static_cast<int64_t>(ib)));
+    }
+
+    template<size_t N>
+    uint32_t GetMaxUlpDistance(const float* a, const float* b)
+    {
+        uint32_t distance = 0;
+        for (size_t i = 0; i < N; ++i)
+        {
+            distance = Max(distance, GetUlpDistance(a[i], b[i]));
+        }
+        return distance;
+    }
+
+    Matrix4 RandomMatrix(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> range(-10.0f, 10.0f);
+        Matrix4 m;
+        for (float& f : m.v)
+        {
+            f = range(random);
+        }
+        return m;
+    }
+
+    // Rotation, scale and translation, the kind of matrix the engine actually inverts
+    Matrix4 RandomAffine(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> range(-1.0f, 1.0f);
+        const Quaternion rotation = Quaternion::Normalize({ range(random), range(random), range(random), range(random) + 1.5f });
+        return Matrix4::Scaling(1.0f + range(random) * 0.5f) *
+            Matrix4::MatrixRotationQuaternion(rotation) *
+            Matrix4::Translation(range(random) * 100.0f, range(random) * 100.0f, range(random) * 100.0f);
+    }
+
+    // Rotation and translation only
+    Matrix4 RandomRigid(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> range(-1.0f, 1.0f);
+        const Quaternion rotation = Quaternion::Normalize({ range(random), range(random), range(random), range(random) + 1.5f });
+        return Matrix4::MatrixRotationQuaternion(rotation) *
+            Matrix4::Translation(range(random) * 100.0f, range(random) * 100.0f, range(random) * 100.0f);
+    }
+
+    Graphics::Transform RandomTransform(std::mt19937& random, bool uniformScale)
+    {
+        std::uniform_real_distribution<float> range(-1.0f, 1.0f);
+        Graphics::Transform transform;
+        transform.position = { range(random) * 10.0f, range(random) * 10.0f, range(random) * 10.0f };
+        transform.rotation = Quaternion::Normalize({ range(random), range(random), range(random), range(random) + 1.5f });
+        transform.scale.x = 1.0f + range(random) * 0.5f;
+        transform.scale.y = uniformScale ? transform.scale.x : 1.0f + range(random) * 0.5f;
+        transform.scale.z = uniformScale ? transform.scale.x : 1.0f + range(random) * 0.5f;
+        return transform;
+    }
+
+    Vector3 RandomVector(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> range(-100.0f, 100.0f);
+        return { range(random), range(random), range(random) };
+    }
+
+    Matrix4 ScalarMultiply(const Matrix4& a, const Matrix4& b)
+    {
+        Matrix4 result;
+        Kernels::Scalar::MultiplyMatrix(a.v.data(), b.v.data(), result.v.data());
+        return result;
+    }
+
+    Matrix4 ScalarInverse(const Matrix4& m)
+    {
+        return Adjoint(m) * (1.0f / Determinant(m));
+    }
+
+    // Gauss-Jordan with partial pivoting in double precision, the reference for both float inverses
+    void InverseDouble(const Matrix4& m, double* result)
+    {
+        double rows[4][8];
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                rows[r][c] = m.v[r * 4 + c];
+                rows[r][c + 4] = (r == c) ? 1.0 : 0.0;
+            }
+        }
+        for (int c = 0; c < 4; ++c)
+        {
+            int pivot = c;
+            for (int r = c + 1; r < 4; ++r)
+            {
+                if (std::abs(rows[r][c]) > std::abs(rows[pivot][c]))
+                {
+                    pivot = r;
+                }
+            }
+            std::swap(rows[c], rows[pivot]);
+            const double invPivot = 1.0 / rows[c][c];
+            for (double& value : rows[c])
+            {
+                value *= invPivot;
+            }
+            for (int r = 0; r < 4; ++r)
+            {
+                if (r != c)
+                {
+                    const double factor = rows[r][c];
+                    for (int e = 0; e < 8; ++e)
+                    {
+                        rows[r][e] -= factor * rows[c][e];
+                    }
+                }
+            }
+        }
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                result[r * 4 + c] = rows[r][c + 4];
+            }
+        }
+    }
+
+    struct AccuracyResult
+    {
+        const char* name;
+        uint32_t maxUlp = 0;
+    };
+
+    bool RunAccuracy(std::mt19937& random)
+    {
+        AccuracyResult results[] =
+        {
+            { "Matrix4 * Matrix4" },
+            { "TransformCoord" },
+            { "TransformNormal" },
+            { "TransformCoords (batch)" },
+            { "TransformNormals (batch)" },
+            { "MultiplyMatrices (batch)" },
+            { "Quaternion::Slerp" },
+        };
+
+        std::vector<Matrix4> matrices(BatchSize);
+        std::vector<Vector3> points(BatchSize);
+        std::vector<Vector3> transformed(BatchSize);
+        std::vector<Matrix4> products(BatchSize);
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            matrices[i] = RandomMatrix(random);
+            points[i] = RandomVector(random);
+        }
+
+        const Matrix4 m = RandomMatrix(random);
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            const Matrix4 product = matrices[i] * m;
+            const Matrix4 expectedProduct = ScalarMultiply(matrices[i], m);
+            results[0].maxUlp = Max(results[0].maxUlp, GetMaxUlpDistance<16>(product.v.data(), expectedProduct.v.data()));
+
+            float expected[3];
+            const Vector3 coord = TransformCoord(points[i], m);
+            Kernels::Scalar::TransformCoord(points[i].v.data(), m.v.data(), expected);
+            results[1].maxUlp = Max(results[1].maxUlp, GetMaxUlpDistance<3>(coord.v.data(), expected));
+
+            const Vector3 normal = TransformNormal(points[i], m);
+            Kernels::Scalar::TransformNormal(points[i].v.data(), m.v.data(), expected);
+            results[2].maxUlp = Max(results[2].maxUlp, GetMaxUlpDistance<3>(normal.v.data(), expected));
+        }
+
+        TransformCoords(points.data(), BatchSize, m, transformed.data());
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            float expected[3];
+            Kernels::Scalar::TransformCoord(points[i].v.data(), m.v.data(), expected);
+            results[3].maxUlp = Max(results[3].maxUlp, GetMaxUlpDistance<3>(transformed[i].v.data(), expected));
+        }
+        TransformNormals(points.data(), BatchSize, m, transformed.data());
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            float expected[3];
+            Kernels::Scalar::TransformNormal(points[i].v.data(), m.v.data(), expected);
+            results[4].maxUlp = Max(results[4].maxUlp, GetMaxUlpDistance<3>(transformed[i].v.data(), expected));
+        }
+        MultiplyMatrices(matrices.data(), m, BatchSize, products.data());
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            const Matrix4 expected = ScalarMultiply(matrices[i], m);
+            results[5].maxUlp = Max(results[5].maxUlp, GetMaxUlpDistance<16>(products[i].v.data(), expected.v.data()));
+        }
+
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            const Quaternion q0 = Quaternion::Normalize({ unit(random) - 0.5f, unit(random) - 0.5f, unit(random) - 0.5f, unit(random) });
+            const Quaternion q1 = Quaternion::Normalize({ unit(random) - 0.5f, unit(random) - 0.5f, unit(random) - 0.5f, unit(random) });
+            const float t = unit(random);
+            const Quaternion q = Quaternion::Slerp(q0, q1, t);
+
+            // The original scalar blend
+            const float dot = q0.Dot(q1);
+            const float q1Scale = (dot < 0.0f) ? -1.0f : 1.0f;
+            const float theta = acosf(Abs(dot));
+            Quaternion expected = q;
+            if (Abs(dot) <= 0.9999f)
+            {
+                const float scale0 = sinf(theta * (1.0f - t)) / sinf(theta);
+                const float scale1 = q1Scale * sinf(theta * t) / sinf(theta);
+                expected = Quaternion::Normalize({
+                    (q0.x * scale0) + (q1.x * scale1),
+                    (q0.y * scale0) + (q1.y * scale1),
+                    (q0.z * scale0) + (q1.z * scale1),
+                    (q0.w * scale0) + (q1.w * scale1) });
+            }
+            results[6].maxUlp = Max(results[6].maxUlp, GetMaxUlpDistance<4>(&q.x, &expected.x));
+        }
+
+        bool passed = true;
+        // Same operations in the same order without fused multiply-adds, so these must be bit identical
+        printf("%-28s %10s\n", "Accuracy vs scalar", "Max ULP");
+        for (const AccuracyResult& result : results)
+        {
+            const bool ok = result.maxUlp == 0;
+            passed &= ok;
+            printf("%-28s %10u %s\n", result.name, result.maxUlp, ok ? "" : "FAILED");
+        }
+
+        // The SIMD inverse goes through 2x2 cofactor blocks instead of the full adjoint, so it can't match bit for bit.
+        // Both are held against a double precision inverse instead and the SIMD one may not be meaningfully worse
+        double simdError = 0.0;
+        double scalarError = 0.0;
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            const Matrix4 affine = RandomAffine(random);
+            const Matrix4 inverse = Inverse(affine);
+            const Matrix4 scalarInverse = ScalarInverse(affine);
+            double expected[16];
+            InverseDouble(affine, expected);
+            for (size_t e = 0; e < 16; ++e)
+            {
+                const double scale = std::max(1.0, std::abs(expected[e]));
+                simdError = std::max(simdError, std::abs(inverse.v[e] - expected[e]) / scale);
+                scalarError = std::max(scalarError, std::abs(scalarInverse.v[e] - expected[e]) / scale);
+            }
+        }
+        const bool inverseOk = simdError <= scalarError * 2.0 + 1.0e-6;
+        passed &= inverseOk;
+        printf("%-28s simd %.3g, scalar %.3g relative to double %s\n", "Inverse (affine)", simdError, scalarError, inverseOk ? "" : "FAILED");
+        return passed;
+    }
+
+    // Largest difference between a and b, relative to the magnitude of b's elements when they exceed 1
+    double GetMaxRelativeError(const float* a, const float* b, size_t count)
+    {
+        double error = 0.0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double scale = std::max(1.0, static_cast<double>(std::abs(b[i])));
+            error = std::max(error, std::abs(static_cast<double>(a[i]) - b[i]) / scale);
+        }
+        return error;
+    }
+
+    // The affine/rigid fast paths against the generic 4x4 versions they replace
+    bool RunAffineAccuracy(std::mt19937& random)
+    {
+        constexpr double Tolerance = 1.0e-4;
+
+        uint32_t multiplyUlp = 0;
+        uint32_t matrixUlp = 0;
+        double inverseAffineError = 0.0;
+        double inverseRigidError = 0.0;
+        double rotateError = 0.0;
+        double composeError = 0.0;
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            const Matrix4 a = RandomAffine(random);
+            const Matrix4 b = RandomAffine(random);
+            const Matrix4 affineProduct = MultiplyAffine(a, b);
+            const Matrix4 product = a * b;
+            multiplyUlp = Max(multiplyUlp, GetMaxUlpDistance<16>(affineProduct.v.data(), product.v.data()));
+
+            const Matrix4 inverse = Inverse(a);
+            inverseAffineError = std::max(inverseAffineError, GetMaxRelativeError(InverseAffine(a).v.data(), inverse.v.data(), 16));
+
+            const Matrix4 rigid = RandomRigid(random);
+            inverseRigidError = std::max(inverseRigidError, GetMaxRelativeError(InverseRigid(rigid).v.data(), Inverse(rigid).v.data(), 16));
+
+            const Graphics::Transform child = RandomTransform(random, false);
+            const Graphics::Transform parent = RandomTransform(random, true);
+            const Matrix4 childMatrix = child.GetMatrix4();
+            const Matrix4 expectedMatrix = Matrix4::Scaling(child.scale) * Matrix4::MatrixRotationQuaternion(child.rotation) * Matrix4::Translation(child.position);
+            matrixUlp = Max(matrixUlp, GetMaxUlpDistance<16>(childMatrix.v.data(), expectedMatrix.v.data()));
+
+            const Vector3 v = RandomVector(random);
+            const Vector3 rotated = Rotate(v, child.rotation);
+            const Vector3 expectedRotated = TransformNormal(v, Matrix4::MatrixRotationQuaternion(child.rotation));
+            rotateError = std::max(rotateError, GetMaxRelativeError(rotated.v.data(), expectedRotated.v.data(), 3));
+
+            const Matrix4 composed = (child * parent).GetMatrix4();
+            const Matrix4 chained = childMatrix * parent.GetMatrix4();
+            composeError = std::max(composeError, GetMaxRelativeError(composed.v.data(), chained.v.data(), 16));
+        }
+
+        const bool multiplyOk = multiplyUlp == 0;
+        const bool matrixOk = matrixUlp == 0;
+        const bool inverseAffineOk = inverseAffineError <= Tolerance;
+        const bool inverseRigidOk = inverseRigidError <= Tolerance;
+        const bool rotateOk = rotateError <= Tolerance;
+        const bool composeOk = composeError <= Tolerance;
+        printf("%-28s %10s\n", "Affine paths vs generic", "Max error");
+        printf("%-28s %7u ULP %s\n", "MultiplyAffine", multiplyUlp, multiplyOk ? "" : "FAILED");
+        printf("%-28s %7u ULP %s\n", "Transform::GetMatrix4", matrixUlp, matrixOk ? "" : "FAILED");
+        printf("%-28s %10.3g %s\n", "InverseAffine", inverseAffineError, inverseAffineOk ? "" : "FAILED");
+        printf("%-28s %10.3g %s\n", "InverseRigid", inverseRigidError, inverseRigidOk ? "" : "FAILED");
+        printf("%-28s %10.3g %s\n", "Rotate", rotateError, rotateOk ? "" : "FAILED");
+        printf("%-28s %10.3g %s\n", "Transform * Transform", composeError, composeOk ? "" : "FAILED");
+        return multiplyOk && matrixOk && inverseAffineOk && inverseRigidOk && rotateOk && composeOk;
+    }
+
+    void RunAffineTimings(std::mt19937& random, uint32_t iterations)
+    {
+        std::vector<Matrix4> affines(BatchSize);
+        std::vector<Matrix4> rigids(BatchSize);
+        std::vector<Graphics::Transform> transforms(BatchSize);
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            affines[i] = RandomAffine(random);
+            rigids[i] = RandomRigid(random);
+            transforms[i] = RandomTransform(random, true);
+        }
+        const Matrix4 m = RandomAffine(random);
+        const Graphics::Transform parent = RandomTransform(random, true);
+        std::vector<Matrix4> results(BatchSize);
+        std::vector<Graphics::Transform> composed(BatchSize);
+
+        struct Timing
+        {
+            const char* name;
+            double genericMs;
+            double fastMs;
+        };
+
+        const Timing timings[] = {
+            { "MultiplyAffine",
+                Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) results[i] = affines[i] * m; }),
+                Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) results[i] = MultiplyAffine(affines[i], m); }) },
+            { "InverseAffine",
+                Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) results[i] = Inverse(affines[i]); }),
+                Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) results[i] = InverseAffine(affines[i]); }) },
+            { "InverseRigid",
+                Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) results[i] = Inverse(rigids[i]); }),
+                Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) results[i] = InverseRigid(rigids[i]); }) },
+            // The old TransformComponent::GetWorldTransform built both matrices and multiplied them
+            { "Transform * Transform",
+                Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) results[i] = transforms[i].GetMatrix4() * parent.GetMatrix4(); }),
+                Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) composed[i] = transforms[i] * parent; }) },
+        };
+
+        const double toNs = 1.0e6 / BatchSize;
+        printf("%-28s %12s %12s %8s\n", "Per element (ns)", "Generic", "Fast path", "Speedup");
+        for (const Timing& timing : timings)
+        {
+            printf("%-28s %12.3f %12.3f %7.1fx\n", timing.name, timing.genericMs * toNs, timing.fastMs * toNs,
+                (timing.fastMs > 0.0) ? timing.genericMs / timing.fastMs : 0.0);
+        }
+    }
+
+    void RunTimings(std::mt19937& random, uint32_t iterations)
+    {
+        std::vector<Matrix4> matrices(BatchSize);
+        std::vector<Matrix4> affines(BatchSize);
+        std::vector<Vector3> points(BatchSize);
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            matrices[i] = RandomMatrix(random);
+            affines[i] = RandomAffine(random);
+            points[i] = RandomVector(random);
+        }
+        const Matrix4 m = RandomMatrix(random);
+        std::vector<Matrix4> products(BatchSize);
+        std::vector<Vector3> transformed(BatchSize);
+
+        struct Timing
+        {
+            const char* name;
+            double scalarMs;
+            double simdMs;
+            double batchMs;
+        };
+
+        Timing timings[4] = {};
+        timings[0] = { "Matrix4 * Matrix4",
+            Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) products[i] = ScalarMultiply(matrices[i], m); }),
+            Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) products[i] = matrices[i] * m; }),
+            Measure(iterations, [&]() { MultiplyMatrices(matrices.data(), m, BatchSize, products.data()); }) };
+        timings[1] = { "TransformCoord",
+            Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) Kernels::Scalar::TransformCoord(points[i].v.data(), m.v.data(), transformed[i].v.data()); }),
+            Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) transformed[i] = TransformCoord(points[i], m); }),
+            Measure(iterations, [&]() { TransformCoords(points.data(), BatchSize, m, transformed.data()); }) };
+        timings[2] = { "TransformNormal",
+            Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) Kernels::Scalar::TransformNormal(points[i].v.data(), m.v.data(), transformed[i].v.data()); }),
+            Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) transformed[i] = TransformNormal(points[i], m); }),
+            Measure(iterations, [&]() { TransformNormals(points.data(), BatchSize, m, transformed.data()); }) };
+        timings[3] = { "Inverse",
+            Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) products[i] = ScalarInverse(affines[i]); }),
+            Measure(iterations, [&]() { for (size_t i = 0; i < BatchSize; ++i) products[i] = Inverse(affines[i]); }),
+            0.0 };
+
+        const double toNs = 1.0e6 / BatchSize;
+        printf("%-28s %12s %12s %12s %8s\n", "Per element (ns)", "Scalar", "SIMD", "Batch", "Speedup");
+        for (const Timing& timing : timings)
+        {
+            const double best = (timing.batchMs > 0.0) ? Min(timing.simdMs, timing.batchMs) : timing.simdMs;
+            printf("%-28s %12.3f %12.3f %12.3f %7.1fx\n", timing.name, timing.scalarMs * toNs, timing.simdMs * toNs,
+                timing.batchMs * toNs, (best > 0.0) ? timing.scalarMs / best : 0.0);
+        }
+    }
+}
+
+// Args: [iterations]
+int Benchmarks::RunMath(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 200;
+
+    printf("Math kernels: %s\n", GetInstructionSet());
+    std::mt19937 random(1234);
+    bool passed = RunAccuracy(random);
+    passed &= RunAffineAccuracy(random);
+    RunTimings(random, iterations);
+    RunAffineTimings(random, iterations);
+    return passed ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    constexpr uint32_t AllocationCount = 100000;
+
+    struct alignas(64) CacheLineData
+    {
+        uint8_t bytes[64];
+    };
+
+    // Bytes and counts land on the tag active at allocation time and come off it again on free, even when the
+    // free happens under another tag or on another thread
+    bool CheckTags()
+    {
+        const MemoryTracker::TagStats before = MemoryTracker::GetTagStats(MemoryTag::Models);
+        std::vector<uint8_t>* data = nullptr;
+        {
+            MEMORY_TAG(Models);
+            data = new std::vector<uint8_t>(1000);
+        }
+        const MemoryTracker::TagStats during = MemoryTracker::GetTagStats(MemoryTag::Models);
+        {
+            MEMORY_TAG(Audio);
+            std::thread([data]() { delete data; }).join();
+        }
+        const MemoryTracker::TagStats after = MemoryTracker::GetTagStats(MemoryTag::Models);
+
+        return during.bytesLive == before.bytesLive + 1000 + sizeof(std::vector<uint8_t>) &&
+            during.allocationsLive == before.allocationsLive + 2 &&
+            after.bytesLive == before.bytesLive && after.allocationsLive == before.allocationsLive &&
+            after.bytesPeak >= during.bytesLive && MemoryTracker::GetThreadTag() == MemoryTag::Untagged;
+    }
+
+    bool CheckAligned()
+    {
+        bool passed = true;
+        std::vector<std::unique_ptr<CacheLineData>> blocks;
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            blocks.push_back(std::make_unique<CacheLineData>());
+            passed &= (reinterpret_cast<uintptr_t>(blocks.back().get()) % alignof(CacheLineData)) == 0;
+        }
+        void* bulletBlock = MemoryTracker::Allocate(100, 16);
+        passed &= bulletBlock != nullptr && (reinterpret_cast<uintptr_t>(bulletBlock) % 16) == 0;
+        MemoryTracker::Free(bulletBlock);
+        return passed;
+    }
+
+    // The frame counter sees every allocation, and a loop over reserved memory shows none on the thread counter
+    bool CheckFrameCounts()
+    {
+        std::vector<uint32_t> values;
+        values.reserve(AllocationCount);
+
+        MemoryTracker::BeginFrame();
+        const uint64_t threadStart = MemoryTracker::GetThreadAllocationCount();
+        for (uint32_t i = 0; i < AllocationCount; ++i)
+        {
+            values.push_back(i);
+        }
+        const bool allocationFree = MemoryTracker::GetThreadAllocationCount() == threadStart;
+
+        // Kept until after the frame ends, a new deleted straight away can be elided by the compiler
+        std::array<int*, 10> numbers = {};
+        for (uint32_t i = 0; i < numbers.size(); ++i)
+        {
+            numbers[i] = new int(i);
+        }
+        MemoryTracker::BeginFrame();
+        for (int* number : numbers)
+        {
+            delete number;
+        }
+        return allocationFree && MemoryTracker::GetLastFrameAllocationCount() >= 10 && MemoryTracker::GetFrameAllocationCount() == 0;
+    }
+
+    bool CheckCallstacks()
+    {
+        MemoryTracker::ClearCallstacks();
+        MemoryTracker::SetCallstackSampleInterval(1);
+        std::vector<std::unique_ptr<std::array<uint8_t, 256>>> arrays(100);
+        {
+            MEMORY_TAG(Components);
+            for (auto& array : arrays)
+            {
+                array = std::make_unique<std::array<uint8_t, 256>>();
+            }
+        }
+        MemoryTracker::SetCallstackSampleInterval(0);
+
+        std::vector<MemoryTracker::Callstack> callstacks;
+        MemoryTracker::GetTopCallstacks(callstacks, 5);
+        return !callstacks.empty() && callstacks[0].tag == MemoryTag::Components && callstacks[0].samples >= 100 && !callstacks[0].frames.empty();
+    }
+}
+
+// Args: [iterations]
+int Benchmarks::RunMemory(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 5;
+
+    if (!MemoryTracker::IsEnabled())
+    {
+        printf("Memory tracking is compiled out (IEXE_DISABLE_MEMORY_TRACKING)\n");
+        return 0;
+    }
+
+    const bool tags = CheckTags();
+    const bool aligned = CheckAligned();
+    const bool frameCounts = CheckFrameCounts();
+    const bool callstacks = CheckCallstacks();
+
+    printf("%-32s %s\n", "Tag attribution", tags ? "ok" : "FAILED");
+    printf("%-32s %s\n", "Aligned allocations", aligned ? "ok" : "FAILED");
+    printf("%-32s %s\n", "Frame and thread counts", frameCounts ? "ok" : "FAILED");
+    printf("%-32s %s\n", "Callstack sampling", callstacks ? "ok" : "FAILED");
+
+    // What the hooks add on top of the malloc underneath them
+    std::vector<void*> blocks(AllocationCount);
+    const double mallocMs = Measure(iterations, [&]()
+    {
+        for (void*& block : blocks)
+        {
+            block = std::malloc(48);
+        }
+        for (void* block : blocks)
+        {
+            std::free(block);
+        }
+    });
+    const double trackedMs = Measure(iterations, [&]()
+    {
+        for (void*& block : blocks)
+        {
+            block = ::operator new(48);
+        }
+        for (void* block : blocks)
+        {
+            ::operator delete(block);
+        }
+    });
+    MemoryTracker::SetCallstackSampleInterval(1000);
+    const double sampledMs = Measure(iterations, [&]()
+    {
+        for (void*& block : blocks)
+        {
+            block = ::operator new(48);
+        }
+        for (void* block : blocks)
+        {
+            ::operator delete(block);
+        }
+    });
+
+    printf("%-32s %12.1f ns\n", "malloc + free", mallocMs * 1.0e6 / AllocationCount);
+    printf("%-32s %12.1f ns\n", "Tracked new + delete", trackedMs * 1.0e6 / AllocationCount);
+    printf("%-32s %12.1f ns\n", "Sampling every 1000th", sampledMs * 1.0e6 / AllocationCount);
+    printf("\n%s", MemoryTracker::Report(3).c_str());
+    MemoryTracker::SetCallstackSampleInterval(0);
+
+    return (tags && aligned && frameCounts && callstacks) ? 0 : -1;
+}
\ No newline at end of file
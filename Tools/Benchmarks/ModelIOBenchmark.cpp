@@ -0,0 +1,131 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+namespace
+{
+    struct AssetEntry
+    {
+        std::filesystem::path filePath;
+        bool animOnly = false;
+    };
+
+    // Reads the import lines of the ModelImporter command list, the last argument of each line is the output file
+    std::vector<AssetEntry> ReadAssetList(const std::filesystem::path& commandsFile)
+    {
+        std::vector<AssetEntry> assets;
+
+        FILE* file = nullptr;
+        fopen_s(&file, commandsFile.u8string().c_str(), "r");
+        if (file == nullptr)
+        {
+            printf("Failed to open %s\n", commandsFile.u8string().c_str());
+            return assets;
+        }
+
+        char line[1024];
+        while (fgets(line, sizeof(line), file) != nullptr)
+        {
+            std::string command = line;
+            if (command.find(".fbx") == std::string::npos)
+            {
+                continue;
+            }
+
+            while (!command.empty() && isspace(static_cast<unsigned char>(command.back())))
+            {
+                command.pop_back();
+            }
+
+            AssetEntry& entry = assets.emplace_back();
+            entry.filePath = command.substr(command.rfind(' ') + 1);
+            entry.animOnly = command.find("-animOnly 1") != std::string::npos;
+        }
+        fclose(file);
+        return assets;
+    }
+
+    uintmax_t GetFileSize(std::filesystem::path filePath, const char* extension)
+    {
+        filePath.replace_extension(extension);
+        std::error_code error;
+        const uintmax_t size = std::filesystem::file_size(filePath, error);
+        return error ? 0 : size;
+    }
+
+    bool HasBinary(const AssetEntry& entry)
+    {
+        return GetFileSize(entry.filePath, entry.animOnly ? "banimset" : "bmodel") > 0;
+    }
+
+    void LoadText(const AssetEntry& entry)
+    {
+        Model model;
+        if (!entry.animOnly)
+        {
+            ModelIO::LoadModel(entry.filePath, model);
+            ModelIO::LoadSkeleton(entry.filePath, model);
+        }
+        ModelIO::LoadAnimation(entry.filePath, model);
+    }
+
+    void LoadBinary(const AssetEntry& entry)
+    {
+        Model model;
+        if (!entry.animOnly)
+        {
+            ModelIO::LoadModelBinary(entry.filePath, model);
+            ModelIO::LoadSkeletonBinary(entry.filePath, model);
+        }
+        ModelIO::LoadAnimationBinary(entry.filePath, model);
+    }
+}
+
+// Args: [commands file] [iterations]
+int Benchmarks::RunModelIO(int argc, char* argv[])
+{
+    const std::filesystem::path commandsFile = (argc > 0) ? argv[0] : "../ModelImporter/commands.txt";
+    const uint32_t iterations = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 3;
+
+    const std::vector<AssetEntry> assets = ReadAssetList(commandsFile);
+    if (assets.empty())
+    {
+        printf("No assets found in %s\n", commandsFile.u8string().c_str());
+        return -1;
+    }
+
+    printf("%-48s %12s %12s %12s %12s %8s\n", "Asset", "Text (ms)", "Binary (ms)", "Text (KB)", "Binary (KB)", "Speedup");
+
+    double totalText = 0.0;
+    double totalBinary = 0.0;
+    for (const AssetEntry& entry : assets)
+    {
+        const std::string name = entry.filePath.filename().u8string();
+        if (!HasBinary(entry))
+        {
+            printf("%-48s missing binary files, re-run the ModelImporter\n", name.c_str());
+            continue;
+        }
+
+        const double textMs = Measure(iterations, [&]() { LoadText(entry); });
+        const double binaryMs = Measure(iterations, [&]() { LoadBinary(entry); });
+        totalText += textMs;
+        totalBinary += binaryMs;
+
+        uintmax_t textSize = GetFileSize(entry.filePath, "animset");
+        uintmax_t binarySize = GetFileSize(entry.filePath, "banimset");
+        if (!entry.animOnly)
+        {
+            textSize += GetFileSize(entry.filePath, "model") + GetFileSize(entry.filePath, "skeleton");
+            binarySize += GetFileSize(entry.filePath, "bmodel") + GetFileSize(entry.filePath, "bskeleton");
+        }
+
+        printf("%-48s %12.3f %12.3f %12.1f %12.1f %7.1fx\n", name.c_str(), textMs, binaryMs,
+            textSize / 1024.0, binarySize / 1024.0, (binaryMs > 0.0) ? textMs / binaryMs : 0.0);
+    }
+
+    printf("%-48s %12.3f %12.3f %12s %12s %7.1fx\n", "Total", totalText, totalBinary, "", "",
+        (totalBinary > 0.0) ? totalText / totalBinary : 0.0);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+
+namespace
+{
+    using Benchmarks::Measure;
+    using Benchmarks::ZombieComponent;
+
+    bool CheckZombie(GameObject& zombie, float moveSpeed)
+    {
+        const ZombieComponent* component = zombie.GetComponent<ZombieComponent>();
+        const GameObject* head = zombie.GetChild(0);
+        return component != nullptr && component->moveSpeed == moveSpeed && component->animations.size() == 3 &&
+            component->looping == 1 && zombie.HasA<TransformComponent>() && zombie.GetChildCount() == 1 &&
+            head != nullptr && head->GetParent() == &zombie &&
+            head->GetComponent<TransformComponent>()->position.y == 1.8f &&
+            head->GetComponent<TransformComponent>()->scale.x == 0.5f;
+    }
+
+    // Spawns count zombies into a fresh world, clearing the cache before each one when cached is false so every
+    // instance reads and parses its templates like Make did before the cache
+    bool SpawnZombies(const std::filesystem::path& zombiePath, uint32_t count, bool cached, float moveSpeed)
+    {
+        GameWorld world;
+        world.SetComponentLayout(ComponentLayout::Pooled);
+        world.Initialize(2 * count);
+
+        bool passed = true;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (!cached)
+            {
+                GameObjectFactory::ClearPrefabCache();
+            }
+            GameObject* zombie = world.CreateGameObject("Zombie", zombiePath);
+            passed &= CheckZombie(*zombie, moveSpeed);
+        }
+        world.Terminate();
+        return passed;
+    }
+}
+
+// Args: [instances] [iterations]
+int Benchmarks::RunPrefab(int argc, char* argv[])
+{
+    const uint32_t instances = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 200;
+    const uint32_t iterations = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 20;
+
+    SetZombieFactory();
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "IExePrefabBenchmark";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path zombiePath = directory / "zombie_obj.json";
+    const std::filesystem::path headPath = directory / "zombie_head.json";
+    WriteTextFile(headPath, HeadTemplate);
+    WriteZombieTemplate(zombiePath, headPath, 1.5f);
+    GameObjectFactory::ClearPrefabCache();
+
+    bool passed = true;
+    const double parsedMs = Measure(iterations, [&]() { passed &= SpawnZombies(zombiePath, instances, false, 1.5f); });
+    const double cachedMs = Measure(iterations, [&]() { passed &= SpawnZombies(zombiePath, instances, true, 1.5f); });
+
+    // Saving the template again has to show up in the first spawn after a reload. Pushed forward explicitly, file
+    // systems can have coarse timestamps
+    WriteZombieTemplate(zombiePath, headPath, 3.0f);
+    std::filesystem::last_write_time(zombiePath, std::filesystem::last_write_time(zombiePath) + std::chrono::seconds(2));
+    GameObjectFactory::ReloadChangedPrefabs();
+    const bool reloaded = SpawnZombies(zombiePath, 1, true, 3.0f);
+    passed &= reloaded;
+
+    printf("%u zombies with a child each, %u iterations\n", instances, iterations);
+    printf("%-24s %14s %16s\n", "", "Spawn all (ms)", "Per zombie (us)");
+    printf("%-24s %14.3f %16.2f\n", "Parse every instance", parsedMs, parsedMs * 1.0e3 / instances);
+    printf("%-24s %14.3f %16.2f\n", "Cached prefab", cachedMs, cachedMs * 1.0e3 / instances);
+    printf("%-24s %14.1fx\n", "Speedup", (cachedMs > 0.0) ? parsedMs / cachedMs : 0.0);
+    printf("%-24s %14s\n", "Reload on save", reloaded ? "ok" : "FAILED");
+    printf("Checks %s\n", passed ? "ok" : "FAILED");
+
+    GameObjectFactory::ClearPrefabCache();
+    ClearZombieFactory();
+    std::filesystem::remove_all(directory);
+    return passed ? 0 : -1;
+}
\ No newline at end of file
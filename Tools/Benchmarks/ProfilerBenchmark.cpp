@@ -0,0 +1,152 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    constexpr uint32_t ScopeCount = 100000;
+
+    // Keeps the leaf scopes from being optimized away, per thread so jobs can use it too
+    thread_local uint32_t sSink = 0;
+
+    void ProfiledLeaf(uint32_t value)
+    {
+        PROFILE_SCOPE("Leaf");
+        sSink += value;
+    }
+
+    size_t CountEvents(const std::vector<Profiler::ThreadEvents>& threads, const char* name)
+    {
+        size_t count = 0;
+        for (const Profiler::ThreadEvents& thread : threads)
+        {
+            count += std::count_if(thread.events.begin(), thread.events.end(), [name](const Profiler::Event& event) { return strcmp(event.name, name) == 0; });
+        }
+        return count;
+    }
+
+    // Inner scopes sit one level below their outer scope and inside its time range
+    bool CheckNesting()
+    {
+        const uint64_t start = Profiler::GetTimestamp();
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            PROFILE_SCOPE("Outer");
+            ProfiledLeaf(i);
+            ProfiledLeaf(i);
+        }
+
+        std::vector<Profiler::ThreadEvents> threads;
+        Profiler::Get()->GetEvents(start, UINT64_MAX, threads);
+        const std::vector<Profiler::Event>& events = threads[0].events;
+        bool passed = events.size() == 30;
+        for (size_t i = 0; passed && i + 2 < events.size(); i += 3)
+        {
+            const Profiler::Event& outer = events[i + 2];
+            passed = strcmp(outer.name, "Outer") == 0 && outer.depth == 0;
+            for (size_t j = i; j < i + 2; ++j)
+            {
+                passed = passed && events[j].depth == 1 && events[j].start >= outer.start && events[j].end <= outer.end;
+            }
+        }
+        return passed;
+    }
+
+    // Every batch records on whichever thread ran it
+    bool CheckJobs()
+    {
+        const uint64_t start = Profiler::GetTimestamp();
+        constexpr uint32_t count = 4096;
+        JobSystem::Get()->ParallelFor(count, 16, [](uint32_t begin, uint32_t end)
+        {
+            PROFILE_SCOPE("Batch");
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                ProfiledLeaf(i);
+            }
+        });
+
+        std::vector<Profiler::ThreadEvents> threads;
+        Profiler::Get()->GetEvents(start, UINT64_MAX, threads);
+        return CountEvents(threads, "Batch") == count / 16 && CountEvents(threads, "Leaf") == count;
+    }
+
+    // Once the ring wraps only the newest events are returned, less the oldest slot since the owner may be reusing it
+    bool CheckWrap()
+    {
+        const uint64_t start = Profiler::GetTimestamp();
+        for (uint32_t i = 0; i < Profiler::EventCapacity + 1000; ++i)
+        {
+            ProfiledLeaf(i);
+        }
+
+        std::vector<Profiler::ThreadEvents> threads;
+        Profiler::Get()->GetEvents(start, UINT64_MAX, threads);
+        const std::vector<Profiler::Event>& events = threads[0].events;
+        bool passed = events.size() == Profiler::EventCapacity - 1;
+        for (size_t i = 1; passed && i < events.size(); ++i)
+        {
+            passed = events[i].start >= events[i - 1].end;
+        }
+        return passed;
+    }
+}
+
+// Args: [trace file] [iterations]
+int Benchmarks::RunProfiler(int argc, char* argv[])
+{
+    const std::filesystem::path traceFile = (argc > 0) ? argv[0] : "profile_trace.json";
+    const uint32_t iterations = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 10;
+
+    // Not initialized, every scope is a null check
+    const double disabledMs = Measure(iterations, []()
+    {
+        for (uint32_t i = 0; i < ScopeCount; ++i)
+        {
+            ProfiledLeaf(i);
+        }
+    });
+
+    Profiler::StaticInitialize();
+    JobSystem::StaticInitialize();
+
+    const double enabledMs = Measure(iterations, []()
+    {
+        for (uint32_t i = 0; i < ScopeCount; ++i)
+        {
+            ProfiledLeaf(i);
+        }
+    });
+
+    const bool nesting = CheckNesting();
+    const bool jobs = CheckJobs();
+    const bool wrap = CheckWrap();
+
+    // A few frames of mixed work so the trace has something to show
+    for (uint32_t frame = 0; frame < 8; ++frame)
+    {
+        Profiler::Get()->BeginFrame();
+        PROFILE_SCOPE("Frame");
+        CheckJobs();
+    }
+    Profiler::Get()->BeginFrame();
+    const bool exported = Profiler::Get()->ExportChromeTrace(traceFile);
+    std::error_code error;
+    const uintmax_t traceSize = std::filesystem::file_size(traceFile, error);
+
+    JobSystem::StaticTerminate();
+    Profiler::StaticTerminate();
+
+    printf("%-28s %s\n", "Nested scopes", nesting ? "ok" : "FAILED");
+    printf("%-28s %s\n", "Scopes on job threads", jobs ? "ok" : "FAILED");
+    printf("%-28s %s\n", "Ring buffer wrap", wrap ? "ok" : "FAILED");
+    printf("%-28s %s (%s, %.1f KB)\n", "Chrome trace export", (exported && !error) ? "ok" : "FAILED",
+        traceFile.u8string().c_str(), error ? 0.0 : traceSize / 1024.0);
+    printf("%-28s %12.1f ns\n", "Scope, profiler off", disabledMs * 1.0e6 / ScopeCount);
+    printf("%-28s %12.1f ns\n", "Scope, recording", enabledMs * 1.0e6 / ScopeCount);
+
+    return (nesting && jobs && wrap && exported && !error) ? 0 : -1;
+}
\ No newline at end of file
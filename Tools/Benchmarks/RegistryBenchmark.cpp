@@ -0,0 +1,109 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    const char* ComponentNames[] =
+    {
+        "TransformComponent", "CameraComponent", "FPSCameraComponent", "MeshComponent", "ModelComponent",
+        "AnimatorComponent", "RigidBodyComponent", "SoundEventComponent", "SoundBankComponent", "UITextComponent",
+        "UISpriteComponent", "UIButtonComponent", "PlayerControllerComponent", "TPSCameraComponent",
+        "ZombieControllerComponent"
+    };
+
+    const char* ServiceNames[] =
+    {
+        "CameraService", "RenderService", "PhysicsService", "UIRenderService", "AnimationService"
+    };
+
+    // What GameObjectFactory did per component before the registry: a std::string from the json name, then one
+    // comparison per engine type until it matched
+    int LegacyFind(const char* componentName)
+    {
+        const std::string name = componentName;
+        for (int i = 0; i < static_cast<int>(std::size(ComponentNames)); ++i)
+        {
+            if (name == ComponentNames[i])
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    template<class ComponentType>
+    bool CheckComponent(const char* name)
+    {
+        const ComponentInfo* info = TypeRegistry::FindComponent(name);
+        return info != nullptr && info->typeId == ComponentType::StaticGetTypeId() && info->size == sizeof(ComponentType) &&
+            info->alignment == alignof(ComponentType) && *info->type == typeid(ComponentType) &&
+            TypeRegistry::GetComponentInfo(info->typeId) == info;
+    }
+
+    bool CheckRegistry()
+    {
+        bool passed = true;
+        for (const char* name : ComponentNames)
+        {
+            const ComponentInfo* info = TypeRegistry::FindComponent(name);
+            passed &= info != nullptr && strcmp(info->name, name) == 0 && info->make != nullptr && info->get != nullptr;
+        }
+        for (const char* name : ServiceNames)
+        {
+            const ServiceInfo* info = TypeRegistry::FindService(name);
+            passed &= info != nullptr && strcmp(info->name, name) == 0 && info->add != nullptr;
+        }
+        passed &= CheckComponent<TransformComponent>("TransformComponent");
+        passed &= CheckComponent<RigidBodyComponent>("RigidBodyComponent");
+        passed &= CheckComponent<ZombieControllerComponent>("ZombieControllerComponent");
+
+        // Hashed at compile time, and a name that only shares a prefix isn't found
+        constexpr uint32_t transformHash = TypeRegistry::HashName("TransformComponent");
+        passed &= TypeRegistry::FindComponent(transformHash) == TypeRegistry::FindComponent("TransformComponent");
+        passed &= TypeRegistry::FindComponent("Transform") == nullptr && TypeRegistry::FindComponent("") == nullptr;
+        passed &= TypeRegistry::FindService("CustomDebugDrawService") == nullptr;
+        return passed;
+    }
+}
+
+// Args: [iterations]
+int Benchmarks::RunRegistry(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 100000;
+
+    bool passed = CheckRegistry();
+
+    // Every engine name plus one only a custom callback knows, the worst case for the chain
+    std::vector<const char*> names(std::begin(ComponentNames), std::end(ComponentNames));
+    names.push_back("CustomDebugDrawComponent");
+
+    int legacyFound = 0;
+    const double legacyMs = Measure(iterations, [&]()
+    {
+        for (const char* name : names)
+        {
+            legacyFound += (LegacyFind(name) >= 0) ? 1 : 0;
+        }
+    });
+    int registryFound = 0;
+    const double registryMs = Measure(iterations, [&]()
+    {
+        for (const char* name : names)
+        {
+            registryFound += (TypeRegistry::FindComponent(name) != nullptr) ? 1 : 0;
+        }
+    });
+    passed &= legacyFound == registryFound && registryFound == static_cast<int>(iterations * std::size(ComponentNames));
+
+    const double lookupCount = static_cast<double>(names.size());
+    printf("%u passes over %zu component names\n", iterations, names.size());
+    printf("%-24s %14s\n", "", "Per lookup (ns)");
+    printf("%-24s %14.1f\n", "String compare chain", legacyMs * 1.0e6 / lookupCount);
+    printf("%-24s %14.1f\n", "TypeRegistry", registryMs * 1.0e6 / lookupCount);
+    printf("%-24s %14.1fx\n", "Speedup", (registryMs > 0.0) ? legacyMs / registryMs : 0.0);
+    printf("Checks %s\n", passed ? "ok" : "FAILED");
+    return passed ? 0 : -1;
+}
\ No newline at end of file
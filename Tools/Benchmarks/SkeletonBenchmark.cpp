@@ -0,0 +1,126 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Graphics;
+
+namespace
+{
+    struct SkeletonAsset
+    {
+        const char* modelFile;
+        const char* animationFile;
+    };
+
+    const SkeletonAsset sAssets[] =
+    {
+        { "zombie/zombie.model", "../../Assets/Models/zombie/Thriller.animset" },
+        { "parasite/parasite.model", "../../Assets/Models/parasite/samba.animset" },
+    };
+
+    // The original path: recursive walk over Bone pointers, a ModelManager lookup and a track sample per bone,
+    // then a second pass for the offsets
+    void ComputeBoneTransformsRecursive(const Bone* bone, AnimationUtil::BoneTransforms& boneTransforms, ModelId modelId, float tick, bool animate)
+    {
+        const Animation* animation = nullptr;
+        if (animate)
+        {
+            const Model* model = ModelManager::Get()->GetModel(modelId);
+            animation = model->animationClips[0].boneAnimations[bone->index].get();
+        }
+        boneTransforms[bone->index] = (animation != nullptr) ? animation->GetTransform(tick).GetMatrix4() : bone->toParentTransform;
+        if (bone->parent != nullptr)
+        {
+            boneTransforms[bone->index] = boneTransforms[bone->index] * boneTransforms[bone->parentIndex];
+        }
+        for (const Bone* child : bone->children)
+        {
+            ComputeBoneTransformsRecursive(child, boneTransforms, modelId, tick, animate);
+        }
+    }
+
+    void ComputeLegacy(const Model& model, ModelId modelId, float tick, bool animate, AnimationUtil::BoneTransforms& boneTransforms)
+    {
+        boneTransforms.resize(model.skeleton->bones.size());
+        ComputeBoneTransformsRecursive(model.skeleton->root, boneTransforms, modelId, tick, animate);
+        for (const auto& bone : model.skeleton->bones)
+        {
+            boneTransforms[bone->index] = bone->offsetTransform * boneTransforms[bone->index];
+        }
+    }
+
+    float GetMaxDifference(const AnimationUtil::BoneTransforms& a, const AnimationUtil::BoneTransforms& b)
+    {
+        float difference = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            for (size_t e = 0; e < a[i].v.size(); ++e)
+            {
+                difference = Math::Max(difference, Math::Abs(a[i].v[e] - b[i].v[e]));
+            }
+        }
+        return difference;
+    }
+}
+
+// Args: [iterations]
+int Benchmarks::RunSkeleton(int argc, char* argv[])
+{
+    const uint32_t iterations = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 10000;
+
+    ModelManager::StaticInitialize(L"../../Assets/Models");
+    ModelManager* modelManager = ModelManager::Get();
+
+    printf("%-24s %6s %16s %16s %16s %16s\n", "Skeleton", "Bones", "Bind old (us)", "Bind flat (us)", "Anim old (us)", "Anim flat (us)");
+    for (const SkeletonAsset& asset : sAssets)
+    {
+        const ModelId modelId = modelManager->LoadModel(asset.modelFile);
+        modelManager->AddAnimation(modelId, asset.animationFile);
+        const Model* model = modelManager->GetModel(modelId);
+        if (model->skeleton == nullptr || model->animationClips.empty())
+        {
+            printf("%-24s missing skeleton or animation, re-run the ModelImporter\n", asset.modelFile);
+            continue;
+        }
+
+        const AnimationClip& clip = model->animationClips[0];
+        const float tickStep = clip.ticksPerSecond / 60.0f;
+        AnimationUtil::BoneTransforms legacyTransforms;
+        AnimationUtil::BoneTransforms modelTransforms;
+        AnimationUtil::BoneTransforms skinningTransforms;
+
+        const double bindLegacyMs = Measure(iterations, [&]()
+        {
+            ComputeLegacy(*model, modelId, 0.0f, false, legacyTransforms);
+        });
+        const double bindFlatMs = Measure(iterations, [&]()
+        {
+            AnimationUtil::ComputeSkinningTransforms(modelId, modelTransforms, skinningTransforms);
+        });
+        const float bindDifference = GetMaxDifference(legacyTransforms, skinningTransforms);
+
+        // Both animated paths advance the same playhead, the flat path samples through the Animator
+        float tick = 0.0f;
+        const double animLegacyMs = Measure(iterations, [&]()
+        {
+            tick = fmodf(tick + tickStep, clip.tickDuration);
+            ComputeLegacy(*model, modelId, tick, true, legacyTransforms);
+        });
+
+        Animator animator;
+        animator.Initialize(modelId);
+        animator.PlayAnimation(0, true);
+        const double animFlatMs = Measure(iterations, [&]()
+        {
+            animator.Update(1.0f / 60.0f);
+            AnimationUtil::ComputeSkinningTransforms(modelId, modelTransforms, skinningTransforms, &animator);
+        });
+
+        const double toUs = 1000.0;
+        printf("%-24s %6zu %16.3f %16.3f %16.3f %16.3f\n", asset.modelFile, model->skeleton->bones.size(),
+            bindLegacyMs * toUs, bindFlatMs * toUs, animLegacyMs * toUs, animFlatMs * toUs);
+        printf("%-24s bind pose max difference %f\n", "", bindDifference);
+    }
+
+    ModelManager::StaticTerminate();
+    return 0;
+}
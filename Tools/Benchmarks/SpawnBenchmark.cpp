@@ -0,0 +1,122 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+using namespace IExeEngine::Core;
+
+namespace
+{
+    enum class BenchmarkComponentId
+    {
+        Zombie = static_cast<int>(ComponentId::Count)
+    };
+
+    class ZombieComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Zombie);
+
+        void Update(float deltaTime) override
+        {
+            health -= deltaTime;
+        }
+
+        float health = 100.0f;
+    };
+
+    struct SpawnResult
+    {
+        double milliseconds = 0.0;
+        uint64_t steadyAllocations = 0;
+        bool passed = true;
+    };
+
+    // Spawns a wave of zombies, destroys them all and lets the world clean up, until cycles objects have come and
+    // gone. The world starts with 10 slots so the first wave grows it
+    SpawnResult RunWaves(ComponentLayout layout, uint32_t cycles, uint32_t waveSize)
+    {
+        GameWorld world;
+        world.SetComponentLayout(layout);
+        world.Initialize(10);
+
+        SpawnResult result;
+        std::vector<GameObject*> wave(waveSize);
+        std::vector<GameObject*> firstWave;
+        GameObjectHandle staleHandle;
+        uint64_t allocationsAfterFirstWave = 0;
+
+        const auto start = Benchmarks::Clock::now();
+        const uint32_t waveCount = cycles / waveSize;
+        for (uint32_t w = 0; w < waveCount; ++w)
+        {
+            for (GameObject*& gameObject : wave)
+            {
+                gameObject = world.CreateGameObject("Zombie");
+                gameObject->AddComponent<TransformComponent>();
+                gameObject->AddComponent<ZombieComponent>();
+                gameObject->Initialize();
+            }
+            world.Update(1.0f / 60.0f);
+
+            // A handle from the last wave points at a slot someone else has now, destroying through it does nothing
+            if (w > 0)
+            {
+                world.DestroyGameObject(staleHandle);
+                world.Update(0.0f);
+            }
+
+            for (GameObject* gameObject : wave)
+            {
+                result.passed &= gameObject->HasA<TransformComponent>() && gameObject->HasA<ZombieComponent>();
+                // Later waves only reuse the objects the first one allocated
+                result.passed &= (w == 0) || std::binary_search(firstWave.begin(), firstWave.end(), gameObject);
+                world.DestroyGameObject(gameObject->GetHandle());
+            }
+            staleHandle = wave.back()->GetHandle();
+            world.Update(0.0f);
+
+            if (w == 0)
+            {
+                firstWave = wave;
+                std::sort(firstWave.begin(), firstWave.end());
+                allocationsAfterFirstWave = MemoryTracker::GetThreadAllocationCount();
+            }
+        }
+        result.milliseconds = Benchmarks::ToMilliseconds(Benchmarks::Clock::now() - start);
+        result.steadyAllocations = MemoryTracker::GetThreadAllocationCount() - allocationsAfterFirstWave;
+
+        world.Terminate();
+        return result;
+    }
+}
+
+// Args: [cycles] [wave size]
+int Benchmarks::RunSpawn(int argc, char* argv[])
+{
+    const uint32_t cycles = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 100000;
+    const uint32_t waveSize = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 1000;
+    const bool tracking = MemoryTracker::IsEnabled();
+
+    printf("%u spawn/destroy cycles in waves of %u, 2 components each\n", cycles, waveSize);
+    printf("%-12s %12s %16s %24s\n", "Layout", "Total (ms)", "Per cycle (ns)", "Heap allocs after wave 1");
+
+    bool passed = true;
+    for (const ComponentLayout layout : { ComponentLayout::PerObject, ComponentLayout::Pooled })
+    {
+        const SpawnResult result = RunWaves(layout, cycles, waveSize);
+        const bool pooled = layout == ComponentLayout::Pooled;
+        passed &= result.passed;
+        // Pooled components, recycled objects and their vectors leave nothing for the heap once the first wave is in
+        if (tracking && pooled)
+        {
+            passed &= result.steadyAllocations == 0;
+        }
+
+        const uint32_t done = (cycles / waveSize) * waveSize;
+        printf("%-12s %12.3f %16.1f %24s\n", pooled ? "Pooled" : "Per object", result.milliseconds,
+            (done > 0) ? result.milliseconds * 1.0e6 / done : 0.0,
+            tracking ? std::to_string(result.steadyAllocations).c_str() : "n/a");
+    }
+
+    printf("Checks %s\n", passed ? "ok" : "FAILED");
+    return passed ? 0 : -1;
+}
\ No newline at end of file
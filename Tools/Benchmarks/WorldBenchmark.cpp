@@ -0,0 +1,222 @@
+#include "Benchmarks.h"
+
+using namespace IExeEngine;
+
+namespace
+{
+    using Benchmarks::Measure;
+
+    enum class BenchmarkComponentId
+    {
+        Mover = static_cast<int>(ComponentId::Count),
+        Pulse
+    };
+
+    uint32_t sMoverUpdates = 0;
+
+    class MoverComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Mover);
+
+        void Update(float deltaTime) override
+        {
+            velocity += acceleration * deltaTime;
+            position += velocity * deltaTime;
+            ++sMoverUpdates;
+        }
+
+        Math::Vector3 position = Math::Vector3::Zero;
+        Math::Vector3 velocity = Math::Vector3::One;
+        Math::Vector3 acceleration = Math::Vector3::YAxis;
+    };
+
+    class PulseComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Pulse);
+
+        void Update(float deltaTime) override
+        {
+            phase += frequency * deltaTime;
+            if (phase > 1.0f)
+            {
+                phase -= 1.0f;
+            }
+        }
+
+        float phase = 0.0f;
+        float frequency = 2.0f;
+    };
+
+    class World
+    {
+    public:
+        void Initialize(uint32_t objectCount, ComponentLayout layout)
+        {
+            mWorld.SetComponentLayout(layout);
+            mWorld.Initialize(objectCount);
+            for (uint32_t i = 0; i < objectCount; ++i)
+            {
+                GameObject* gameObject = mWorld.CreateGameObject("Object" + std::to_string(i));
+                gameObject->AddComponent<TransformComponent>();
+                MoverComponent* mover = gameObject->AddComponent<MoverComponent>();
+                gameObject->AddComponent<PulseComponent>();
+                gameObject->Initialize();
+                mover->velocity.x = static_cast<float>(i);
+                mGameObjects.push_back(gameObject);
+            }
+        }
+
+        void Terminate()
+        {
+            mWorld.Terminate();
+            mGameObjects.clear();
+        }
+
+        // Destroys every other object and makes new ones in their slots, so blocks get reused out of order
+        void Churn()
+        {
+            for (uint32_t i = 0; i < mGameObjects.size(); i += 2)
+            {
+                mWorld.DestroyGameObject(mGameObjects[i]->GetHandle());
+            }
+            mWorld.Update(0.0f);
+            for (uint32_t i = 0; i < mGameObjects.size(); i += 2)
+            {
+                GameObject* gameObject = mWorld.CreateGameObject("Churned" + std::to_string(i));
+                gameObject->AddComponent<TransformComponent>();
+                gameObject->AddComponent<MoverComponent>()->velocity.x = static_cast<float>(i);
+                gameObject->AddComponent<PulseComponent>();
+                gameObject->Initialize();
+                mGameObjects[i] = gameObject;
+            }
+        }
+
+        void Update(float deltaTime)
+        {
+            mWorld.Update(deltaTime);
+        }
+
+        const std::vector<GameObject*>& GetGameObjects() const
+        {
+            return mGameObjects;
+        }
+
+    private:
+        GameWorld mWorld;
+        std::vector<GameObject*> mGameObjects;
+    };
+
+    // Lookups still reach the object's own components, and each update reaches every live component once
+    bool Check(World& world)
+    {
+        bool passed = true;
+        for (GameObject* gameObject : world.GetGameObjects())
+        {
+            const MoverComponent* mover = gameObject->GetComponent<MoverComponent>();
+            passed &= mover != nullptr && &mover->GetOwner() == gameObject && gameObject->HasA<PulseComponent>();
+            passed &= gameObject->GetComponent<TransformComponent>() != nullptr && gameObject->GetComponent<CameraComponent>() == nullptr;
+        }
+
+        sMoverUpdates = 0;
+        world.Update(0.0f);
+        return passed && sMoverUpdates == world.GetGameObjects().size();
+    }
+
+    // The linear scan GetComponent did before the lookup table, over the same components in the same order
+    template<class ComponentType>
+    const ComponentType* LegacyGetComponent(const std::vector<Component*>& components)
+    {
+        for (const Component* component : components)
+        {
+            if (component->GetTypeId() == ComponentType::StaticGetTypeId())
+            {
+                return static_cast<const ComponentType*>(component);
+            }
+        }
+        return nullptr;
+    }
+
+    float GetMaxDifference(const World& a, const World& b)
+    {
+        float difference = 0.0f;
+        for (size_t i = 0; i < a.GetGameObjects().size(); ++i)
+        {
+            const Math::Vector3& positionA = a.GetGameObjects()[i]->GetComponent<MoverComponent>()->position;
+            const Math::Vector3& positionB = b.GetGameObjects()[i]->GetComponent<MoverComponent>()->position;
+            difference = Math::Max(difference, Math::Magnitude(positionA - positionB));
+        }
+        return difference;
+    }
+}
+
+// Args: [objects] [frames]
+int Benchmarks::RunWorld(int argc, char* argv[])
+{
+    const uint32_t objectCount = (argc > 0) ? static_cast<uint32_t>(atoi(argv[0])) : 10000;
+    const uint32_t frames = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 300;
+    const float deltaTime = 1.0f / 60.0f;
+
+    World perObjectWorld;
+    World pooledWorld;
+    perObjectWorld.Initialize(objectCount, ComponentLayout::PerObject);
+    pooledWorld.Initialize(objectCount, ComponentLayout::Pooled);
+
+    bool passed = Check(perObjectWorld) && Check(pooledWorld);
+
+    printf("%u objects, 3 components each, %u frames\n", objectCount, frames);
+    printf("%-24s %16s %16s %10s\n", "", "Per object (ms)", "Pooled (ms)", "Speedup");
+
+    // Looks up the last added component and one the objects don't have, the worst cases for a scan
+    std::vector<std::vector<Component*>> objectComponents;
+    for (GameObject* gameObject : pooledWorld.GetGameObjects())
+    {
+        objectComponents.push_back({ gameObject->GetComponent<TransformComponent>(), gameObject->GetComponent<MoverComponent>(),
+            gameObject->GetComponent<PulseComponent>() });
+    }
+    uint32_t found = 0;
+    const double legacyLookupMs = Measure(frames, [&]()
+    {
+        for (const std::vector<Component*>& components : objectComponents)
+        {
+            found += (LegacyGetComponent<PulseComponent>(components) != nullptr) ? 1 : 0;
+            found += (LegacyGetComponent<CameraComponent>(components) != nullptr) ? 1 : 0;
+        }
+    });
+    const double lookupMs = Measure(frames, [&]()
+    {
+        for (GameObject* gameObject : pooledWorld.GetGameObjects())
+        {
+            found += (gameObject->GetComponent<PulseComponent>() != nullptr) ? 1 : 0;
+            found += (gameObject->GetComponent<CameraComponent>() != nullptr) ? 1 : 0;
+        }
+    });
+    passed &= found == 2 * frames * objectCount;
+    const double lookupCount = 2.0 * objectCount;
+    printf("%-24s %13.2f ns %13.2f ns %9.1fx\n", "GetComponent (scan/table)", legacyLookupMs * 1.0e6 / lookupCount,
+        lookupMs * 1.0e6 / lookupCount, (lookupMs > 0.0) ? legacyLookupMs / lookupMs : 0.0);
+
+    const double perObjectMs = Measure(frames, [&]() { perObjectWorld.Update(deltaTime); });
+    const double pooledMs = Measure(frames, [&]() { pooledWorld.Update(deltaTime); });
+    printf("%-24s %16.3f %16.3f %9.1fx\n", "GameWorld::Update", perObjectMs, pooledMs,
+        (pooledMs > 0.0) ? perObjectMs / pooledMs : 0.0);
+
+    perObjectWorld.Churn();
+    pooledWorld.Churn();
+    passed &= Check(perObjectWorld) && Check(pooledWorld);
+
+    const double perObjectChurnedMs = Measure(frames, [&]() { perObjectWorld.Update(deltaTime); });
+    const double pooledChurnedMs = Measure(frames, [&]() { pooledWorld.Update(deltaTime); });
+    printf("%-24s %16.3f %16.3f %9.1fx\n", "After churn", perObjectChurnedMs, pooledChurnedMs,
+        (pooledChurnedMs > 0.0) ? perObjectChurnedMs / pooledChurnedMs : 0.0);
+
+    // Same components updated the same number of times, only the order differs
+    const float difference = GetMaxDifference(perObjectWorld, pooledWorld);
+    passed &= difference == 0.0f;
+    printf("Checks %s, max difference %f\n", passed ? "ok" : "FAILED", difference);
+
+    pooledWorld.Terminate();
+    perObjectWorld.Terminate();
+    return passed ? 0 : -1;
+}
\ No newline at end of file
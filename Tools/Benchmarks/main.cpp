@@ -0,0 +1,75 @@
+#include "Benchmarks.h"
+
+using namespace Benchmarks;
+
+namespace
+{
+    struct Suite
+    {
+        const char* name;
+        const char* description;
+        int (*run)(int argc, char* argv[]);
+    };
+
+    const Suite sSuites[] =
+    {
+        { "modelio", "Text vs binary model/skeleton/animset load times", RunModelIO },
+        { "animsample", "Linear vs binary-search vs cursor keyframe sampling on the Guard_01/Knight clips", RunAnimationSampling },
+        { "skeleton", "Recursive vs flat sorted pose propagation on the zombie and parasite skeletons", RunSkeleton },
+        { "crowd", "Serial vs JobSystem AnimationService updates for 1 to 1000 zombies", RunAnimationCrowd },
+        { "animblend", "Animator update cost with 1, 2 and 4 blended layers on the parasite", RunAnimationBlend },
+        { "math", "SIMD vs scalar Math kernels, bit accuracy check and per element timings", RunMath },
+        { "allocator", "ConcurrentBlockAllocator stress test and throughput vs malloc and a locked BlockAllocator", RunAllocator },
+        { "jobs", "JobSystem correctness checks, scheduling overhead per job and scaling from 1 to N threads", RunJobSystem },
+        { "frame", "FrameAllocator checks and per frame bone palettes from the heap vs frame memory", RunFrameAllocator },
+        { "profiler", "Profiler scope cost, nesting/job/wrap checks and a headless Chrome trace export", RunProfiler },
+        { "logger", "Async Logger ordering/truncation checks and per message cost vs formatting on the caller", RunLogger },
+        { "events", "EventManager dispatch checks and broadcasts/sec with 1, 10 and 100 listeners, legacy vs immediate vs queued", RunEvents },
+        { "memory", "MemoryTracker tag/frame/callstack checks and tracked new/delete cost vs malloc, prints the report", RunMemory },
+        { "world", "GetComponent scan vs table, GameWorld update of 10k objects with per object vs pooled component storage, before and after churn", RunWorld },
+        { "hierarchy", "Cached world transforms on deep and wide hierarchies, per query parent walks vs the GameWorld pass", RunHierarchy },
+        { "spawn", "100k GameObject spawn/destroy cycles with growing slots and recycled objects, time and heap allocations", RunSpawn },
+        { "prefab", "Spawning 200 templated zombies with a child, parsing every instance vs the GameObjectFactory prefab cache, reload on save", RunPrefab },
+        { "registry", "TypeRegistry contents and metadata checks, component name lookup by string compare chain vs name hash", RunRegistry },
+        { "level", "Loading a 500 object level from json, with templates parsed or cached, vs the cooked binary level", RunLevel },
+    };
+
+    void PrintUsage()
+    {
+        printf("Usage: Benchmarks <suite|all> [suite args]\n");
+        for (const Suite& suite : sSuites)
+        {
+            printf("  %-12s %s\n", suite.name, suite.description);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return -1;
+    }
+
+    const bool runAll = strcmp(argv[1], "all") == 0;
+    bool found = false;
+    int result = 0;
+    for (const Suite& suite : sSuites)
+    {
+        if (runAll || strcmp(argv[1], suite.name) == 0)
+        {
+            printf("==== %s ====\n", suite.name);
+            result |= suite.run(argc - 2, argv + 2);
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        printf("Unknown suite: %s\n", argv[1]);
+        PrintUsage();
+        return -1;
+    }
+    return result;
+}
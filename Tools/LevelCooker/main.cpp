@@ -0,0 +1,35 @@
+#include <IExeEngine/Inc/IExeEngine.h>
+
+#include <cstdio>
+
+using namespace IExeEngine;
+
+// Flattens a json level and every template it uses into one cooked level for GameWorld::LoadLevel. Only names are
+// stored, so custom component and service types don't need to be known here. Template paths in the level are
+// relative to the working directory, run it from the same depth as the game
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: LevelCooker <level file> [<cooked file>]\n");
+        return -1;
+    }
+
+    const std::filesystem::path levelFile = argv[1];
+    std::filesystem::path cookedFile = levelFile;
+    cookedFile.replace_extension(CookedLevel::Extension);
+    if (argc > 2)
+    {
+        cookedFile = argv[2];
+    }
+
+    printf("Cooking %s...\n", levelFile.u8string().c_str());
+    if (!CookedLevel::Cook(levelFile, cookedFile))
+    {
+        printf("Failed to cook %s, see the log for the file that caused it\n", levelFile.u8string().c_str());
+        return -1;
+    }
+
+    printf("Wrote %s\n", cookedFile.u8string().c_str());
+    return 0;
+}
\ No newline at end of file
@@ -18,13 +18,19 @@ struct Arguments
     std::filesystem::path outputFileName;
     float scale = 1.0f;                  // 1 Unit = 1 Millimeter
     bool animOnly = false;              // Export only animation data
+    bool writeText = true;              // Write the text .model/.skeleton/.animset files
+    bool writeBinary = true;            // Write the binary .bmodel/.bskeleton/.banimset files
+    bool compress = true;               // Reduce and quantize animation keys
+    float maxPositionError = 0.0005f;   // Key reduction tolerance for translations, in output units
+    float maxRotationError = 0.1f;      // Key reduction tolerance for rotations, in degrees
+    float maxScaleError = 0.0005f;      // Key reduction tolerance for scales
 };
 
 std::optional<Arguments> ParseArgs(int argc, char* argv[])
 {
     if (argc < 3)
     {
-        printf("Usage: ModelImporter <input file> <output file> [scale]\n");
+        printf("Usage: ModelImporter [-scale s] [-animOnly 0|1] [-format text|binary|both] [-compress 0|1] [-positionError e] [-rotationError degrees] [-scaleError e] <input file> <output file>\n");
         return std::nullopt;
     }
 
@@ -46,6 +52,33 @@ std::optional<Arguments> ParseArgs(int argc, char* argv[])
             args.animOnly = atoi(argv[i + 1]) == 1;
             ++i;
         }
+        // -format text | binary | both (default)
+        else if (strcmp(argv[i], "-format") == 0)
+        {
+            args.writeText = strcmp(argv[i + 1], "binary") != 0;
+            args.writeBinary = strcmp(argv[i + 1], "text") != 0;
+            ++i;
+        }
+        else if (strcmp(argv[i], "-compress") == 0)
+        {
+            args.compress = atoi(argv[i + 1]) == 1;
+            ++i;
+        }
+        else if (strcmp(argv[i], "-positionError") == 0)
+        {
+            args.maxPositionError = atof(argv[i + 1]);
+            ++i;
+        }
+        else if (strcmp(argv[i], "-rotationError") == 0)
+        {
+            args.maxRotationError = atof(argv[i + 1]);
+            ++i;
+        }
+        else if (strcmp(argv[i], "-scaleError") == 0)
+        {
+            args.maxScaleError = atof(argv[i + 1]);
+            ++i;
+        }
     }
     return args;
 }
@@ -102,6 +135,121 @@ Matrix4 ToMatrix4(const aiMatrix4x4& m)
     };
 }
 
+float GetRotationError(const Quaternion& a, const Quaternion& b)
+{
+    // Angle between the two rotations in degrees
+    const float dot = Min(fabsf(a.Dot(b)), 1.0f);
+    return 2.0f * acosf(dot) * Constants::RadToDeg;
+}
+
+Quaternion SlerpKeys(const Quaternion& a, const Quaternion& b, float t)
+{
+    return Quaternion::Slerp(a, b, t);
+}
+
+Vector3 LerpKeys(const Vector3& a, const Vector3& b, float t)
+{
+    return Lerp(a, b, t);
+}
+
+// Drops every key that interpolating between the surrounding kept keys reproduces within maxError
+template<class T, class Interpolate, class Error>
+Keyframes<T> ReduceKeys(const Keyframes<T>& keys, float maxError, Interpolate interpolate, Error getError)
+{
+    if (keys.size() <= 1)
+    {
+        return keys;
+    }
+
+    Keyframes<T> reduced;
+    reduced.push_back(keys.front());
+    size_t anchor = 0;
+    for (size_t i = 1; i + 1 < keys.size(); ++i)
+    {
+        // Try to skip key i by interpolating from the last kept key straight to the next one
+        const Keyframe<T>& start = keys[anchor];
+        const Keyframe<T>& end = keys[i + 1];
+        const float span = end.time - start.time;
+        bool canSkip = span > 0.0f;
+        for (size_t j = anchor + 1; j <= i && canSkip; ++j)
+        {
+            const T value = interpolate(start.key, end.key, (keys[j].time - start.time) / span);
+            canSkip = getError(value, keys[j].key) <= maxError;
+        }
+        if (!canSkip)
+        {
+            reduced.push_back(keys[i]);
+            anchor = i;
+        }
+    }
+    reduced.push_back(keys.back());
+
+    // A track that never moves only needs a single key
+    if (reduced.size() == 2 && getError(reduced.front().key, reduced.back().key) <= maxError * 0.5f)
+    {
+        reduced.pop_back();
+    }
+    return reduced;
+}
+
+struct CompressionStats
+{
+    size_t sourceBytes = 0;
+    size_t compressedBytes = 0;
+    float maxPositionError = 0.0f;
+    float maxRotationError = 0.0f;
+    float maxScaleError = 0.0f;
+};
+
+// Compares the compressed bone animation with the source at every source key
+void MeasureError(const Animation& source, const Animation& compressed, CompressionStats& stats)
+{
+    auto measure = [&](float time)
+    {
+        const Transform expected = source.GetTransform(time);
+        const Transform actual = compressed.GetTransform(time);
+        stats.maxPositionError = Max(stats.maxPositionError, Distance(expected.position, actual.position));
+        stats.maxRotationError = Max(stats.maxRotationError, GetRotationError(expected.rotation, actual.rotation));
+        stats.maxScaleError = Max(stats.maxScaleError, Distance(expected.scale, actual.scale));
+    };
+    for (const auto& key : source.GetPositionKeys())
+    {
+        measure(key.time);
+    }
+    for (const auto& key : source.GetRotationKeys())
+    {
+        measure(key.time);
+    }
+    for (const auto& key : source.GetScaleKeys())
+    {
+        measure(key.time);
+    }
+    stats.sourceBytes += source.GetKeyDataSize();
+    stats.compressedBytes += compressed.GetKeyDataSize();
+}
+
+Animation CompressAnimation(const Animation& source, const Arguments& args, CompressionStats& stats)
+{
+    AnimationBuilder builder;
+    for (const auto& key : ReduceKeys(source.GetPositionKeys(), args.maxPositionError, LerpKeys, Distance))
+    {
+        builder.AddPositionKey(key.key, key.time);
+    }
+    for (const auto& key : ReduceKeys(source.GetRotationKeys(), args.maxRotationError, SlerpKeys, GetRotationError))
+    {
+        builder.AddRotationKey(key.key, key.time);
+    }
+    for (const auto& key : ReduceKeys(source.GetScaleKeys(), args.maxScaleError, LerpKeys, Distance))
+    {
+        builder.AddScaleKey(key.key, key.time);
+    }
+
+    Animation compressed = builder.Build();
+    compressed.Quantize();
+    MeasureError(source, compressed, stats);
+    return compressed;
+}
+
 void ExportEmbeddedTexture(const aiTexture* texture, const Arguments& args,
     const std::filesystem::path& fileName)
 {
@@ -472,6 +620,7 @@ int main(int argc, char* argv[])
             printf("Reading Bone Animations for %s...\n", animClip.name.c_str());
 
             animClip.boneAnimations.resize(model.skeleton->bones.size());
+            CompressionStats stats;
             for (uint32_t boneAnimIndex = 0; boneAnimIndex < aiAnim->mNumChannels; ++boneAnimIndex)
             {
                 const auto& aiBoneAnim = aiAnim->mChannels[boneAnimIndex];
@@ -496,6 +645,18 @@ int main(int argc, char* argv[])
                     builder.AddScaleKey(ToVector3(scale.mValue), static_cast<float>(scale.mTime));
                 }
                 *boneAnimation = builder.Build();
+                if (args.compress)
+                {
+                    *boneAnimation = CompressAnimation(*boneAnimation, args, stats);
+                }
+            }
+
+            if (args.compress && stats.sourceBytes > 0)
+            {
+                printf("Compressed %s: %.1f KB -> %.1f KB (%.2f:1), max error position %f rotation %f deg scale %f\n",
+                    animClip.name.c_str(), stats.sourceBytes / 1024.0f, stats.compressedBytes / 1024.0f,
+                    static_cast<float>(stats.sourceBytes) / Max(stats.compressedBytes, static_cast<size_t>(1)),
+                    stats.maxPositionError, stats.maxRotationError, stats.maxScaleError);
             }
         }
     }
@@ -503,17 +664,38 @@ int main(int argc, char* argv[])
     if (!args.animOnly)
     {
         printf("Saving Model...\n");
-        ModelIO::SaveModel(args.outputFileName, model);
+        if (args.writeText)
+        {
+            ModelIO::SaveModel(args.outputFileName, model);
+        }
+        if (args.writeBinary)
+        {
+            ModelIO::SaveModelBinary(args.outputFileName, model);
+        }
 
         printf("Saving Material...\n");
         ModelIO::SaveMaterial(args.outputFileName, model);
 
         printf("Saving Skeleton...\n");
-        ModelIO::SaveSkeleton(args.outputFileName, model);
+        if (args.writeText)
+        {
+            ModelIO::SaveSkeleton(args.outputFileName, model);
+        }
+        if (args.writeBinary)
+        {
+            ModelIO::SaveSkeletonBinary(args.outputFileName, model);
+        }
     }
 
     printf("Saving Animation...\n");
-    ModelIO::SaveAnimation(args.outputFileName, model);
+    if (args.writeText)
+    {
+        ModelIO::SaveAnimation(args.outputFileName, model);
+    }
+    if (args.writeBinary)
+    {
+        ModelIO::SaveAnimationBinary(args.outputFileName, model);
+    }
 
     printf("Import Complete!\n");
 
@@ -309,7 +309,7 @@ void GameState::UpdateCamera(float deltaTime)
     if (input->IsKeyPressed(KeyCode::ENTER))
     {
         PressEnterEvent event;
-        EventManager::Broadcast(event);
+        EventManager::Post(event);
     }
 }
 
@@ -26,4 +26,6 @@ private:
     uint32_t mSlices = 0;
     uint32_t mRings = 0;
     float mRadius = 0;
-};
\ No newline at end of file
+};
+
+REGISTER_COMPONENT(CustomDebugDrawComponent);
\ No newline at end of file
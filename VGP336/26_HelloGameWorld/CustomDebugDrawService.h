@@ -19,4 +19,6 @@ public:
 private:
 	using CustomDebugDrawComponents = std::vector<const CustomDebugDrawComponent*>;
 	CustomDebugDrawComponents mCustomDebugDrawComponents;
-};
\ No newline at end of file
+};
+
+REGISTER_SERVICE(CustomDebugDrawService);
\ No newline at end of file
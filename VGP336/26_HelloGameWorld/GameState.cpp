@@ -7,51 +7,12 @@ using namespace IExeEngine::Graphics;
 using namespace IExeEngine::Input;
 using namespace IExeEngine::Physics;
 
-// "Hey IExeEngine, I made something custom, so you need to acknowledge it..."
-Service* MakeCustomService(const std::string& serviceName, GameWorld& gameWorld)
-{
-	if (serviceName == "CustomDebugDrawService")
-	{
-		return gameWorld.AddService<CustomDebugDrawService>();
-	}
-	// Add another service
-	// Add next...
-	return nullptr;
-}
-
-Component* MakeCustomComponent(const std::string& componentName, GameObject& gameObject)
-{
-	if (componentName == "CustomDebugDrawComponent")
-	{
-		return gameObject.AddComponent<CustomDebugDrawComponent>();
-	}
-	return nullptr;
-}
-// Pass the input to the engine -> Engine tries to find it in the engine
-// If it cant find it -> Go back to the gameState -> Try to find it...
-// Ooh found it! -> Gets added.
-
-Component* GetCustomComponent(const std::string& componentName, GameObject& gameObject)
-{
-	if (componentName == "CustomDebugDrawComponent")
-	{
-		return gameObject.GetComponent<CustomDebugDrawComponent>();
-	}
-	return nullptr;
-} 
-
-
 void GameState::Initialize()
 {
 	mLevelFile = L"../../Assets/Templates/Levels/zombiesVsPlants.json";
 
-	// Set a callback to try make a custom service
-	// (any service that is NOT part of the engine and unique to the project)
-	GameWorld::SetCustomService(MakeCustomService);
-	// Sets callbacks to try make/ get a custom component (any component that is NOT part of the engine)
-	GameObjectFactory::SetCustomMake(MakeCustomComponent);
-	GameObjectFactory::SetCustomGet(GetCustomComponent);
-
+	// CustomDebugDrawService and CustomDebugDrawComponent register themselves from their headers, so the level
+	// can name them like any engine type
 	mGameWorld.LoadLevel(mLevelFile);
 }
 
@@ -6,6 +6,7 @@ int WINAPI WinMain(HINSTANCE instance, HINSTANCE, LPSTR, int)
 {
 	AppConfig config;
 	config.appName = L"Hello GameWorld";
+	config.simulationRate = 60.0f;
 
 	App& myApp = MainApp();
 